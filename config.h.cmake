@@ -132,6 +132,7 @@
 #cmakedefine HAVE_BFILL 1
 #cmakedefine HAVE_INDEX 1
 #cmakedefine HAVE_CLOCK_GETTIME 1
+#cmakedefine HAVE_COPY_FILE_RANGE 1
 #cmakedefine HAVE_CRYPT 1
 #cmakedefine HAVE_CUSERID 1
 #cmakedefine HAVE_DLADDR 1
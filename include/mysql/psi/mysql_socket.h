@@ -38,6 +38,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
   #define SOCKBUF_T char
 #else
   #include <netinet/in.h>
+  #include <sys/socket.h>
+  #include <sys/uio.h>
   #define SOCKBUF_T void
 #endif
 /**
@@ -419,6 +421,24 @@ inline_mysql_socket_set_state(MYSQL_SOCKET socket, enum PSI_socket_state state)
     inline_mysql_socket_send(FD, B, N, FL)
 #endif
 
+#ifndef _WIN32
+/**
+  @def mysql_socket_sendmsg(FD, M, FL)
+  Send data from the buffers of a message to a connected socket.
+  @c mysql_socket_sendmsg is a replacement for @c sendmsg.
+  @param FD Instrumented socket descriptor returned by socket() or accept()
+  @param M  Message with the buffers to send
+  @param FL Control flags
+*/
+#ifdef HAVE_PSI_SOCKET_INTERFACE
+  #define mysql_socket_sendmsg(FD, M, FL) \
+    inline_mysql_socket_sendmsg(__FILE__, __LINE__, FD, M, FL)
+#else
+  #define mysql_socket_sendmsg(FD, M, FL) \
+    inline_mysql_socket_sendmsg(FD, M, FL)
+#endif
+#endif /* !_WIN32 */
+
 /**
   @def mysql_socket_recv(FD, B, N, FL)
   Receive data from a connected socket.
@@ -851,6 +871,52 @@ inline_mysql_socket_send
   return result;
 }
 
+#ifndef _WIN32
+/** mysql_socket_sendmsg */
+
+static inline ssize_t
+inline_mysql_socket_sendmsg
+(
+#ifdef HAVE_PSI_SOCKET_INTERFACE
+  const char *src_file, uint src_line,
+#endif
+ MYSQL_SOCKET mysql_socket, const struct msghdr *msg, int flags)
+{
+  ssize_t result;
+  DBUG_ASSERT(mysql_socket.fd != INVALID_SOCKET);
+#ifdef HAVE_PSI_SOCKET_INTERFACE
+  if (psi_likely(mysql_socket.m_psi != NULL))
+  {
+    /* Instrumentation start */
+    PSI_socket_locker *locker;
+    PSI_socket_locker_state state;
+    size_t n= 0, i;
+    for (i= 0; i < (size_t) msg->msg_iovlen; i++)
+      n+= msg->msg_iov[i].iov_len;
+    locker= PSI_SOCKET_CALL(start_socket_wait)
+      (&state, mysql_socket.m_psi, PSI_SOCKET_SEND, n, src_file, src_line);
+
+    /* Instrumented code */
+    result= sendmsg(mysql_socket.fd, msg, flags);
+
+    /* Instrumentation end */
+    if (locker != NULL)
+    {
+      size_t bytes_written= (result > 0) ? (size_t) result : 0;
+      PSI_SOCKET_CALL(end_socket_wait)(locker, bytes_written);
+    }
+
+    return result;
+  }
+#endif
+
+  /* Non instrumented code */
+  result= sendmsg(mysql_socket.fd, msg, flags);
+
+  return result;
+}
+#endif /* !_WIN32 */
+
 /** mysql_socket_recv */
 
 static inline ssize_t
@@ -35,6 +35,8 @@ extern "C" {
 typedef struct st_vio Vio;
 #endif /* __cplusplus */
 
+struct iovec;
+
 enum enum_vio_type
 {
   VIO_CLOSED, VIO_TYPE_TCPIP, VIO_TYPE_SOCKET, VIO_TYPE_NAMEDPIPE,
@@ -94,6 +96,10 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
 size_t	vio_read(Vio *vio, uchar *	buf, size_t size);
 size_t  vio_read_buff(Vio *vio, uchar * buf, size_t size);
 size_t	vio_write(Vio *vio, const uchar * buf, size_t size);
+#ifndef _WIN32
+/* Write the buffers of an I/O vector with one system call */
+size_t	vio_writev(Vio *vio, const struct iovec *iov, int iovcnt);
+#endif
 int	vio_blocking(Vio *vio, my_bool onoff, my_bool *old_mode);
 my_bool	vio_is_blocking(Vio *vio);
 /* setsockopt TCP_NODELAY at IPPROTO_TCP level, when possible */
@@ -208,6 +214,7 @@ const char *vio_type_name(enum enum_vio_type vio_type, size_t *len);
 #define vio_errno(vio)	 			(vio)->vioerrno(vio)
 #define vio_read(vio, buf, size)                ((vio)->read)(vio,buf,size)
 #define vio_write(vio, buf, size)               ((vio)->write)(vio, buf, size)
+#define vio_writev(vio, iov, iovcnt)            ((vio)->writev)(vio, iov, iovcnt)
 #define vio_blocking(vio, set_blocking_mode, old_mode)\
  	(vio)->vioblocking(vio, set_blocking_mode, old_mode)
 #define vio_is_blocking(vio) 			(vio)->is_blocking(vio)
@@ -264,6 +271,8 @@ struct st_vio
   int     (*vioerrno)(Vio*);
   size_t  (*read)(Vio*, uchar *, size_t);
   size_t  (*write)(Vio*, const uchar *, size_t);
+  /* NULL if the type of connection does not support vio_writev() */
+  size_t  (*writev)(Vio*, const struct iovec *, int);
   int     (*timeout)(Vio*, uint, my_bool);
   int     (*vioblocking)(Vio*, my_bool, my_bool *);
   my_bool (*is_blocking)(Vio*);
@@ -22,6 +22,7 @@
 #include <m_string.h>
 #include <stdarg.h>
 #include <m_ctype.h>
+#include "mysys_err.h"
 
 /**
   Copy the cache to the file. Copying can be constrained to @c count
@@ -99,6 +100,98 @@ my_b_copy_to_cache(IO_CACHE *from_cache, IO_CACHE *to_cache,
   DBUG_RETURN(0);
 }
 
+/**
+  Similar to my_b_copy_to_cache(), but the part of from_cache that is not
+  in its buffer is copied from its file to the file of to_cache by the
+  kernel, with copy_file_range(), instead of being read into the buffer
+  of from_cache and copied to the buffer of to_cache. Depending on the
+  file system, the data blocks may even be shared instead of copied.
+
+  Falls back to my_b_copy_to_cache() if either cache is encrypted or
+  shared, or if the kernel can not copy between the files.
+
+  @param from_cache  READ_CACHE to copy from
+  @param to_cache    WRITE_CACHE to copy to
+  @param count       the number of bytes to copy
+  @return
+         0          All OK
+         1          An error occurred
+*/
+int
+my_b_copy_file_to_cache(IO_CACHE *from_cache, IO_CACHE *to_cache,
+                        size_t count)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+  size_t curr_write;
+  loff_t off_in, off_out;
+  DBUG_ENTER("my_b_copy_file_to_cache");
+
+  if (from_cache->type != READ_CACHE || from_cache->file < 0 ||
+      (from_cache->myflags & MY_ENCRYPT) || to_cache->type != WRITE_CACHE ||
+      to_cache->file < 0 || to_cache->share ||
+      (to_cache->myflags & (MY_ENCRYPT | MY_TRACK | MY_TRACK_WITH_LIMIT)))
+    DBUG_RETURN(my_b_copy_to_cache(from_cache, to_cache, count));
+
+  /* First the part that is already in the buffer */
+  curr_write= MY_MIN(my_b_bytes_in_cache(from_cache), count);
+  if (curr_write)
+  {
+    if (my_b_write(to_cache, from_cache->read_pos, curr_write))
+      DBUG_RETURN(1);
+    from_cache->read_pos+= curr_write;
+    count-= curr_write;
+  }
+  if (!count)
+    DBUG_RETURN(0);
+
+  if (my_b_flush_io_cache(to_cache, 1))
+    DBUG_RETURN(1);
+  off_in= (loff_t) my_b_tell(from_cache);
+  off_out= (loff_t) to_cache->pos_in_file;
+  while (count)
+  {
+    ssize_t copied= copy_file_range(from_cache->file, &off_in,
+                                    to_cache->file, &off_out, count, 0);
+    if (copied > 0)
+    {
+      count-= (size_t) copied;
+      continue;
+    }
+    if (copied < 0 && errno == EINTR)
+      continue;
+    if (copied < 0 && errno != EXDEV && errno != EINVAL &&
+        errno != ENOSYS && errno != EOPNOTSUPP)
+    {
+      my_errno= errno;
+      if (to_cache->myflags & MY_WME)
+        my_error(EE_WRITE, MYF(ME_BELL), my_filename(to_cache->file),
+                 my_errno);
+      to_cache->error= -1;
+      DBUG_RETURN(1);
+    }
+    /* Not supported for these files; copy the rest through the buffers */
+    break;
+  }
+
+  /*
+    copy_file_range() did not move the file offsets; the next access of
+    either cache must seek.
+  */
+  to_cache->pos_in_file= (my_off_t) off_out;
+  set_if_bigger(to_cache->end_of_file, to_cache->pos_in_file);
+  to_cache->write_end= (to_cache->write_buffer + to_cache->buffer_length -
+                        (to_cache->pos_in_file & (IO_SIZE - 1)));
+  to_cache->seek_not_done= 1;
+  from_cache->pos_in_file= (my_off_t) off_in;
+  from_cache->read_pos= from_cache->read_end= from_cache->request_pos;
+  from_cache->seek_not_done= 1;
+
+  DBUG_RETURN(count ? my_b_copy_to_cache(from_cache, to_cache, count) : 0);
+#else
+  return my_b_copy_to_cache(from_cache, to_cache, count);
+#endif
+}
+
 int my_b_copy_all_to_cache(IO_CACHE *from_cache, IO_CACHE *to_cache)
 {
   DBUG_ENTER("my_b_copy_all_to_cache");
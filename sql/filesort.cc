@@ -35,8 +35,10 @@
 #include "sql_select.h"
 #include "debug_sync.h"
 #include "sql_queue.h"
+#include "item_batch.h"
 
-static uint make_sortkey(Sort_param *, uchar *, uchar *, bool);
+static uint make_sortkey(Sort_param *, uchar *, uchar *, bool,
+                         const Item_batch *batch= NULL, uint batch_row= 0);
 
 class Bounded_queue
 {
@@ -94,7 +96,8 @@ static ha_rows find_all_keys(THD *, Sort_param *, SQL_SELECT *, SORT_INFO *,
                              IO_CACHE *, IO_CACHE *, Bounded_queue *,
                              ha_rows *);
 static bool write_keys(Sort_param *, SORT_INFO *, uint, IO_CACHE *, IO_CACHE *);
-static uint make_sortkey(Sort_param *param, uchar *to);
+static uint make_sortkey(Sort_param *param, uchar *to,
+                         const Item_batch *batch, uint batch_row);
 static uint make_packed_sortkey(Sort_param *param, uchar *to);
 
 static void register_used_fields(Sort_param *param);
@@ -877,6 +880,30 @@ static void dbug_print_record(TABLE *table, bool print_rowid)
 #endif 
 
 
+/**
+  Read the next row to sort into sort_form->record[0] and position().
+  @return handler error code
+*/
+
+static int read_sort_row(Sort_param *param, SQL_SELECT *select,
+                         bool quick_select)
+{
+  TABLE *sort_form= param->sort_form;
+  int error;
+  if (quick_select)
+    error= select->quick->get_next();
+  else					/* Not quick-select */
+  {
+    error= sort_form->file->ha_rnd_next(sort_form->record[0]);
+    if (param->unpack)
+      param->unpack(sort_form);
+  }
+  if (likely(!error))
+    sort_form->file->position(sort_form->record[0]);
+  return error;
+}
+
+
 /**
   Search after sort_keys, and write them into tempfile
   (if we run out of space in the sort_keys buffer).
@@ -938,6 +965,10 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
   ha_rows num_records= 0;
   const bool packed_format= param->is_packed_format();
   const bool using_packed_sortkeys= param->using_packed_sortkeys();
+  Item_batch batch;
+  bool use_batch, batch_row_by_row= false, batch_keys= false;
+  uint batch_row= 0;
+  int batch_error= 0;
 
   DBUG_ENTER("find_all_keys");
   DBUG_PRINT("info",("using: %s",
@@ -996,19 +1027,77 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
     sort_form->column_bitmaps_set(save_read_set, save_write_set);
   DEBUG_SYNC(thd, "after_index_merge_phase1");
 
+  /*
+    Evaluate the condition in batches over rows that are read ahead,
+    where the reading ahead cannot be observed (see Item_batch).
+    LIMIT ROWS EXAMINED must stop the reads at the exact row.
+  */
+  use_batch= select && select->cond && !select->cond->with_subquery() &&
+    !param->unpack && !sort_form->s->blob_fields &&
+    sort_form->reginfo.lock_type < TL_READ_WITH_SHARED_LOCKS &&
+    thd->lex->sql_command == SQLCOM_SELECT &&
+    thd->lex->limit_rows_examined_cnt == ULONGLONG_MAX;
+  if (use_batch)
+  {
+    /*
+      Numeric sort key expressions are computed in batch with the
+      condition, unless the keys go to the priority queue or are packed.
+    */
+    const uint n_sort_fields= uint(param->local_sortorder.size());
+    Item **values= NULL;
+    if (!pq && !using_packed_sortkeys &&
+        (values= thd->alloc<Item*>(n_sort_fields)))
+    {
+      for (uint i= 0; i < n_sort_fields; i++)
+      {
+        const SORT_FIELD &sort_field= param->local_sortorder[i];
+        Item *item= sort_field.item;
+        values[i]= NULL;
+        if (!sort_field.field && item->type() != Item::FIELD_ITEM &&
+            (item->cmp_type() == INT_RESULT ||
+             item->cmp_type() == REAL_RESULT) &&
+            item->result_type() == item->cmp_type())
+        {
+          values[i]= item;
+          batch_keys= true;
+        }
+      }
+    }
+    use_batch= !batch.init(sort_form, select->cond, file->ref_length,
+                           batch_keys ? values : NULL,
+                           batch_keys ? n_sort_fields : 0);
+  }
+
   for (;;)
   {
-    if (quick_select)
-      error= select->quick->get_next();
-    else					/* Not quick-select */
+    bool batch_passed= false;
+    if (use_batch)
     {
-      error= file->ha_rnd_next(sort_form->record[0]);
-      if (param->unpack)
-        param->unpack(sort_form);
+      if (batch_row == batch.rows())
+      {
+        /* The error that ended the previous batch, if any */
+        if ((error= batch_error))
+          break;
+        batch.clear();
+        batch_row= 0;
+        while (!batch.is_full() &&
+               likely(!(batch_error= read_sort_row(param, select,
+                                                   quick_select))))
+          batch.add_row(file->ref);
+        if (!batch.rows())
+        {
+          error= batch_error;
+          break;
+        }
+        batch_row_by_row= batch.evaluate();
+      }
+      batch_passed= batch_row_by_row || batch.result(batch_row);
+      if (batch_passed)
+        batch.restore_row(batch_row);
+      ref_pos= batch.ref(batch_row++);
     }
-    if (unlikely(error))
+    else if (unlikely((error= read_sort_row(param, select, quick_select))))
       break;
-    file->position(sort_form->record[0]);
     DBUG_EXECUTE_IF("debug_filesort", dbug_print_record(sort_form, TRUE););
 
     if (unlikely(thd->check_killed()))
@@ -1036,11 +1125,17 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
         MY_BITMAP *tmp_read_set= sort_form->read_set;
         MY_BITMAP *tmp_write_set= sort_form->write_set;
 
-        if (select->cond->with_subquery())
-          sort_form->column_bitmaps_set(save_read_set, save_write_set);
-        write_record= (select->skip_record(thd) > 0);
-        if (select->cond->with_subquery())
-          sort_form->column_bitmaps_set(tmp_read_set, tmp_write_set);
+        if (use_batch && !batch_row_by_row)
+          write_record= batch_passed && batch.val_residual() &&
+            !thd->is_error();
+        else
+        {
+          if (select->cond->with_subquery())
+            sort_form->column_bitmaps_set(save_read_set, save_write_set);
+          write_record= (select->skip_record(thd) > 0);
+          if (select->cond->with_subquery())
+            sort_form->column_bitmaps_set(tmp_read_set, tmp_write_set);
+        }
       }
       else
         write_record= true;
@@ -1064,8 +1159,11 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
           fs_info->init_next_record_pointer();
         uchar *start_of_rec= fs_info->get_next_record_pointer();
 
-        const uint rec_sz= make_sortkey(param, start_of_rec,
-                                        ref_pos, using_packed_sortkeys);
+        const uint rec_sz=
+          use_batch && batch_keys
+          ? make_sortkey(param, start_of_rec, ref_pos, false,
+                         &batch, batch_row - 1)
+          : make_sortkey(param, start_of_rec, ref_pos, using_packed_sortkeys);
         if (packed_format && rec_sz != param->rec_length)
           fs_info->adjust_next_record_pointer(rec_sz);
         num_elements_in_buffer++;
@@ -1080,9 +1178,10 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
 
     /*
       We need to this after checking the error as the transaction may have
-      rolled back in case of a deadlock
+      rolled back in case of a deadlock. With use_batch, the rows are not
+      locked and the handler is positioned on some later row.
     */
-    if (!write_record)
+    if (!write_record && !use_batch)
       file->unlock_row();
   }
   if (!quick_select)
@@ -1293,6 +1392,20 @@ Type_handler_int_result::make_sort_key_part(uchar *to, Item *item,
 }
 
 
+bool
+Type_handler_int_result::make_batch_sort_key_part(uchar *to, Item *item,
+                                            const SORT_FIELD_ATTR *sort_field,
+                                            const Item_batch_vec &vec,
+                                            uint row) const
+{
+  if (vec.type != INT_RESULT || vec.unsigned_flag != item->unsigned_flag)
+    return false;
+  make_sort_key_longlong(to, item->maybe_null(), vec.null[row],
+                         item->unsigned_flag, vec.ival[row]);
+  return true;
+}
+
+
 void
 Type_handler_temporal_result::make_sort_key_part(uchar *to, Item *item,
                                             const SORT_FIELD_ATTR *sort_field,
@@ -1448,16 +1561,39 @@ Type_handler_real_result::make_sort_key_part(uchar *to, Item *item,
 }
 
 
+bool
+Type_handler_real_result::make_batch_sort_key_part(uchar *to, Item *item,
+                                            const SORT_FIELD_ATTR *sort_field,
+                                            const Item_batch_vec &vec,
+                                            uint row) const
+{
+  if (vec.type != REAL_RESULT)
+    return false;
+  if (item->maybe_null())
+  {
+    if (vec.null[row])
+    {
+      memset(to, 0, sort_field->length + 1);
+      return true;
+    }
+    *to++= 1;
+  }
+  change_double_for_sort(vec.rval[row], to);
+  return true;
+}
+
+
 /** Make a sort-key from record. */
 
 static uint make_sortkey(Sort_param *param, uchar *to, uchar *ref_pos,
-                         bool using_packed_sortkeys)
+                         bool using_packed_sortkeys,
+                         const Item_batch *batch, uint batch_row)
 {
   uchar *orig_to= to;
 
   to+= using_packed_sortkeys ?
        make_packed_sortkey(param, to) :
-       make_sortkey(param, to);
+       make_sortkey(param, to, batch, batch_row);
 
   if (param->using_addon_fields())
   {
@@ -2979,12 +3115,16 @@ SORT_FIELD_ATTR::pack_sort_string(uchar *to, const Binary_string *str,
 
   @param  param          sort param structure
   @param  to             buffer where values are written
+  @param  batch          the batch that computed values of the sort key
+                         items, or NULL
+  @param  batch_row      the row of batch that is in the record
 
   @retval
     length of the bytes written including the NULL bytes
 */
 
-static uint make_sortkey(Sort_param *param, uchar *to)
+static uint make_sortkey(Sort_param *param, uchar *to,
+                         const Item_batch *batch, uint batch_row)
 {
   Field *field;
   SORT_FIELD *sort_field;
@@ -2995,6 +3135,7 @@ static uint make_sortkey(Sort_param *param, uchar *to)
        sort_field++)
   {
     bool maybe_null=0;
+    const Item_batch_vec *vec;
     if ((field=sort_field->field))
     { // Field
       field->make_sort_key_part(to, sort_field->length);
@@ -3003,9 +3144,16 @@ static uint make_sortkey(Sort_param *param, uchar *to)
     }
     else
     { // Item
-      sort_field->item->type_handler()->make_sort_key_part(to, sort_field->item,
-                                                           sort_field,
-                                                           &param->tmp_buffer);
+      if (!batch ||
+          !(vec= batch->value(uint(sort_field -
+                                   param->local_sortorder.begin()))) ||
+          !sort_field->item->type_handler()->
+            make_batch_sort_key_part(to, sort_field->item, sort_field,
+                                     *vec, batch_row))
+        sort_field->item->type_handler()->make_sort_key_part(to,
+                                                             sort_field->item,
+                                                             sort_field,
+                                                             &param->tmp_buffer);
       if ((maybe_null= sort_field->item->maybe_null()))
         to++;
     }
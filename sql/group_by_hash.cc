@@ -0,0 +1,188 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+/**
+  @file
+
+  @brief
+  In-memory hash table of GROUP BY groups, see group_by_hash.h.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "group_by_hash.h"
+
+/** The initial number of slots */
+static constexpr size_t GROUP_BY_HASH_MIN_SIZE= 1024;
+
+
+Group_by_hash::Group_by_hash(TABLE *table, TMP_TABLE_PARAM *param,
+                             size_t max_memory)
+  : m_table(table), m_param(param), m_slots(NULL), m_size(0), m_groups(0),
+    m_first(NULL), m_last(NULL), m_memory(0), m_max_memory(max_memory)
+{
+  m_record_offset= sizeof(Entry) + MY_ALIGN(param->group_length, 8);
+  m_entry_size= m_record_offset + MY_ALIGN(table->s->reclength, 8);
+  init_alloc_root(PSI_INSTRUMENT_ME, &m_root,
+                  MY_MAX(m_entry_size * 64, size_t{8192}), 0,
+                  MYF(MY_THREAD_SPECIFIC));
+}
+
+
+Group_by_hash::~Group_by_hash()
+{
+  free_root(&m_root, MYF(0));
+  my_free(m_slots);
+}
+
+
+void Group_by_hash::reset()
+{
+  free_root(&m_root, MYF(MY_MARK_BLOCKS_FREE));
+  if (m_slots)
+    bzero(m_slots, m_size * sizeof *m_slots);
+  m_groups= 0;
+  m_first= m_last= NULL;
+  m_memory= m_size * sizeof *m_slots;
+}
+
+
+/**
+  @return the hash value of the key in group_buff, computed from the
+  GROUP BY fields in the same way as the hash index of a HEAP table,
+  so that values that compare equal have the same hash value
+*/
+uint32 Group_by_hash::hash_key() const
+{
+  Hasher hasher;
+  for (ORDER *group= m_table->group; group; group= group->next)
+  {
+    if ((*group->item)->maybe_null() && group->buff[-1])
+      hasher.add_null();
+    else
+      group->field->hash_not_null(&hasher);
+  }
+  /* Spread the bits for the linear probing (the murmur3 finalizer) */
+  uint32 h= hasher.finalize();
+  h^= h >> 16;
+  h*= 0x85ebca6b;
+  h^= h >> 13;
+  h*= 0xc2b2ae35;
+  h^= h >> 16;
+  return h;
+}
+
+
+/**
+  Compare the key in group_buff with the key of a group.
+*/
+bool Group_by_hash::key_equal(const uchar *key) const
+{
+  const uchar *group_buff= m_param->group_buff;
+  if (!memcmp(key, group_buff, m_param->group_length))
+    return true;
+  /* Equal values may have different images, e.g. 'a' and 'A' */
+  for (ORDER *group= m_table->group; group; group= group->next)
+  {
+    const size_t offset= (uchar*) group->buff - group_buff;
+    if ((*group->item)->maybe_null())
+    {
+      if (key[offset - 1] != group_buff[offset - 1])
+        return false;
+      if (key[offset - 1])
+        continue;
+    }
+    if (group->field->key_cmp(key + offset, group_buff + offset))
+      return false;
+  }
+  return true;
+}
+
+
+uchar *Group_by_hash::find(uint32 *hash)
+{
+  const uint32 h= *hash= hash_key();
+  if (!m_slots)
+    return NULL;
+  for (size_t i= h & (m_size - 1);; i= (i + 1) & (m_size - 1))
+  {
+    Slot *slot= &m_slots[i];
+    if (!slot->entry)
+      return NULL;
+    if (slot->hash == h && key_equal(key(slot->entry)))
+      return record(slot->entry);
+  }
+}
+
+
+/**
+  Double the number of slots.
+  @return whether the memory limit was reached
+*/
+bool Group_by_hash::grow()
+{
+  const size_t size= m_size ? m_size * 2 : GROUP_BY_HASH_MIN_SIZE;
+  if (m_memory + (size - m_size) * sizeof(Slot) > m_max_memory)
+    return true;
+  Slot *slots= (Slot*) my_malloc(PSI_INSTRUMENT_ME, size * sizeof(Slot),
+                                 MYF(MY_THREAD_SPECIFIC | MY_ZEROFILL));
+  if (!slots)
+    return true;
+  for (size_t i= 0; i < m_size; i++)
+  {
+    if (!m_slots[i].entry)
+      continue;
+    size_t j= m_slots[i].hash & (size - 1);
+    while (slots[j].entry)
+      j= (j + 1) & (size - 1);
+    slots[j]= m_slots[i];
+  }
+  my_free(m_slots);
+  m_slots= slots;
+  m_memory+= (size - m_size) * sizeof(Slot);
+  m_size= size;
+  return false;
+}
+
+
+uchar *Group_by_hash::add(uint32 hash)
+{
+  /* Keep the load factor at most 1/2 */
+  if ((m_groups + 1) * 2 > m_size && grow())
+    return NULL;
+  if (m_memory + m_entry_size > m_max_memory)
+    return NULL;
+  Entry *entry= (Entry*) alloc_root(&m_root, m_entry_size);
+  if (!entry)
+    return NULL;
+  m_memory+= m_entry_size;
+
+  memcpy(key(entry), m_param->group_buff, m_param->group_length);
+  entry->next= NULL;
+  if (m_last)
+    m_last->next= entry;
+  else
+    m_first= entry;
+  m_last= entry;
+
+  size_t i= hash & (m_size - 1);
+  while (m_slots[i].entry)
+    i= (i + 1) & (m_size - 1);
+  m_slots[i].hash= hash;
+  m_slots[i].entry= entry;
+  m_groups++;
+  return record(entry);
+}
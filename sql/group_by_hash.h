@@ -0,0 +1,116 @@
+#ifndef GROUP_BY_HASH_INCLUDED
+#define GROUP_BY_HASH_INCLUDED
+
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+/**
+  @file
+
+  In-memory hash table of GROUP BY groups.
+
+  When GROUP BY is computed over rows that come in arbitrary order, every
+  row is aggregated into a temporary table that has a unique index on the
+  GROUP BY columns (see end_update()). Group_by_hash keeps the rows of
+  that temporary table in memory instead: a group is looked up in an open
+  addressing hash table and its partial sums are updated in place, which
+  avoids the index lookup and row update in the temporary table engine
+  for every row. The groups are written to the temporary table once, at
+  the end (see AGGR_OP::put_hash_record()).
+
+  The key of a group is the GROUP BY key image that end_update() builds
+  in TMP_TABLE_PARAM::group_buff, the value is the temporary table record.
+*/
+
+#include "my_sys.h"
+#include "sql_alloc.h"
+
+struct TABLE;
+class TMP_TABLE_PARAM;
+
+class Group_by_hash: public Sql_alloc
+{
+  /** A group. The key and the record follow the header. */
+  struct Entry
+  {
+    /** The next group in the order of creation */
+    Entry *next;
+  };
+
+  struct Slot
+  {
+    uint32 hash;
+    /** NULL for a free slot */
+    Entry *entry;
+  };
+
+public:
+  Group_by_hash(TABLE *table, TMP_TABLE_PARAM *param, size_t max_memory);
+  ~Group_by_hash();
+
+  /**
+    Find the group of the key in TMP_TABLE_PARAM::group_buff.
+    @param[out] hash  the hash value of the key, to pass to add()
+    @return the record of the group, or NULL if there is no such group
+  */
+  uchar *find(uint32 *hash);
+
+  /**
+    Add a group for the key in TMP_TABLE_PARAM::group_buff, which find()
+    did not find.
+    @return memory for the record of the group,
+    @retval NULL  the memory limit was reached
+  */
+  uchar *add(uint32 hash);
+
+  /** Remove all groups */
+  void reset();
+
+  ulonglong groups() const { return m_groups; }
+
+  /** @return the record of the first group in the order of creation */
+  uchar *first_record() const
+  { return m_first ? record(m_first) : NULL; }
+  /** @return the record of the group created after the given one */
+  uchar *next_record(uchar *rec) const
+  {
+    Entry *next= ((Entry*) (rec - m_record_offset))->next;
+    return next ? record(next) : NULL;
+  }
+
+private:
+  uchar *key(Entry *entry) const { return (uchar*) (entry + 1); }
+  uchar *record(Entry *entry) const
+  { return (uchar*) entry + m_record_offset; }
+  uint32 hash_key() const;
+  bool key_equal(const uchar *key) const;
+  bool grow();
+
+  TABLE *m_table;
+  TMP_TABLE_PARAM *m_param;
+  /** memory for the entries */
+  MEM_ROOT m_root;
+  Slot *m_slots;
+  /** the number of slots, a power of 2 */
+  size_t m_size;
+  ulonglong m_groups;
+  Entry *m_first, *m_last;
+  size_t m_record_offset;
+  size_t m_entry_size;
+  /** the memory used for the slots and entries, and its limit */
+  size_t m_memory, m_max_memory;
+};
+
+#endif /* GROUP_BY_HASH_INCLUDED */
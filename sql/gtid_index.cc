@@ -139,11 +139,13 @@ void
 Gtid_index_writer::gtid_index_init()
 {
   mysql_mutex_init(key_gtid_index_lock, &gtid_index_mutex, MY_MUTEX_INIT_SLOW);
+  Gtid_index_start_states::init();
 }
 
 void
 Gtid_index_writer::gtid_index_cleanup()
 {
+  Gtid_index_start_states::cleanup();
   mysql_mutex_destroy(&gtid_index_mutex);
 }
 
@@ -791,6 +793,27 @@ Gtid_index_reader::search_gtid_list()
 }
 
 
+int
+Gtid_index_reader::search_start_state(uint32 *out_offset,
+                                      uint32 *out_gtid_count)
+{
+  /* The first page may not be written yet in an incomplete index. */
+  if (!has_root_node)
+    return -1;
+
+  uint32 gtid_count;
+  if (read_node_cold(1) || get_offset_count(out_offset, &gtid_count))
+    return -1;
+  /* The first record in the index is not delta-compressed. */
+  rpl_gtid *gtid_list= gtid_list_buffer(gtid_count);
+  if ((gtid_count > 0 && !gtid_list) ||
+      get_gtid_list(gtid_list, gtid_count))
+    return -1;
+  *out_gtid_count= gtid_count;
+  return 1;
+}
+
+
 int
 Gtid_index_reader::search_cmp_offset(uint32 offset,
                                      rpl_binlog_state_base *state)
@@ -1432,3 +1455,138 @@ Gtid_index_reader_hot::read_node_hot()
   read_ptr= read_page->flag_ptr + GTID_INDEX_PAGE_HEADER_SIZE;
   return 0;
 }
+
+
+HASH Gtid_index_start_states::hash;
+
+
+void
+Gtid_index_start_states::init()
+{
+  my_hash_init(key_memory_binlog_gtid_index, &hash, &my_charset_bin, 32, 0, 0,
+               get_key, my_free, HASH_UNIQUE);
+}
+
+
+void
+Gtid_index_start_states::cleanup()
+{
+  my_hash_free(&hash);
+}
+
+
+const uchar *
+Gtid_index_start_states::get_key(const void *entry, size_t *length, my_bool)
+{
+  const Start_state *e= static_cast<const Start_state *>(entry);
+  *length= e->name_len;
+  return reinterpret_cast<const uchar *>(e->name);
+}
+
+
+/*
+  Binlog files are identified by the name without the directory, which is the
+  same whether it comes from the binlog index file or from the open binlog.
+*/
+const char *
+Gtid_index_start_states::binlog_base_name(const char *binlog_name,
+                                          size_t *length)
+{
+  const char *name= binlog_name + dirname_length(binlog_name);
+  *length= strlen(name);
+  return name;
+}
+
+
+void
+Gtid_index_start_states::add(const char *binlog_name,
+                             const rpl_gtid *gtid_list, uint32 gtid_count,
+                             bool replace)
+{
+  size_t name_len;
+  const char *name= binlog_base_name(binlog_name, &name_len);
+
+  Start_state *e= (Start_state *)
+    my_malloc(key_memory_binlog_gtid_index,
+              sizeof(*e) + gtid_count*sizeof(rpl_gtid) + name_len + 1, MYF(0));
+  if (!e)
+    return;                    // Not fatal, the file will just be read
+  e->gtid_list= reinterpret_cast<rpl_gtid *>(e + 1);
+  e->gtid_count= gtid_count;
+  if (gtid_count)
+    memcpy(e->gtid_list, gtid_list, gtid_count*sizeof(rpl_gtid));
+  char *name_copy= reinterpret_cast<char *>(e->gtid_list + gtid_count);
+  memcpy(name_copy, name, name_len + 1);
+  e->name= name_copy;
+  e->name_len= name_len;
+
+  Gtid_index_writer::lock_gtid_index();
+  uchar *old= my_hash_search(&hash, (const uchar *)name, name_len);
+  if (old && replace)
+  {
+    my_hash_delete(&hash, old);
+    old= nullptr;
+  }
+  if (old || my_hash_insert(&hash, (uchar *)e))
+    my_free(e);
+  Gtid_index_writer::unlock_gtid_index();
+}
+
+
+int
+Gtid_index_start_states::get(const char *binlog_name, rpl_gtid **buf,
+                             uint32 *buf_alloc, uint32 *out_gtid_count)
+{
+  size_t name_len;
+  const char *name= binlog_base_name(binlog_name, &name_len);
+  int res= 0;
+
+  Gtid_index_writer::lock_gtid_index();
+  const Start_state *e= (const Start_state *)
+    my_hash_search(&hash, (const uchar *)name, name_len);
+  if (e)
+  {
+    if (e->gtid_count > *buf_alloc)
+    {
+      rpl_gtid *new_buf= (rpl_gtid *)
+        my_realloc(key_memory_binlog_gtid_index, *buf,
+                   e->gtid_count*sizeof(rpl_gtid),
+                   MYF(MY_ALLOW_ZERO_PTR));
+      if (!new_buf)
+      {
+        Gtid_index_writer::unlock_gtid_index();
+        return -1;
+      }
+      *buf= new_buf;
+      *buf_alloc= e->gtid_count;
+    }
+    if (e->gtid_count)
+      memcpy(*buf, e->gtid_list, e->gtid_count*sizeof(rpl_gtid));
+    *out_gtid_count= e->gtid_count;
+    res= 1;
+  }
+  Gtid_index_writer::unlock_gtid_index();
+  return res;
+}
+
+
+void
+Gtid_index_start_states::remove(const char *binlog_name)
+{
+  size_t name_len;
+  const char *name= binlog_base_name(binlog_name, &name_len);
+
+  Gtid_index_writer::lock_gtid_index();
+  if (uchar *e= my_hash_search(&hash, (const uchar *)name, name_len))
+    my_hash_delete(&hash, e);
+  Gtid_index_writer::unlock_gtid_index();
+}
+
+
+void
+Gtid_index_start_states::remove_all()
+{
+  Gtid_index_writer::lock_gtid_index();
+  my_hash_reset(&hash);
+  Gtid_index_writer::unlock_gtid_index();
+}
@@ -367,6 +367,7 @@ class Gtid_index_writer : public Gtid_index_base
   static void gtid_index_cleanup();
 protected:
   friend class Gtid_index_reader_hot;
+  friend class Gtid_index_start_states;
   static void lock_gtid_index() { mysql_mutex_lock(&gtid_index_mutex); }
   static void unlock_gtid_index() { mysql_mutex_unlock(&gtid_index_mutex); }
   static const Gtid_index_writer *find_hot_index(const char *file_name);
@@ -452,6 +453,12 @@ class Gtid_index_reader : public Gtid_index_base
   int search_gtid_pos(slave_connection_state *in_gtid_pos, uint32 *out_offset,
                       uint32 *out_gtid_count);
   rpl_gtid *search_gtid_list();
+  /*
+    Read the first record of a complete index, the GTID state at the start of
+    the binlog file (the same as in its initial GTID_LIST event). Returns 1
+    for found or -1 for error, and the GTIDs like the search functions.
+  */
+  int search_start_state(uint32 *out_offset, uint32 *out_gtid_count);
 
 protected:
   int search_cmp_offset(uint32 offset, rpl_binlog_state_base *state);
@@ -518,4 +525,64 @@ class Gtid_index_reader_hot : public Gtid_index_reader
   uint32 hot_level;
 };
 
+
+/*
+  The GTID state at the start of each binlog file, kept in memory.
+
+  This is the first record of the GTID index of every binlog file, and serves
+  as an in-memory top level above the per-file indexes. A connecting slave can
+  skip the binlog files that start after its position without opening them or
+  their index, so only the binlog file that contains the position is read.
+
+  An entry is set when a new binlog file is created, and added when the start
+  state of an older binlog file is first read from its index or GTID_LIST
+  event. Entries are removed when the binlog files are purged or reset.
+  Protected by Gtid_index_writer::gtid_index_mutex.
+*/
+class Gtid_index_start_states
+{
+public:
+  static void init();
+  static void cleanup();
+  /* Set the start state of a new binlog file. */
+  static void set(const char *binlog_name,
+                  const rpl_gtid *gtid_list, uint32 gtid_count)
+  { add(binlog_name, gtid_list, gtid_count, true); }
+  /*
+    Add the start state read from an existing binlog file. An entry already
+    present is kept, as the file may have been replaced by a new one with the
+    same name (RESET MASTER) since it was read.
+  */
+  static void add(const char *binlog_name,
+                  const rpl_gtid *gtid_list, uint32 gtid_count)
+  { add(binlog_name, gtid_list, gtid_count, false); }
+  /*
+    Copy the start state of a binlog file into *buf, which is grown with
+    my_realloc() as needed and must be freed by the caller. Returns:
+      0   for not found.
+      1   for found, with the number of GTIDs in *out_gtid_count.
+     -1   for out of memory.
+  */
+  static int get(const char *binlog_name, rpl_gtid **buf, uint32 *buf_alloc,
+                 uint32 *out_gtid_count);
+  static void remove(const char *binlog_name);
+  static void remove_all();
+
+private:
+  struct Start_state
+  {
+    const char *name;
+    size_t name_len;
+    rpl_gtid *gtid_list;
+    uint32 gtid_count;
+  };
+
+  static void add(const char *binlog_name, const rpl_gtid *gtid_list,
+                  uint32 gtid_count, bool replace);
+  static const uchar *get_key(const void *entry, size_t *length, my_bool);
+  static const char *binlog_base_name(const char *binlog_name, size_t *length);
+
+  static HASH hash;
+};
+
 #endif  /* GTID_INDEX_H */
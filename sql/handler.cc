@@ -5479,13 +5479,31 @@ int handler::ha_repair(THD* thd, HA_CHECK_OPT* check_opt)
    End bulk insert
 */
 
+void handler::ha_start_bulk_insert(ha_rows rows, uint flags)
+{
+  DBUG_ENTER("handler::ha_start_bulk_insert");
+  estimation_rows_to_insert= rows;
+  bzero(&copy_info,sizeof(copy_info));
+  start_bulk_insert(rows, flags);
+  if (table->file == this)
+    table->hlindexes_on_start_bulk_insert();
+  DBUG_VOID_RETURN;
+}
+
 int handler::ha_end_bulk_insert()
 {
   DBUG_ENTER("handler::ha_end_bulk_insert");
   DBUG_EXECUTE_IF("crash_end_bulk_insert",
                   { extra(HA_EXTRA_FLUSH) ; DBUG_SUICIDE();});
   estimation_rows_to_insert= 0;
-  DBUG_RETURN(end_bulk_insert());
+  int error= end_bulk_insert();
+  if (table->file == this)
+  {
+    int err= table->hlindexes_on_end_bulk_insert();
+    if (!error)
+      error= err;
+  }
+  DBUG_RETURN(error);
 }
 
 /**
@@ -7620,6 +7638,8 @@ static int binlog_log_row_to_binlog(TABLE* table,
   auto *cache= binlog_get_cache_data(cache_mngr,
                                      use_trans_cache(thd, has_trans));
 
+  binlog_writeset_add_row(cache, table, before_record, after_record);
+
     error= (*log_func)(thd, table, mysql_bin_log.as_event_log(), cache,
                        has_trans, thd->variables.binlog_row_image,
                        before_record, after_record);
@@ -3661,14 +3661,7 @@ class handler :public Sql_alloc
   /** to be actually called to get 'check()' functionality*/
   int ha_check(THD *thd, HA_CHECK_OPT *check_opt);
   int ha_repair(THD* thd, HA_CHECK_OPT* check_opt);
-  void ha_start_bulk_insert(ha_rows rows, uint flags= 0)
-  {
-    DBUG_ENTER("handler::ha_start_bulk_insert");
-    estimation_rows_to_insert= rows;
-    bzero(&copy_info,sizeof(copy_info));
-    start_bulk_insert(rows, flags);
-    DBUG_VOID_RETURN;
-  }
+  void ha_start_bulk_insert(ha_rows rows, uint flags= 0);
   int ha_end_bulk_insert();
   int ha_bulk_update_row(const uchar *old_data, const uchar *new_data,
                          ha_rows *dup_key_found);
@@ -4385,6 +4378,14 @@ class handler :public Sql_alloc
     ha_rnd_end();
     return error;
   }
+  /**
+    Hint that the row with the given key is going to be read soon. The
+    engine may start reading the index pages of the key in the background.
+    @return 0, or HA_ERR_WRONG_COMMAND if the engine cannot read ahead
+  */
+  virtual int prefetch_key(uint keynr, const uchar *key,
+                           key_part_map keypart_map)
+  { return HA_ERR_WRONG_COMMAND; }
   virtual int read_first_row(uchar *buf, uint primary_key);
 public:
 
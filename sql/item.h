@@ -117,6 +117,8 @@ struct KEY_FIELD;
 struct SARGABLE_PARAM;
 class RANGE_OPT_PARAM;
 class SEL_TREE;
+class Item_batch;
+class Item_batch_vec;
 
 enum precedence {
   LOWEST_PRECEDENCE,
@@ -2098,6 +2100,21 @@ class Item :public Value_source,
                           with one of the partN evaluating to SEL_TREE::ALWAYS.
    */
    virtual SEL_TREE *get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr);
+  /*
+    Batch evaluation, see item_batch.h.
+    batch_supported() tells whether val_batch() can compute the value of
+    the item for all rows of the batch (the arguments are checked with
+    Item_batch::supported()).
+    val_batch() stores the values into a vector of type cmp_type() and
+    returns true if the batch must be evaluated row by row instead
+    (e.g. because an error or warning would have to be raised).
+  */
+  virtual bool batch_supported(Item_batch *batch) { return false; }
+  virtual bool val_batch(Item_batch *batch, Item_batch_vec *to)
+  {
+    DBUG_ASSERT(0);
+    return true;
+  }
   /*
     Checks whether the item is:
     - a simple equality (field=field_item or field=constant_item), or
@@ -3741,6 +3758,8 @@ class Item_field :public Item_ident,
   double val_real() override;
   longlong val_int() override;
   bool val_bool() override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   my_decimal *val_decimal(my_decimal *) override;
   String *val_str(String*) override;
   void save_result(Field *to) override;
@@ -0,0 +1,1024 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+/**
+  @file
+
+  @brief
+  Batch evaluation of conditions, see item_batch.h.
+  This file contains Item_batch and the batch_supported()/val_batch()
+  implementations of all items that support batch evaluation.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "item.h"
+#include "item_cmpfunc.h"
+#include "item_batch.h"
+#include <cmath>
+
+
+Item_batch::~Item_batch()
+{
+  my_free(m_buffer);
+}
+
+
+/**
+  @return whether a top level conjunct of the condition is evaluated
+  in batch
+*/
+static bool batch_cond(Item_batch *batch, Item *item)
+{
+  return batch->supported(item) && item->cmp_type() != STRING_RESULT;
+}
+
+
+bool Item_batch::init(TABLE *table, Item *cond, uint ref_length,
+                      Item **values, uint n_values)
+{
+  DBUG_ENTER("Item_batch::init");
+  DBUG_ASSERT(!m_buffer);
+  m_table= table;
+  m_cond= cond;
+  m_ref_length= ref_length;
+  m_reclength= table->s->reclength;
+  m_max_rows= uint(MY_MIN(size_t{MAX_ROWS}, MAX_BUFFER / m_reclength));
+  if (m_max_rows < MIN_ROWS)
+    DBUG_RETURN(true);
+
+  Item_cond *and_cond= NULL;
+  List_iterator_fast<Item> li;
+  if (cond->type() == Item::COND_ITEM &&
+      ((Item_cond*) cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    and_cond= (Item_cond*) cond;
+    li.init(*and_cond->argument_list());
+  }
+
+  /* m_n_vecs counts the vectors that supported() accepted items may need */
+  Item *item;
+  for (item= and_cond ? li++ : cond; item; item= and_cond ? li++ : NULL)
+  {
+    m_n_conds++;
+    if (batch_cond(this, item))
+      m_n_batch_conds++;
+  }
+  if (!m_n_batch_conds)
+    DBUG_RETURN(true);
+  /* Count the vectors that computing the values may need, and theirs */
+  for (uint i= 0; i < n_values; i++)
+    if (values[i])
+      batch_cond(this, values[i]);
+  m_n_values= n_values;
+  m_n_vecs+= n_values;
+
+  const size_t vec_data= MY_ALIGN(m_max_rows * sizeof(longlong), 8) +
+    MY_ALIGN(m_max_rows * sizeof(uint32), 8) +
+    MY_ALIGN(m_max_rows * sizeof(bool), 8);
+  const size_t size= m_n_vecs * (sizeof(Item_batch_vec) + vec_data) +
+    MY_ALIGN(m_n_conds * sizeof(Item*), 8) +
+    MY_ALIGN(n_values * sizeof(Item*), 8) +
+    MY_ALIGN(m_max_rows * size_t{m_reclength}, 8) +
+    MY_ALIGN(m_max_rows * size_t{ref_length}, 8) +
+    m_max_rows * sizeof(bool);
+  if (!(m_buffer= (uchar*) my_malloc(PSI_INSTRUMENT_ME, size, MYF(0))))
+    DBUG_RETURN(true);
+
+  uchar *ptr= m_buffer;
+  m_vecs= (Item_batch_vec*) ptr;
+  ptr+= m_n_vecs * sizeof(Item_batch_vec);
+  for (uint i= 0; i < m_n_vecs; i++)
+  {
+    m_vecs[i].ival= (longlong*) ptr;
+    ptr+= MY_ALIGN(m_max_rows * sizeof(longlong), 8);
+    m_vecs[i].slen= (uint32*) ptr;
+    ptr+= MY_ALIGN(m_max_rows * sizeof(uint32), 8);
+    m_vecs[i].null= (bool*) ptr;
+    ptr+= MY_ALIGN(m_max_rows * sizeof(bool), 8);
+  }
+  m_conds= (Item**) ptr;
+  ptr+= MY_ALIGN(m_n_conds * sizeof(Item*), 8);
+  m_values= (Item**) ptr;
+  ptr+= MY_ALIGN(n_values * sizeof(Item*), 8);
+  m_records= ptr;
+  ptr+= MY_ALIGN(m_max_rows * size_t{m_reclength}, 8);
+  m_refs= ptr;
+  ptr+= MY_ALIGN(m_max_rows * size_t{ref_length}, 8);
+  m_result= (bool*) ptr;
+
+  /* The conjuncts that are evaluated in batch go first */
+  const uint n_vecs= m_n_vecs;
+  uint batch_pos= 0, residual_pos= m_n_batch_conds;
+  if (and_cond)
+    li.rewind();
+  for (item= and_cond ? li++ : cond; item; item= and_cond ? li++ : NULL)
+    m_conds[batch_cond(this, item) ? batch_pos++ : residual_pos++]= item;
+  DBUG_ASSERT(batch_pos == m_n_batch_conds && residual_pos == m_n_conds);
+  for (uint i= 0; i < n_values; i++)
+    m_values[i]= values[i] && batch_cond(this, values[i]) ? values[i] : NULL;
+
+  /* The vectors of the values are reserved at the end */
+  m_n_vecs= n_vecs - n_values;
+  m_value_vecs= m_vecs + m_n_vecs;
+  DBUG_RETURN(false);
+}
+
+
+void Item_batch::add_row(const uchar *ref)
+{
+  DBUG_ASSERT(m_rows < m_max_rows);
+  memcpy(m_records + m_rows * size_t{m_reclength}, m_table->record[0],
+         m_reclength);
+  if (m_ref_length)
+    memcpy(m_refs + m_rows * size_t{m_ref_length}, ref, m_ref_length);
+  m_rows++;
+}
+
+
+void Item_batch::restore_row(uint row)
+{
+  DBUG_ASSERT(row < m_rows);
+  memcpy(m_table->record[0], record(row), m_reclength);
+  m_table->status= 0;
+}
+
+
+bool Item_batch::evaluate()
+{
+  m_used_vecs= 0;
+  m_values_valid= false;
+  memset(m_result, true, m_rows);
+  for (uint c= 0; c < m_n_batch_conds; c++)
+  {
+    Item_batch_vec *vec= alloc_vec();
+    if (val_bool(m_conds[c], vec))
+      return true;
+    for (uint i= 0; i < m_rows; i++)
+      m_result[i]&= vec->ival[i] && !vec->null[i];
+    free_vecs(vec);
+  }
+  for (uint v= 0; v < m_n_values; v++)
+    if (m_values[v] && val(m_values[v], &m_value_vecs[v]))
+      return false; /* compute the values row by row */
+  m_values_valid= true;
+  return false;
+}
+
+
+bool Item_batch::val_residual()
+{
+  for (uint c= m_n_batch_conds; c < m_n_conds; c++)
+    if (!m_conds[c]->val_bool())
+      return false;
+  return true;
+}
+
+
+bool Item_batch::is_constant(Item *item) const
+{
+  if (item->used_tables() & (m_table->map | RAND_TABLE_BIT))
+    return false;
+  /*
+    Only items whose evaluation is cheap and cannot raise warnings, so
+    that evaluating them once per batch instead of once per row is not
+    observable.
+  */
+  switch (item->type()) {
+  case Item::CONST_ITEM:
+  case Item::CACHE_ITEM:
+  case Item::FIELD_ITEM:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+bool Item_batch::supported(Item *item)
+{
+  m_n_vecs++;
+  if (is_constant(item))
+    return item->cmp_type() == INT_RESULT || item->cmp_type() == REAL_RESULT;
+  return item->batch_supported(this);
+}
+
+
+bool Item_batch::val(Item *item, Item_batch_vec *to)
+{
+  if (!is_constant(item))
+    return item->val_batch(this, to);
+
+  to->type= item->cmp_type();
+  to->unsigned_flag= item->unsigned_flag;
+  if (to->type == REAL_RESULT)
+  {
+    const double value= item->val_real();
+    const bool null= item->null_value;
+    for (uint i= 0; i < m_rows; i++)
+    {
+      to->rval[i]= value;
+      to->null[i]= null;
+    }
+  }
+  else
+  {
+    DBUG_ASSERT(to->type == INT_RESULT);
+    const longlong value= item->val_int();
+    const bool null= item->null_value;
+    for (uint i= 0; i < m_rows; i++)
+    {
+      to->ival[i]= value;
+      to->null[i]= null;
+    }
+  }
+  return false;
+}
+
+
+bool Item_batch::val_real(Item *item, Item_batch_vec *to)
+{
+  if (val(item, to))
+    return true;
+  DBUG_ASSERT(to->type != STRING_RESULT);
+  if (to->type == INT_RESULT)
+  {
+    if (to->unsigned_flag)
+      for (uint i= 0; i < m_rows; i++)
+        to->rval[i]= ulonglong2double((ulonglong) to->ival[i]);
+    else
+      for (uint i= 0; i < m_rows; i++)
+        to->rval[i]= (double) to->ival[i];
+    to->type= REAL_RESULT;
+    to->unsigned_flag= false;
+  }
+  return false;
+}
+
+
+bool Item_batch::val_bool(Item *item, Item_batch_vec *to)
+{
+  if (val(item, to))
+    return true;
+  DBUG_ASSERT(to->type != STRING_RESULT);
+  if (to->type == REAL_RESULT)
+    for (uint i= 0; i < m_rows; i++)
+      to->ival[i]= to->rval[i] != 0.0;
+  else
+    for (uint i= 0; i < m_rows; i++)
+      to->ival[i]= to->ival[i] != 0;
+  to->type= INT_RESULT;
+  to->unsigned_flag= false;
+  return false;
+}
+
+
+/*
+  Fields: the values are read directly from the record images.
+*/
+
+bool Item_field::batch_supported(Item_batch *batch)
+{
+  if (type() != FIELD_ITEM || field->table != batch->table())
+    return false;
+  const Type_handler *th= field->type_handler();
+  return th == &type_handler_stiny || th == &type_handler_utiny ||
+    th == &type_handler_sshort || th == &type_handler_ushort ||
+    th == &type_handler_sint24 || th == &type_handler_uint24 ||
+    th == &type_handler_slong || th == &type_handler_ulong ||
+    th == &type_handler_slonglong || th == &type_handler_ulonglong ||
+    th == &type_handler_float || th == &type_handler_double ||
+    (th == &type_handler_varchar &&
+     field->real_type() == MYSQL_TYPE_VARCHAR);
+}
+
+
+template<typename T, typename LOAD>
+static void batch_load_column(Item_batch *batch, const Field *field,
+                              T *to, const bool *null, LOAD load)
+{
+  const size_t offset= field->offset(field->table->record[0]);
+  for (uint i= 0, rows= batch->rows(); i < rows; i++)
+    to[i]= null[i] ? T(0) : load(batch->record(i) + offset);
+}
+
+
+bool Item_field::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  const uchar *record0= field->table->record[0];
+  if (field->null_ptr)
+  {
+    const size_t null_offset= field->null_ptr - record0;
+    const uchar null_bit= field->null_bit;
+    for (uint i= 0; i < rows; i++)
+      to->null[i]= batch->record(i)[null_offset] & null_bit;
+  }
+  else
+    memset(to->null, false, rows);
+
+  to->type= cmp_type();
+  to->unsigned_flag= unsigned_flag;
+  const Type_handler *th= field->type_handler();
+  longlong *ival= to->ival;
+  if (th == &type_handler_stiny)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(*(const signed char*) p); });
+  else if (th == &type_handler_utiny)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(*p); });
+  else if (th == &type_handler_sshort)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(sint2korr(p)); });
+  else if (th == &type_handler_ushort)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(uint2korr(p)); });
+  else if (th == &type_handler_sint24)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(sint3korr(p)); });
+  else if (th == &type_handler_uint24)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(uint3korr(p)); });
+  else if (th == &type_handler_slong)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(sint4korr(p)); });
+  else if (th == &type_handler_ulong)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(uint4korr(p)); });
+  else if (th == &type_handler_slonglong || th == &type_handler_ulonglong)
+    batch_load_column(batch, field, ival, to->null, [](const uchar *p)
+                      { return longlong(sint8korr(p)); });
+  else if (th == &type_handler_float)
+    batch_load_column(batch, field, to->rval, to->null, [](const uchar *p)
+                      { float f; float4get(f, p); return double(f); });
+  else if (th == &type_handler_double)
+    batch_load_column(batch, field, to->rval, to->null, [](const uchar *p)
+                      { double d; float8get(d, p); return d; });
+  else
+  {
+    DBUG_ASSERT(th == &type_handler_varchar);
+    const uint length_bytes= ((Field_varstring*) field)->length_bytes;
+    const size_t offset= field->offset(field->table->record[0]);
+    for (uint i= 0; i < rows; i++)
+    {
+      const uchar *p= batch->record(i) + offset;
+      const uint32 length= to->null[i] ? 0 :
+        length_bytes == 1 ? uint32{*p} : uint32{uint2korr(p)};
+      to->sval[i]= p + length_bytes;
+      to->slen[i]= length;
+    }
+  }
+  return false;
+}
+
+
+/*
+  Comparisons
+*/
+
+static inline int batch_cmp_int(longlong a, longlong b)
+{
+  return a < b ? -1 : a == b ? 0 : 1;
+}
+
+static inline int batch_cmp_uint(longlong a, longlong b)
+{
+  return ulonglong(a) < ulonglong(b) ? -1 : a == b ? 0 : 1;
+}
+
+static inline int batch_cmp_int_uint(longlong a, longlong b)
+{
+  return a < 0 || ulonglong(a) < ulonglong(b) ? -1 : a == b ? 0 : 1;
+}
+
+
+/**
+  Compare two INT_RESULT vectors taking the signedness into account,
+  like Longlong_hybrid::cmp().
+*/
+template<typename STORE>
+static void batch_cmp_ints(uint rows, const Item_batch_vec *a,
+                           const Item_batch_vec *b, STORE store)
+{
+  const longlong *x= a->ival, *y= b->ival;
+  if (a->unsigned_flag == b->unsigned_flag)
+  {
+    if (a->unsigned_flag)
+      for (uint i= 0; i < rows; i++)
+        store(i, batch_cmp_uint(x[i], y[i]));
+    else
+      for (uint i= 0; i < rows; i++)
+        store(i, batch_cmp_int(x[i], y[i]));
+  }
+  else if (b->unsigned_flag)
+    for (uint i= 0; i < rows; i++)
+      store(i, batch_cmp_int_uint(x[i], y[i]));
+  else
+    for (uint i= 0; i < rows; i++)
+      store(i, -batch_cmp_int_uint(y[i], x[i]));
+}
+
+
+/**
+  Convert the results of a three way comparison into the value of a
+  comparison predicate.
+*/
+static void batch_cmp_result(Item_func::Functype functype, uint rows,
+                             const bool *null_a, const bool *null_b,
+                             Item_batch_vec *to)
+{
+  longlong *v= to->ival;
+  bool *null= to->null;
+  to->type= INT_RESULT;
+  to->unsigned_flag= false;
+  if (functype == Item_func::EQUAL_FUNC)
+  {
+    for (uint i= 0; i < rows; i++)
+    {
+      v[i]= null_a[i] || null_b[i] ? null_a[i] && null_b[i] : v[i] == 0;
+      null[i]= false;
+    }
+    return;
+  }
+
+  for (uint i= 0; i < rows; i++)
+    null[i]= null_a[i] || null_b[i];
+  switch (functype) {
+  case Item_func::EQ_FUNC:
+    for (uint i= 0; i < rows; i++) v[i]= !null[i] && v[i] == 0;
+    break;
+  case Item_func::NE_FUNC:
+    for (uint i= 0; i < rows; i++) v[i]= !null[i] && v[i] != 0;
+    break;
+  case Item_func::LT_FUNC:
+    for (uint i= 0; i < rows; i++) v[i]= !null[i] && v[i] < 0;
+    break;
+  case Item_func::LE_FUNC:
+    for (uint i= 0; i < rows; i++) v[i]= !null[i] && v[i] <= 0;
+    break;
+  case Item_func::GT_FUNC:
+    for (uint i= 0; i < rows; i++) v[i]= !null[i] && v[i] > 0;
+    break;
+  case Item_func::GE_FUNC:
+    for (uint i= 0; i < rows; i++) v[i]= !null[i] && v[i] >= 0;
+    break;
+  default:
+    DBUG_ASSERT(0);
+  }
+}
+
+
+/**
+  @return whether the arguments of a string comparison are a VARCHAR
+  column of the batch table and a constant, both in the comparison
+  collation
+*/
+static bool batch_string_cmp_args(Item_batch *batch, Item *column,
+                                  Item *value, CHARSET_INFO *cs)
+{
+  return column->type() == Item::FIELD_ITEM && !batch->is_constant(column) &&
+    batch->supported(column) && column->cmp_type() == STRING_RESULT &&
+    batch->is_constant(value) && value->cmp_type() == STRING_RESULT &&
+    column->collation.collation == cs && value->collation.collation == cs;
+}
+
+
+bool Item_bool_rowready_func2::batch_supported(Item_batch *batch)
+{
+  switch (functype()) {
+  case EQ_FUNC: case EQUAL_FUNC: case NE_FUNC:
+  case LT_FUNC: case LE_FUNC: case GE_FUNC: case GT_FUNC:
+    break;
+  default:
+    return false;
+  }
+
+  Item *a= *cmp.a, *b= *cmp.b;
+  const arg_cmp_func func= cmp.func;
+  if (func == &Arg_comparator::compare_string ||
+      func == &Arg_comparator::compare_e_string)
+    return batch_string_cmp_args(batch, a, b, cmp.compare_collation()) ||
+      batch_string_cmp_args(batch, b, a, cmp.compare_collation());
+
+  if (func == &Arg_comparator::compare_int_signed ||
+      func == &Arg_comparator::compare_int_unsigned ||
+      func == &Arg_comparator::compare_int_signed_unsigned ||
+      func == &Arg_comparator::compare_int_unsigned_signed ||
+      func == &Arg_comparator::compare_e_int ||
+      func == &Arg_comparator::compare_e_int_diff_signedness)
+    return batch->supported(a) && batch->supported(b) &&
+      a->cmp_type() == INT_RESULT && b->cmp_type() == INT_RESULT;
+
+  if (func == &Arg_comparator::compare_real ||
+      func == &Arg_comparator::compare_e_real ||
+      func == &Arg_comparator::compare_real_fixed ||
+      func == &Arg_comparator::compare_e_real_fixed)
+    return batch->supported(a) && batch->supported(b) &&
+      a->cmp_type() != STRING_RESULT && b->cmp_type() != STRING_RESULT;
+
+  return false;
+}
+
+
+bool Item_bool_rowready_func2::val_batch(Item_batch *batch,
+                                         Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  const arg_cmp_func func= cmp.func;
+  Item *a= *cmp.a, *b= *cmp.b;
+  longlong *v= to->ival;
+  Item_batch_vec *mark= batch->vec_mark();
+
+  if (func == &Arg_comparator::compare_string ||
+      func == &Arg_comparator::compare_e_string)
+  {
+    const bool column_first= !batch->is_constant(a);
+    Item *column= column_first ? a : b, *value= column_first ? b : a;
+    Item_batch_vec *col= batch->alloc_vec();
+    if (batch->val(column, col))
+    {
+      batch->free_vecs(mark);
+      return true;
+    }
+    StringBuffer<STRING_BUFFER_USUAL_SIZE> buf;
+    const String *str= value->val_str(&buf);
+    /*
+      The constant is NULL for all rows or for none. to->null serves as
+      its NULL vector: batch_cmp_result() reads it before writing it.
+    */
+    memset(to->null, str == NULL, rows);
+    if (str)
+    {
+      CHARSET_INFO *cs= cmp.compare_collation();
+      for (uint i= 0; i < rows; i++)
+      {
+        const int res= cs->strnncollsp((const char*) col->sval[i],
+                                       col->slen[i],
+                                       str->ptr(), str->length());
+        v[i]= column_first ? res : -res;
+      }
+    }
+    else
+      memset(v, 0, rows * sizeof *v);
+    batch_cmp_result(functype(), rows, col->null, to->null, to);
+    batch->free_vecs(mark);
+    return false;
+  }
+
+  Item_batch_vec *va= batch->alloc_vec(), *vb= batch->alloc_vec();
+  const bool real= func != &Arg_comparator::compare_int_signed &&
+    func != &Arg_comparator::compare_int_unsigned &&
+    func != &Arg_comparator::compare_int_signed_unsigned &&
+    func != &Arg_comparator::compare_int_unsigned_signed &&
+    func != &Arg_comparator::compare_e_int &&
+    func != &Arg_comparator::compare_e_int_diff_signedness;
+  if (real
+      ? batch->val_real(a, va) || batch->val_real(b, vb)
+      : batch->val(a, va) || batch->val(b, vb))
+  {
+    batch->free_vecs(mark);
+    return true;
+  }
+
+  if (!real)
+    batch_cmp_ints(rows, va, vb, [v](uint i, int res) { v[i]= res; });
+  else if (func == &Arg_comparator::compare_real_fixed ||
+           func == &Arg_comparator::compare_e_real_fixed)
+  {
+    const double precision= cmp.precision;
+    for (uint i= 0; i < rows; i++)
+    {
+      const double x= va->rval[i], y= vb->rval[i];
+      v[i]= x == y || fabs(x - y) < precision ? 0 : x < y ? -1 : 1;
+    }
+  }
+  else
+    for (uint i= 0; i < rows; i++)
+    {
+      const double x= va->rval[i], y= vb->rval[i];
+      v[i]= x < y ? -1 : x == y ? 0 : 1;
+    }
+
+  batch_cmp_result(functype(), rows, va->null, vb->null, to);
+  batch->free_vecs(mark);
+  return false;
+}
+
+
+bool Item_func_between::batch_supported(Item_batch *batch)
+{
+  const Item_result type= m_comparator.cmp_type();
+  if (type != INT_RESULT && type != REAL_RESULT)
+    return false;
+  for (uint i= 0; i < 3; i++)
+    if (!batch->supported(args[i]) ||
+        args[i]->cmp_type() == STRING_RESULT ||
+        (type == INT_RESULT && args[i]->cmp_type() != INT_RESULT))
+      return false;
+  return true;
+}
+
+
+bool Item_func_between::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  const bool real= m_comparator.cmp_type() == REAL_RESULT;
+  Item_batch_vec *mark= batch->vec_mark();
+  Item_batch_vec *v[3];
+  for (uint i= 0; i < 3; i++)
+  {
+    v[i]= batch->alloc_vec();
+    if (real ? batch->val_real(args[i], v[i]) : batch->val(args[i], v[i]))
+    {
+      batch->free_vecs(mark);
+      return true;
+    }
+  }
+
+  /* v[1]->ival and v[2]->ival become the results of value<=>min, value<=>max */
+  if (real)
+    for (uint j= 1; j < 3; j++)
+      for (uint i= 0; i < rows; i++)
+      {
+        const double x= v[0]->rval[i], y= v[j]->rval[i];
+        v[j]->ival[i]= x < y ? -1 : x == y ? 0 : 1;
+      }
+  else
+    for (uint j= 1; j < 3; j++)
+    {
+      longlong *res= v[j]->ival;
+      batch_cmp_ints(rows, v[0], v[j], [res](uint i, int c) { res[i]= c; });
+    }
+
+  const longlong *ge_min= v[1]->ival, *le_max= v[2]->ival;
+  const bool *null0= v[0]->null, *null1= v[1]->null, *null2= v[2]->null;
+  to->type= INT_RESULT;
+  to->unsigned_flag= false;
+  for (uint i= 0; i < rows; i++)
+  {
+    bool null;
+    if (null0[i])
+      null= true;
+    else if (!null1[i] && !null2[i])
+    {
+      to->ival[i]= (ge_min[i] >= 0 && le_max[i] <= 0) != negated;
+      to->null[i]= false;
+      continue;
+    }
+    else if (null1[i] && null2[i])
+      null= true;
+    else if (null1[i])
+      null= le_max[i] <= 0;                     // not null if false range.
+    else
+      null= ge_min[i] >= 0;
+    to->null[i]= null;
+    to->ival[i]= !null0[i] && !null && negated;
+  }
+  batch->free_vecs(mark);
+  return false;
+}
+
+
+/*
+  Boolean connectives
+*/
+
+bool Item_func_not::batch_supported(Item_batch *batch)
+{
+  return batch->supported(args[0]) && args[0]->cmp_type() != STRING_RESULT;
+}
+
+
+bool Item_func_not::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  if (batch->val_bool(args[0], to))
+    return true;
+  for (uint i= 0, rows= batch->rows(); i < rows; i++)
+    to->ival[i]= !to->null[i] && !to->ival[i];
+  return false;
+}
+
+
+bool Item_func_null_predicate::batch_supported(Item_batch *batch)
+{
+  return (functype() == ISNULL_FUNC || functype() == ISNOTNULL_FUNC) &&
+    batch->supported(args[0]);
+}
+
+
+bool Item_func_null_predicate::val_batch(Item_batch *batch,
+                                         Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  to->type= INT_RESULT;
+  to->unsigned_flag= false;
+  memset(to->null, false, rows);
+  if (functype() == ISNULL_FUNC && const_item() && !args[0]->maybe_null())
+  {
+    memset(to->ival, 0, rows * sizeof *to->ival);
+    return false;
+  }
+  Item_batch_vec *arg= batch->alloc_vec();
+  if (batch->val(args[0], arg))
+  {
+    batch->free_vecs(arg);
+    return true;
+  }
+  const bool want_null= functype() == ISNULL_FUNC;
+  for (uint i= 0; i < rows; i++)
+    to->ival[i]= arg->null[i] == want_null;
+  batch->free_vecs(arg);
+  return false;
+}
+
+
+bool Item_cond::batch_supported(Item_batch *batch)
+{
+  if (functype() != COND_AND_FUNC && functype() != COND_OR_FUNC)
+    return false;
+  List_iterator_fast<Item> li(list);
+  Item *item;
+  while ((item= li++))
+    if (!batch->supported(item) || item->cmp_type() == STRING_RESULT)
+      return false;
+  return true;
+}
+
+
+bool Item_cond::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  const bool is_and= functype() == COND_AND_FUNC;
+  /*
+    to->ival[i] is whether no argument was FALSE (AND) or whether some
+    argument was TRUE (OR); to->null[i] is whether some argument was NULL.
+  */
+  for (uint i= 0; i < rows; i++)
+  {
+    to->ival[i]= is_and;
+    to->null[i]= false;
+  }
+  to->type= INT_RESULT;
+  to->unsigned_flag= false;
+
+  List_iterator_fast<Item> li(list);
+  Item *item;
+  Item_batch_vec *arg= batch->alloc_vec();
+  while ((item= li++))
+  {
+    if (batch->val_bool(item, arg))
+    {
+      batch->free_vecs(arg);
+      return true;
+    }
+    for (uint i= 0; i < rows; i++)
+    {
+      if (arg->null[i])
+        to->null[i]= true;
+      else if (arg->ival[i] != is_and)
+        to->ival[i]= !is_and;
+    }
+  }
+  batch->free_vecs(arg);
+
+  /* FALSE AND NULL is FALSE, TRUE OR NULL is TRUE */
+  for (uint i= 0; i < rows; i++)
+  {
+    if (to->ival[i] != is_and)
+      to->null[i]= false;
+    else if (to->null[i])
+      to->ival[i]= false;
+  }
+  return false;
+}
+
+
+/*
+  Arithmetic. BIGINT arithmetic is only done when the arguments and the
+  result are all signed; any overflow makes the batch fall back to row by
+  row evaluation, which raises the error.
+*/
+
+static bool batch_num_op_supported(Item_batch *batch, Item_func *func)
+{
+  const Item_result type= func->cmp_type();
+  if (type == INT_RESULT)
+  {
+    if (func->unsigned_flag)
+      return false;
+    for (uint i= 0; i < func->argument_count(); i++)
+    {
+      Item *arg= func->arguments()[i];
+      if (!batch->supported(arg) || arg->cmp_type() != INT_RESULT ||
+          arg->unsigned_flag)
+        return false;
+    }
+    return true;
+  }
+  if (type == REAL_RESULT)
+  {
+    for (uint i= 0; i < func->argument_count(); i++)
+    {
+      Item *arg= func->arguments()[i];
+      if (!batch->supported(arg) || arg->cmp_type() == STRING_RESULT)
+        return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+template<typename INT_OP, typename REAL_OP>
+static bool batch_num_op(Item_batch *batch, Item_func *func,
+                         Item_batch_vec *to, INT_OP int_op, REAL_OP real_op)
+{
+  const uint rows= batch->rows();
+  const bool real= func->cmp_type() == REAL_RESULT;
+  Item **args= func->arguments();
+  Item_batch_vec *mark= batch->vec_mark();
+  Item_batch_vec *a= batch->alloc_vec(), *b= batch->alloc_vec();
+  if (real
+      ? batch->val_real(args[0], a) || batch->val_real(args[1], b)
+      : batch->val(args[0], a) || batch->val(args[1], b))
+  {
+    batch->free_vecs(mark);
+    return true;
+  }
+
+  bool overflow= false;
+  for (uint i= 0; i < rows; i++)
+    to->null[i]= a->null[i] || b->null[i];
+  if (real)
+    for (uint i= 0; i < rows; i++)
+    {
+      const double res= real_op(a->rval[i], b->rval[i]);
+      overflow|= !to->null[i] && !std::isfinite(res);
+      to->rval[i]= to->null[i] ? 0.0 : res;
+    }
+  else
+    for (uint i= 0; i < rows; i++)
+    {
+      longlong res;
+      overflow|= int_op(a->ival[i], b->ival[i], &res) && !to->null[i];
+      to->ival[i]= to->null[i] ? 0 : res;
+    }
+  to->type= real ? REAL_RESULT : INT_RESULT;
+  to->unsigned_flag= false;
+  batch->free_vecs(mark);
+  return overflow;
+}
+
+
+bool Item_func_plus::batch_supported(Item_batch *batch)
+{
+  return batch_num_op_supported(batch, this);
+}
+
+
+bool Item_func_plus::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  return batch_num_op(batch, this, to,
+                      [](longlong x, longlong y, longlong *res)
+                      { return __builtin_add_overflow(x, y, res); },
+                      [](double x, double y) { return x + y; });
+}
+
+
+bool Item_func_minus::batch_supported(Item_batch *batch)
+{
+  return batch_num_op_supported(batch, this);
+}
+
+
+bool Item_func_minus::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  return batch_num_op(batch, this, to,
+                      [](longlong x, longlong y, longlong *res)
+                      { return __builtin_sub_overflow(x, y, res); },
+                      [](double x, double y) { return x - y; });
+}
+
+
+bool Item_func_mul::batch_supported(Item_batch *batch)
+{
+  return batch_num_op_supported(batch, this);
+}
+
+
+bool Item_func_mul::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  return batch_num_op(batch, this, to,
+                      [](longlong x, longlong y, longlong *res)
+                      { return __builtin_mul_overflow(x, y, res); },
+                      [](double x, double y) { return x * y; });
+}
+
+
+bool Item_func_neg::batch_supported(Item_batch *batch)
+{
+  return batch_num_op_supported(batch, this);
+}
+
+
+bool Item_func_neg::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  if (Item::cmp_type() == REAL_RESULT)
+  {
+    if (batch->val_real(args[0], to))
+      return true;
+    for (uint i= 0; i < rows; i++)
+      to->rval[i]= -to->rval[i];
+    return false;
+  }
+  if (batch->val(args[0], to))
+    return true;
+  bool overflow= false;
+  for (uint i= 0; i < rows; i++)
+  {
+    overflow|= to->ival[i] == LONGLONG_MIN && !to->null[i];
+    to->ival[i]= to->ival[i] == LONGLONG_MIN ? 0 : -to->ival[i];
+  }
+  return overflow;
+}
+
+
+/*
+  String functions
+*/
+
+static bool batch_string_column_supported(Item_batch *batch, Item *arg)
+{
+  return arg->type() == Item::FIELD_ITEM && !batch->is_constant(arg) &&
+    batch->supported(arg) && arg->cmp_type() == STRING_RESULT;
+}
+
+
+bool Item_func_octet_length::batch_supported(Item_batch *batch)
+{
+  return batch_string_column_supported(batch, args[0]);
+}
+
+
+bool Item_func_octet_length::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  Item_batch_vec *arg= batch->alloc_vec();
+  if (batch->val(args[0], arg))
+  {
+    batch->free_vecs(arg);
+    return true;
+  }
+  for (uint i= 0; i < rows; i++)
+  {
+    to->ival[i]= arg->slen[i];
+    to->null[i]= arg->null[i];
+  }
+  to->type= INT_RESULT;
+  to->unsigned_flag= unsigned_flag;
+  batch->free_vecs(arg);
+  return false;
+}
+
+
+bool Item_func_char_length::batch_supported(Item_batch *batch)
+{
+  return batch_string_column_supported(batch, args[0]);
+}
+
+
+bool Item_func_char_length::val_batch(Item_batch *batch, Item_batch_vec *to)
+{
+  const uint rows= batch->rows();
+  Item_batch_vec *arg= batch->alloc_vec();
+  if (batch->val(args[0], arg))
+  {
+    batch->free_vecs(arg);
+    return true;
+  }
+  CHARSET_INFO *cs= args[0]->collation.collation;
+  for (uint i= 0; i < rows; i++)
+  {
+    const char *s= (const char*) arg->sval[i];
+    to->ival[i]= arg->null[i] ? 0 : longlong(cs->numchars(s, s + arg->slen[i]));
+    to->null[i]= arg->null[i];
+  }
+  to->type= INT_RESULT;
+  to->unsigned_flag= unsigned_flag;
+  batch->free_vecs(arg);
+  return false;
+}
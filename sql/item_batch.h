@@ -0,0 +1,217 @@
+#ifndef ITEM_BATCH_INCLUDED
+#define ITEM_BATCH_INCLUDED
+
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+/**
+  @file
+
+  Batch (vectorized) evaluation of conditions.
+
+  The caller reads a number of rows of one table ahead and copies their
+  record images into an Item_batch. The condition is then evaluated for
+  all of them at once: every item that supports batch evaluation
+  computes a column vector (Item_batch_vec) from the vectors of its
+  arguments, so that the per-row cost is a tight loop instead of a chain
+  of virtual val_int()/val_real() calls.
+
+  Items opt in by overriding Item::batch_supported() and
+  Item::val_batch(). Items that do not depend on the batch table
+  (literals, caches, fields of other tables) are evaluated once per
+  batch and broadcast.
+
+  Only the top level conjuncts of a condition that support batch
+  evaluation are evaluated in batch; the others form the residual
+  condition that the caller evaluates row by row for the rows that
+  passed.
+
+  The values of further items, such as sort keys, can be computed
+  together with the condition; see value().
+*/
+
+#include "sql_alloc.h"
+
+class Item;
+struct TABLE;
+
+/** A column of values, one for each row of the batch */
+class Item_batch_vec
+{
+public:
+  /** INT_RESULT, REAL_RESULT or STRING_RESULT */
+  Item_result type;
+  bool unsigned_flag;
+  union
+  {
+    longlong *ival;
+    double *rval;
+    const uchar **sval;
+  };
+  /** Byte length of the sval strings */
+  uint32 *slen;
+  bool *null;
+};
+
+
+class Item_batch: public Sql_alloc
+{
+public:
+  /** Upper limit for the memory used by the record images */
+  static constexpr size_t MAX_BUFFER= 64 * 1024;
+  /** Maximum number of rows in a batch */
+  static constexpr uint MAX_ROWS= 128;
+  /** Batches of fewer rows are not worth the copying */
+  static constexpr uint MIN_ROWS= 16;
+
+  Item_batch() : m_table(NULL), m_cond(NULL), m_conds(NULL),
+    m_n_conds(0), m_n_batch_conds(0),
+    m_values(NULL), m_value_vecs(NULL), m_n_values(0), m_values_valid(false),
+    m_buffer(NULL), m_records(NULL), m_refs(NULL), m_result(NULL),
+    m_vecs(NULL), m_n_vecs(0), m_used_vecs(0), m_max_rows(0), m_rows(0),
+    m_reclength(0), m_ref_length(0)
+  {}
+  ~Item_batch();
+
+  /**
+    Prepare batch evaluation of a condition on rows of a table.
+    @param table       the table whose rows are read ahead
+    @param cond        the condition
+    @param ref_length  length of the row references to keep with
+                       each row, or 0
+    @param values      items whose values to compute in batch for value(),
+                       or NULL entries
+    @param n_values    number of elements in values[]
+    @return whether batch evaluation cannot be used for cond
+  */
+  bool init(TABLE *table, Item *cond, uint ref_length,
+            Item **values= NULL, uint n_values= 0);
+
+  /** @return the condition that init() was called for */
+  Item *cond() const { return m_cond; }
+  /**
+    Evaluate the part of cond() that is not evaluated in batch for the
+    row in table->record[0].
+  */
+  bool val_residual();
+  TABLE *table() const { return m_table; }
+
+  void clear() { m_rows= 0; }
+  uint rows() const { return m_rows; }
+  bool is_full() const { return m_rows == m_max_rows; }
+
+  /**
+    Append the row in table->record[0] to the batch.
+    @param ref  the reference to the row (of the length passed to init())
+  */
+  void add_row(const uchar *ref= NULL);
+
+  /** Copy a row of the batch back to table->record[0] */
+  void restore_row(uint row);
+
+  uchar *ref(uint row) const { return m_refs + row * size_t{m_ref_length}; }
+
+  /**
+    Evaluate the batch evaluated part of the condition for all rows.
+    @return whether the rows must be evaluated one by one instead
+  */
+  bool evaluate();
+
+  /** @return the result of evaluate() for a row */
+  bool result(uint row) const { return m_result[row]; }
+
+  /**
+    @return the values that evaluate() computed for the rows of the batch
+    @retval NULL if the value of values[i] passed to init() must be
+    computed row by row
+  */
+  const Item_batch_vec *value(uint i) const
+  {
+    DBUG_ASSERT(i < m_n_values);
+    return m_values_valid && m_values[i] ? &m_value_vecs[i] : NULL;
+  }
+
+  /* Interface for Item::batch_supported() and Item::val_batch() */
+
+  /** @return the record image of a row */
+  const uchar *record(uint row) const
+  { return m_records + row * size_t{m_reclength}; }
+
+  /** Check whether the value of an item can be computed in batch */
+  bool supported(Item *item);
+  /** Whether the item is computed once and broadcast to all rows */
+  bool is_constant(Item *item) const;
+  /**
+    Compute the value of an argument.
+    @param item  the item, for which supported() returned true
+    @param to    the vector for the result
+    @return whether the batch must be evaluated row by row instead
+  */
+  bool val(Item *item, Item_batch_vec *to);
+  /**
+    Compute the value of an argument, converting it to a REAL_RESULT
+    vector if it is not one already.
+  */
+  bool val_real(Item *item, Item_batch_vec *to);
+  /** Compute the truth values of a boolean argument */
+  bool val_bool(Item *item, Item_batch_vec *to);
+
+  /** Allocate a vector for the value of an argument */
+  Item_batch_vec *alloc_vec()
+  {
+    DBUG_ASSERT(m_used_vecs < m_n_vecs);
+    return &m_vecs[m_used_vecs++];
+  }
+  /** Release the vectors allocated after vec */
+  void free_vecs(Item_batch_vec *vec)
+  {
+    DBUG_ASSERT(vec >= m_vecs && vec <= m_vecs + m_used_vecs);
+    m_used_vecs= uint(vec - m_vecs);
+  }
+  /** @return the position to pass to free_vecs() */
+  Item_batch_vec *vec_mark() { return m_vecs + m_used_vecs; }
+
+private:
+  TABLE *m_table;
+  Item *m_cond;
+  /**
+    The top level conjuncts of m_cond, the m_n_batch_conds ones that are
+    evaluated in batch first
+  */
+  Item **m_conds;
+  uint m_n_conds;
+  uint m_n_batch_conds;
+  /** the items whose values are computed in batch, or NULL entries */
+  Item **m_values;
+  /** the values of m_values[] */
+  Item_batch_vec *m_value_vecs;
+  uint m_n_values;
+  /** whether the last evaluate() computed m_value_vecs[] */
+  bool m_values_valid;
+  /** memory for all of the below, allocated with my_malloc() */
+  uchar *m_buffer;
+  uchar *m_records;
+  uchar *m_refs;
+  bool *m_result;
+  Item_batch_vec *m_vecs;
+  uint m_n_vecs;
+  uint m_used_vecs;
+  uint m_max_rows;
+  uint m_rows;
+  uint m_reclength;
+  uint m_ref_length;
+};
+
+#endif /* ITEM_BATCH_INCLUDED */
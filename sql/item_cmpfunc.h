@@ -597,6 +597,8 @@ class Item_bool_rowready_func2 :public Item_bool_func2_with_rev
     Item_func::print_op(str, query_type);
   }
   enum precedence precedence() const override { return CMP_PRECEDENCE; }
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   Item *neg_transformer(THD *thd) override;
   virtual Item *negated_item(THD *thd);
   Item *propagate_equal_fields(THD *thd, const Context &ctx, COND_EQUAL *cond)
@@ -689,6 +691,8 @@ class Item_func_not :public Item_bool_func
 public:
   Item_func_not(THD *thd, Item *a): Item_bool_func(thd, a) {}
   bool val_bool() override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   enum Functype functype() const override { return NOT_FUNC; }
   LEX_CSTRING func_name_cstring() const override
   {
@@ -1081,6 +1085,8 @@ class Item_func_between :public Item_func_opt_neg
                       uint *and_level, table_map usable_tables,
                       SARGABLE_PARAM **sargables) override;
   SEL_TREE *get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   Item* propagate_equal_fields(THD *thd, const Context &ctx, COND_EQUAL *cond)
     override
   {
@@ -2799,6 +2805,8 @@ class Item_func_null_predicate :public Item_bool_func
     return FALSE;
   }
   bool count_sargable_conds(void *arg) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
 
   Item* vcol_subst_transformer(THD *thd, uchar *arg) override;
 };
@@ -3274,6 +3282,8 @@ class Item_cond :public Item_bool_func
                       uint *and_level, table_map usable_tables,
                       SARGABLE_PARAM **sargables) override;
   SEL_TREE *get_mm_tree(RANGE_OPT_PARAM *param, Item **cond_ptr) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   void print(String *str, enum_query_type query_type) override;
   void split_sum_func(THD *thd, Ref_ptr_array ref_pointer_array,
                       List<Item> &fields, uint flags) override;
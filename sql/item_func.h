@@ -1661,6 +1661,8 @@ class Item_func_plus :public Item_func_additive_op
   longlong int_op() override;
   double real_op() override;
   my_decimal *decimal_op(my_decimal *) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   Item *do_get_copy(THD *thd) const override
   { return get_item_copy<Item_func_plus>(thd, this); }
 };
@@ -1683,6 +1685,8 @@ class Item_func_minus :public Item_func_additive_op
   longlong int_op() override;
   double real_op() override;
   my_decimal *decimal_op(my_decimal *) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   bool fix_length_and_dec(THD *thd) override;
   void fix_unsigned_flag();
   void fix_length_and_dec_double()
@@ -1719,6 +1723,8 @@ class Item_func_mul :public Item_num_op
   longlong int_op() override;
   double real_op() override;
   my_decimal *decimal_op(my_decimal *) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   void result_precision() override;
   bool fix_length_and_dec(THD *thd) override;
   bool check_partition_func_processor(void *int_arg) override {return FALSE;}
@@ -1824,6 +1830,8 @@ class Item_func_neg :public Item_func_num1
   double real_op() override;
   longlong int_op() override;
   my_decimal *decimal_op(my_decimal *) override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   LEX_CSTRING func_name_cstring() const override
   {
     static LEX_CSTRING name= {STRING_WITH_LEN("-") };
@@ -2517,6 +2525,8 @@ class Item_func_octet_length :public Item_long_func_length
 public:
   Item_func_octet_length(THD *thd, Item *a): Item_long_func_length(thd, a) {}
   longlong val_int() override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   LEX_CSTRING func_name_cstring() const override
   {
     static LEX_CSTRING name= {STRING_WITH_LEN("octet_length") };
@@ -2552,6 +2562,8 @@ class Item_func_char_length :public Item_long_func_length
 public:
   Item_func_char_length(THD *thd, Item *a): Item_long_func_length(thd, a) {}
   longlong val_int() override;
+  bool batch_supported(Item_batch *batch) override;
+  bool val_batch(Item_batch *batch, Item_batch_vec *to) override;
   LEX_CSTRING func_name_cstring() const override
   {
     static LEX_CSTRING name= {STRING_WITH_LEN("char_length") };
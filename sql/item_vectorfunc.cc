@@ -23,7 +23,176 @@
 #include "item_vectorfunc.h"
 #include "vector_mhnsw.h"
 #include "sql_type_vector.h"
+#include "bloom_filters.h"
 
+/*
+  Distance kernels for VEC_DISTANCE_*() on arbitrary (not indexed) vectors.
+
+  Like FVector::dot_product() in vector_mhnsw.cc these use gcc function
+  multiversioning, the best implementation is picked once, on the first call,
+  based on the CPU capabilities. Squares and products are calculated in float,
+  as in the generic version, but summed up in double to avoid losing
+  precision on long vectors.
+*/
+#ifdef AVX2_IMPLEMENTATION
+AVX2_IMPLEMENTATION
+static inline __m256d add_float8_to_double4(__m256d sum, __m256 v)
+{
+  sum= _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+  return _mm256_add_pd(sum, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+}
+
+AVX2_IMPLEMENTATION
+static inline double reduce_double4(__m256d v)
+{
+  __m128d s= _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+AVX2_IMPLEMENTATION
+static double calc_distance_euclidean(float *v1, float *v2, size_t v_len)
+{
+  __m256d d= _mm256_setzero_pd();
+  size_t i= 0;
+  for (; i + 8 <= v_len; i+= 8)
+  {
+    __m256 dist= _mm256_sub_ps(_mm256_loadu_ps(v1 + i), _mm256_loadu_ps(v2 + i));
+    d= add_float8_to_double4(d, _mm256_mul_ps(dist, dist));
+  }
+  double r= reduce_double4(d);
+  for (; i < v_len; i++)
+  {
+    float dist= v1[i] - v2[i];
+    r+= dist * dist;
+  }
+  return sqrt(r);
+}
+
+AVX2_IMPLEMENTATION
+static double calc_distance_cosine(float *v1, float *v2, size_t v_len)
+{
+  __m256d dotp= _mm256_setzero_pd(), abs1= dotp, abs2= dotp;
+  size_t i= 0;
+  for (; i + 8 <= v_len; i+= 8)
+  {
+    __m256 f1= _mm256_loadu_ps(v1 + i), f2= _mm256_loadu_ps(v2 + i);
+    abs1= add_float8_to_double4(abs1, _mm256_mul_ps(f1, f1));
+    abs2= add_float8_to_double4(abs2, _mm256_mul_ps(f2, f2));
+    dotp= add_float8_to_double4(dotp, _mm256_mul_ps(f1, f2));
+  }
+  double d= reduce_double4(dotp), a1= reduce_double4(abs1),
+         a2= reduce_double4(abs2);
+  for (; i < v_len; i++)
+  {
+    a1+= v1[i] * v1[i];
+    a2+= v2[i] * v2[i];
+    d+= v1[i] * v2[i];
+  }
+  return 1 - d/sqrt(a1*a2);
+}
+#endif
+
+#ifdef AVX512_IMPLEMENTATION
+AVX512_IMPLEMENTATION
+static inline __m512d add_float16_to_double8(__m512d sum, __m512 v)
+{
+  __m256 hi= _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1));
+  sum= _mm512_add_pd(sum, _mm512_cvtps_pd(_mm512_castps512_ps256(v)));
+  return _mm512_add_pd(sum, _mm512_cvtps_pd(hi));
+}
+
+AVX512_IMPLEMENTATION
+static double calc_distance_euclidean(float *v1, float *v2, size_t v_len)
+{
+  __m512d d= _mm512_setzero_pd();
+  size_t i= 0;
+  for (; i + 16 <= v_len; i+= 16)
+  {
+    __m512 dist= _mm512_sub_ps(_mm512_loadu_ps(v1 + i), _mm512_loadu_ps(v2 + i));
+    d= add_float16_to_double8(d, _mm512_mul_ps(dist, dist));
+  }
+  double r= _mm512_reduce_add_pd(d);
+  for (; i < v_len; i++)
+  {
+    float dist= v1[i] - v2[i];
+    r+= dist * dist;
+  }
+  return sqrt(r);
+}
+
+AVX512_IMPLEMENTATION
+static double calc_distance_cosine(float *v1, float *v2, size_t v_len)
+{
+  __m512d dotp= _mm512_setzero_pd(), abs1= dotp, abs2= dotp;
+  size_t i= 0;
+  for (; i + 16 <= v_len; i+= 16)
+  {
+    __m512 f1= _mm512_loadu_ps(v1 + i), f2= _mm512_loadu_ps(v2 + i);
+    abs1= add_float16_to_double8(abs1, _mm512_mul_ps(f1, f1));
+    abs2= add_float16_to_double8(abs2, _mm512_mul_ps(f2, f2));
+    dotp= add_float16_to_double8(dotp, _mm512_mul_ps(f1, f2));
+  }
+  double d= _mm512_reduce_add_pd(dotp), a1= _mm512_reduce_add_pd(abs1),
+         a2= _mm512_reduce_add_pd(abs2);
+  for (; i < v_len; i++)
+  {
+    a1+= v1[i] * v1[i];
+    a2+= v2[i] * v2[i];
+    d+= v1[i] * v2[i];
+  }
+  return 1 - d/sqrt(a1*a2);
+}
+#endif
+
+#ifdef NEON_IMPLEMENTATION
+static inline float64x2_t add_float4_to_double2(float64x2_t sum, float32x4_t v)
+{
+  sum= vaddq_f64(sum, vcvt_f64_f32(vget_low_f32(v)));
+  return vaddq_f64(sum, vcvt_high_f64_f32(v));
+}
+
+static double calc_distance_euclidean(float *v1, float *v2, size_t v_len)
+{
+  float64x2_t d= vdupq_n_f64(0);
+  size_t i= 0;
+  for (; i + 4 <= v_len; i+= 4)
+  {
+    float32x4_t dist= vsubq_f32(vld1q_f32(v1 + i), vld1q_f32(v2 + i));
+    d= add_float4_to_double2(d, vmulq_f32(dist, dist));
+  }
+  double r= vaddvq_f64(d);
+  for (; i < v_len; i++)
+  {
+    float dist= v1[i] - v2[i];
+    r+= dist * dist;
+  }
+  return sqrt(r);
+}
+
+static double calc_distance_cosine(float *v1, float *v2, size_t v_len)
+{
+  float64x2_t dotp= vdupq_n_f64(0), abs1= dotp, abs2= dotp;
+  size_t i= 0;
+  for (; i + 4 <= v_len; i+= 4)
+  {
+    float32x4_t f1= vld1q_f32(v1 + i), f2= vld1q_f32(v2 + i);
+    abs1= add_float4_to_double2(abs1, vmulq_f32(f1, f1));
+    abs2= add_float4_to_double2(abs2, vmulq_f32(f2, f2));
+    dotp= add_float4_to_double2(dotp, vmulq_f32(f1, f2));
+  }
+  double d= vaddvq_f64(dotp), a1= vaddvq_f64(abs1), a2= vaddvq_f64(abs2);
+  for (; i < v_len; i++)
+  {
+    a1+= v1[i] * v1[i];
+    a2+= v2[i] * v2[i];
+    d+= v1[i] * v2[i];
+  }
+  return 1 - d/sqrt(a1*a2);
+}
+#endif
+
+#ifdef DEFAULT_IMPLEMENTATION
+DEFAULT_IMPLEMENTATION
 static double calc_distance_euclidean(float *v1, float *v2, size_t v_len)
 {
   double d= 0;
@@ -35,6 +204,7 @@ static double calc_distance_euclidean(float *v1, float *v2, size_t v_len)
   return sqrt(d);
 }
 
+DEFAULT_IMPLEMENTATION
 static double calc_distance_cosine(float *v1, float *v2, size_t v_len)
 {
   double dotp=0, abs1=0, abs2=0;
@@ -47,6 +217,7 @@ static double calc_distance_cosine(float *v1, float *v2, size_t v_len)
   }
   return 1 - dotp/sqrt(abs1*abs2);
 }
+#endif
 
 Item_func_vec_distance::Item_func_vec_distance(THD *thd, Item *a, Item *b,
                                                distance_kind kind)
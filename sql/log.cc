@@ -520,6 +520,20 @@ class binlog_cache_mngr {
     return (is_transactional ? &trx_cache.cache_log : &stmt_cache.cache_log);
   }
 
+  /*
+    Return the writeset of the event group written from the caches, or NULL
+    if its conflicts cannot be determined from the keys of its rows.
+  */
+  const Binlog_writeset *get_writeset(THD *thd, bool using_stmt,
+                                      bool using_trx)
+  {
+    if (!using_trx || (using_stmt && !stmt_cache.empty()) ||
+        trx_cache.has_critical_events() ||
+        thd->transaction->xid_state.is_explicit_XA())
+      return NULL;
+    return &trx_cache.writeset;
+  }
+
   binlog_cache_data stmt_cache;
 
   binlog_cache_data trx_cache;
@@ -3735,6 +3749,7 @@ void MYSQL_BIN_LOG::cleanup()
     mysql_mutex_destroy(&LOCK_index);
     mysql_mutex_destroy(&LOCK_xid_list);
     mysql_mutex_destroy(&LOCK_binlog_background_thread);
+    mysql_mutex_destroy(&LOCK_binlog_sync);
     mysql_mutex_destroy(&LOCK_binlog_end_pos);
     mysql_cond_destroy(&COND_relay_log_updated);
     mysql_cond_destroy(&COND_bin_log_updated);
@@ -3762,6 +3777,8 @@ void MYSQL_BIN_LOG::init_pthread_objects()
   mysql_mutex_setflags(&LOCK_index, MYF_NO_DEADLOCK_DETECTION);
   mysql_mutex_init(key_BINLOG_LOCK_xid_list,
                    &LOCK_xid_list, MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_BINLOG_LOCK_binlog_sync,
+                   &LOCK_binlog_sync, MY_MUTEX_INIT_SLOW);
   mysql_cond_init(m_key_relay_log_update, &COND_relay_log_updated, 0);
   mysql_cond_init(m_key_bin_log_update, &COND_bin_log_updated, 0);
   mysql_cond_init(m_key_COND_queue_busy, &COND_queue_busy, 0);
@@ -4097,6 +4114,7 @@ bool MYSQL_BIN_LOG::open(const char *log_name,
         Gtid_list_log_event gl_ev(&rpl_global_gtid_binlog_state, 0);
         if (write_event(&gl_ev))
           goto err;
+        Gtid_index_start_states::set(log_file_name, gl_ev.list, gl_ev.count);
 
         /* Open an index file for this binlog file. */
         DBUG_ASSERT(!gtid_index); /* Binlog close should clear it. */
@@ -4640,7 +4658,8 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
       the effect to ensure that any on-going group commit (in
       trx_group_commit_leader()) has completed before we request the checkpoint,
       due to the chaining of LOCK_log and LOCK_commit_ordered in that function.
-      (We are holding LOCK_log, so no new group commit can start).
+      (We are holding LOCK_log, so no new group commit can start, but one
+      may still be in the sync stage).
 
       Without this, it is possible (though perhaps unlikely) that the RESET
       MASTER could run in-between the write to the binlog and the
@@ -4648,6 +4667,7 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
       later would leave such transaction not recoverable.
     */
 
+    wait_for_binlog_sync();
     mysql_mutex_lock(&LOCK_after_binlog_sync);
     mysql_mutex_lock(&LOCK_commit_ordered);
     mysql_mutex_unlock(&LOCK_after_binlog_sync);
@@ -4724,6 +4744,10 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
     goto err;
   }
 
+  /* The names of the binlog files will be reused. */
+  if (!is_relay_log)
+    Gtid_index_start_states::remove_all();
+
   for (;;)
   {
     /* Delete any GTID index file. */
@@ -5293,6 +5317,8 @@ int MYSQL_BIN_LOG::purge_index_entry(THD *thd, ulonglong *reclaimed_space,
     /* Get rid of the trailing '\n' */
     log_info.log_file_name[length-1]= 0;
 
+    if (!is_relay_log)
+      Gtid_index_start_states::remove(log_info.log_file_name);
     Gtid_index_base::make_gtid_index_file_name(buf, sizeof(buf),
                                                log_info.log_file_name);
     if (my_delete(buf, MYF(0)))
@@ -5928,6 +5954,7 @@ int MYSQL_BIN_LOG::new_file_impl(bool commit_by_rotate)
 
   DBUG_ASSERT(log_type == LOG_BIN);
   mysql_mutex_assert_owner(&LOCK_log);
+  wait_for_binlog_sync();
 
   if (!is_open())
   {
@@ -6212,24 +6239,40 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
 
 bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
 {
-  int err=0, fd=log_file.file;
+  int err=0;
   if (synced)
     *synced= 0;
   mysql_mutex_assert_owner(&LOCK_log);
+  /*
+    The caller will make what it writes visible; a group commit that
+    is still in the sync stage must come first.
+  */
+  wait_for_binlog_sync();
   if (flush_io_cache(&log_file))
     return 1;
   uint sync_period= get_sync_period();
   if (sync_period && ++sync_counter >= sync_period)
   {
     sync_counter= 0;
-    err= mysql_file_sync(fd, MYF(MY_WME));
+    err= sync_log_file();
     if (synced)
       *synced= 1;
+  }
+  return err;
+}
+
+
+/**
+  fsync() the binlog file. Called with LOCK_log or LOCK_binlog_sync held,
+  so that the file cannot be closed meanwhile.
+*/
+int MYSQL_BIN_LOG::sync_log_file()
+{
+  int err= mysql_file_sync(log_file.file, MYF(MY_WME));
 #ifndef DBUG_OFF
-    if (opt_binlog_dbug_fsync_sleep > 0)
-      my_sleep(opt_binlog_dbug_fsync_sleep);
+  if (opt_binlog_dbug_fsync_sleep > 0)
+    my_sleep(opt_binlog_dbug_fsync_sleep);
 #endif
-  }
   return err;
 }
 
@@ -6826,6 +6869,13 @@ binlog_cache_data* binlog_get_cache_data(binlog_cache_mngr *cache_mngr,
   return cache_mngr->get_binlog_cache_data(use_trans_cache);
 }
 
+void binlog_writeset_add_row(binlog_cache_data *cache_data, TABLE *table,
+                             const uchar *before_record,
+                             const uchar *after_record)
+{
+  cache_data->writeset.add_row(table, before_record, after_record);
+}
+
 int binlog_flush_pending_rows_event(THD *thd, bool stmt_end,
                                     bool is_transactional,
                                     Event_log *bin_log,
@@ -7045,13 +7095,19 @@ Event_log::prepare_pending_rows_event(THD *thd, TABLE* table,
 }
 
 
-/* Generate a new global transaction ID, and write it to the binlog */
+/*
+  Generate a new global transaction ID, and write it to the binlog.
+
+  writeset is the writeset of the event group, or NULL if the event group
+  must depend on everything before it (see rpl_writeset.h).
+*/
 
 bool
 MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
                                 bool is_transactional, uint64 commit_id,
                                 bool commit_by_rotate,
-                                bool has_xid, bool is_ro_1pc)
+                                bool has_xid, bool is_ro_1pc,
+                                const Binlog_writeset *writeset)
 {
   rpl_gtid gtid;
   uint32 domain_id;
@@ -7108,6 +7164,12 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
                             LOG_EVENT_SUPPRESS_USE_F, is_transactional,
                             commit_id, has_xid, is_ro_1pc);
 
+  if (opt_binlog_dependency_tracking == BINLOG_DEPENDENCY_TRACKING_WRITESET)
+    gtid_event.set_dependency(writeset_history.add(domain_id, seq_no,
+                                                   writeset));
+  else
+    writeset_history.invalidate();
+
   /* Write the event to the binary log. */
   DBUG_ASSERT(this == &mysql_bin_log);
 
@@ -7599,6 +7661,7 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       status_var_add(thd->status_var.binlog_bytes_written,
                      offset - my_org_b_tell);
 
+      wait_for_binlog_sync();
       mysql_mutex_lock(&LOCK_after_binlog_sync);
       mysql_mutex_unlock(&LOCK_log);
 
@@ -8088,6 +8151,7 @@ int MYSQL_BIN_LOG::rotate_and_purge(bool force_rotate,
           checkpoint notification request until early binlogged
           concurrent commits have has been completed.
   */
+  wait_for_binlog_sync();
   mysql_mutex_lock(&LOCK_after_binlog_sync);
   mysql_mutex_unlock(&LOCK_log);
   mysql_mutex_lock(&LOCK_commit_ordered);
@@ -8165,14 +8229,15 @@ int Event_log::write_cache(THD *thd, binlog_cache_data *cache_data)
 
   /*
     If possible, just copy the cache over byte-by-byte with pre-computed
-    checksums.
+    checksums. The part of a large transaction that was spilled to the
+    cache file is copied to the binlog file by the kernel.
   */
   if (likely(binlog_checksum_options == (ulong)cache_data->checksum_opt) &&
       likely(!crypto.scheme) &&
       likely(!opt_binlog_legacy_event_pos))
   {
-    int res=
-        my_b_copy_to_cache(cache, &log_file, cache_data->length_for_read());
+    int res= my_b_copy_file_to_cache(cache, &log_file,
+                                     cache_data->length_for_read());
     status_var_add(thd->status_var.binlog_bytes_written,
                    cache_data->length_for_read());
     DBUG_RETURN(res ? ER_ERROR_ON_WRITE : 0);
@@ -9118,14 +9183,108 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
   DBUG_VOID_RETURN;
 }
 
+void
+MYSQL_BIN_LOG::trx_group_commit_set_error(group_commit_entry *leader)
+{
+  for (group_commit_entry *current= leader; current != NULL; current= current->next)
+  {
+    if (!current->error)
+    {
+      current->error= ER_ERROR_ON_WRITE;
+      current->commit_errno= errno;
+      current->error_cache= NULL;
+    }
+  }
+}
+
+
+/**
+  Sync the binlog file up to the end of a group commit and make the group
+  visible to the dump threads.
+
+  This is called either with LOCK_log held, or in the sync stage, with
+  only LOCK_binlog_sync held, while the next group can already write to
+  the binlog.
+
+  @param leader     the first transaction of the group
+  @param offset     the end of the group in the binlog file
+  @param need_sync  whether sync_binlog requires an fsync() of this group
+*/
+void MYSQL_BIN_LOG::trx_group_commit_sync(group_commit_entry *leader,
+                                          my_off_t offset, bool need_sync)
+{
+  group_commit_entry *current;
+  DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_sync");
+  DBUG_ASSERT(mysql_mutex_is_owner(&LOCK_log) ||
+              mysql_mutex_is_owner(&LOCK_binlog_sync));
+
+  if (need_sync && unlikely(sync_log_file()))
+  {
+    trx_group_commit_set_error(leader);
+    DBUG_VOID_RETURN;
+  }
+
+  DEBUG_SYNC(leader->thd, "commit_before_update_binlog_end_pos");
+  bool any_error= false;
+
+  mysql_mutex_assert_not_owner(&LOCK_prepare_ordered);
+  mysql_mutex_assert_not_owner(&LOCK_after_binlog_sync);
+  mysql_mutex_assert_not_owner(&LOCK_commit_ordered);
+
+  for (current= leader; current != NULL; current= current->next)
+  {
+#ifdef HAVE_REPLICATION
+    /*
+      The thread which will await the ACK from the replica can change
+      depending on the wait-point. If AFTER_COMMIT, then the user thread
+      will perform the wait. If AFTER_SYNC, the binlog group commit leader
+      will perform the wait on behalf of the user thread.
+    */
+    THD *waiter_thd= (repl_semisync_master.wait_point() ==
+                      SEMI_SYNC_MASTER_WAIT_POINT_AFTER_STORAGE_COMMIT)
+                         ? current->thd
+                         : leader->thd;
+    if (likely(!current->error) &&
+        unlikely(repl_semisync_master.
+                 report_binlog_update(current->thd, waiter_thd,
+                                      current->cache_mngr->
+                                      last_commit_pos_file,
+                                      current->cache_mngr->
+                                      last_commit_pos_offset)))
+    {
+      current->error= ER_ERROR_ON_WRITE;
+      current->commit_errno= -1;
+      current->error_cache= NULL;
+      any_error= true;
+    }
+#endif
+  }
+
+  /*
+    update binlog_end_pos so it can be read by dump thread
+    Note: must be _after_ the RUN_HOOK(after_flush) or else
+    semi-sync might not have put the transaction into
+    it's list before dump-thread tries to send it
+  */
+  update_binlog_end_pos(offset);
+
+  if (unlikely(any_error))
+    sql_print_error("Failed to run 'after_flush' hooks");
+  DBUG_VOID_RETURN;
+}
+
+
 void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
                                                   group_commit_entry *tail,
                                                   bool commit_by_rotate)
 {
   uint xid_count= 0;
   bool check_purge= false;
+  bool need_sync= false;
   ulong UNINIT_VAR(binlog_id);
   my_off_t UNINIT_VAR(commit_offset);
+  /* The end of the group, if it is synced after releasing LOCK_log */
+  my_off_t sync_offset= 0;
   group_commit_entry *current;
 
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_with_engines");
@@ -9201,68 +9360,23 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
     }
     set_current_thd(leader->thd);
 
-    bool synced= 0;
-    if (unlikely(flush_and_sync(&synced)))
-    {
-      for (current= leader; current != NULL; current= current->next)
-      {
-        if (!current->error)
-        {
-          current->error= ER_ERROR_ON_WRITE;
-          current->commit_errno= errno;
-          current->error_cache= NULL;
-        }
-      }
-    }
+    /*
+      Only write the group to the file here. The fsync() is done after
+      releasing LOCK_log, so that the next group can write its caches
+      while this one is syncing.
+    */
+    bool flushed= false;
+    if (unlikely(flush_io_cache(&log_file)))
+      trx_group_commit_set_error(leader);
     else
     {
-      DEBUG_SYNC(leader->thd, "commit_before_update_binlog_end_pos");
-      bool any_error= false;
-
-      mysql_mutex_assert_not_owner(&LOCK_prepare_ordered);
-      mysql_mutex_assert_owner(&LOCK_log);
-      mysql_mutex_assert_not_owner(&LOCK_after_binlog_sync);
-      mysql_mutex_assert_not_owner(&LOCK_commit_ordered);
-
-      for (current= leader; current != NULL; current= current->next)
+      flushed= true;
+      uint sync_period= get_sync_period();
+      if (sync_period && ++sync_counter >= sync_period)
       {
-#ifdef HAVE_REPLICATION
-        /*
-          The thread which will await the ACK from the replica can change
-          depending on the wait-point. If AFTER_COMMIT, then the user thread
-          will perform the wait. If AFTER_SYNC, the binlog group commit leader
-          will perform the wait on behalf of the user thread.
-        */
-        THD *waiter_thd= (repl_semisync_master.wait_point() ==
-                          SEMI_SYNC_MASTER_WAIT_POINT_AFTER_STORAGE_COMMIT)
-                             ? current->thd
-                             : leader->thd;
-        if (likely(!current->error) &&
-            unlikely(repl_semisync_master.
-                     report_binlog_update(current->thd, waiter_thd,
-                                          current->cache_mngr->
-                                          last_commit_pos_file,
-                                          current->cache_mngr->
-                                          last_commit_pos_offset)))
-        {
-          current->error= ER_ERROR_ON_WRITE;
-          current->commit_errno= -1;
-          current->error_cache= NULL;
-          any_error= true;
-        }
-#endif
+        sync_counter= 0;
+        need_sync= true;
       }
-
-      /*
-        update binlog_end_pos so it can be read by dump thread
-        Note: must be _after_ the RUN_HOOK(after_flush) or else
-        semi-sync might not have put the transaction into
-        it's list before dump-thread tries to send it
-      */
-      update_binlog_end_pos(commit_offset);
-
-      if (unlikely(any_error))
-        sql_print_error("Failed to run 'after_flush' hooks");
     }
 
     /*
@@ -9276,6 +9390,21 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
       mark_xids_active(binlog_id, xid_count);
     }
 
+    /*
+      Rotation closes the file, so if it is due, the group must be synced
+      while still holding LOCK_log.
+    */
+    if (flushed)
+    {
+      if (commit_by_rotate || my_b_tell(&log_file) >= max_size)
+      {
+        wait_for_binlog_sync();
+        trx_group_commit_sync(leader, commit_offset, need_sync);
+      }
+      else
+        sync_offset= commit_offset;
+    }
+
     if (rotate(false, &check_purge))
     {
       /*
@@ -9299,15 +9428,30 @@ void MYSQL_BIN_LOG::trx_group_commit_with_engines(group_commit_entry *leader,
     commit_offset= my_b_write_tell(&log_file);
   }
 
+  if (sync_offset)
+  {
+    /*
+      Sync stage. LOCK_binlog_sync is locked before LOCK_log is released,
+      so that groups cannot reorder.
+    */
+    mysql_mutex_lock(&LOCK_binlog_sync);
+    mysql_mutex_unlock(&LOCK_log);
+    trx_group_commit_sync(leader, sync_offset, need_sync);
+  }
+
   DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
   mysql_mutex_lock(&LOCK_after_binlog_sync);
   /*
-    We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
-    otherwise scheduling could allow the next group commit to run ahead of us,
-    messing up the order of commit_ordered() calls. But as soon as
-    LOCK_after_binlog_sync is obtained, we can let the next group commit start.
-  */
-  mysql_mutex_unlock(&LOCK_log);
+    We cannot unlock LOCK_log (or LOCK_binlog_sync) until we have locked
+    LOCK_after_binlog_sync; otherwise scheduling could allow the next group
+    commit to run ahead of us, messing up the order of commit_ordered()
+    calls. But as soon as LOCK_after_binlog_sync is obtained, we can let the
+    next group commit start.
+  */
+  if (sync_offset)
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  else
+    mysql_mutex_unlock(&LOCK_log);
 
   DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
 
@@ -9455,7 +9599,10 @@ int MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
   {
     if (write_gtid_event(entry->thd, is_prepared_xa(entry->thd),
                          entry->using_trx_cache, commit_id,
-                         false /* commit_by_rotate */, has_xid, entry->ro_1pc))
+                         false /* commit_by_rotate */, has_xid, entry->ro_1pc,
+                         mngr->get_writeset(entry->thd,
+                                            entry->using_stmt_cache,
+                                            entry->using_trx_cache)))
       DBUG_RETURN(ER_ERROR_ON_WRITE);
   }
 
@@ -9739,6 +9886,7 @@ void MYSQL_BIN_LOG::close(uint exiting)
   DBUG_PRINT("enter",("exiting: %d", (int) exiting));
 
   mysql_mutex_assert_owner(&LOCK_log);
+  wait_for_binlog_sync();
 
   if (log_state == LOG_OPENED)
   {
@@ -13376,7 +13524,10 @@ bool Binlog_commit_by_rotate::replace_binlog_file()
   if (mysql_bin_log.write_gtid_event(
           m_entry->thd, is_prepared_xa(m_entry->thd), m_entry->using_trx_cache,
           0 /* commit_id */, true /* commit_by_rotate */,
-          m_entry->end_event->get_type_code() == XID_EVENT, m_entry->ro_1pc))
+          m_entry->end_event->get_type_code() == XID_EVENT, m_entry->ro_1pc,
+          m_entry->cache_mngr->get_writeset(m_entry->thd,
+                                            m_entry->using_stmt_cache,
+                                            m_entry->using_trx_cache)))
     goto err;
 
   DBUG_EXECUTE_IF("binlog_commit_by_rotate_crash_before_rename",
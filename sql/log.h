@@ -19,6 +19,7 @@
 
 #include "handler.h"                            /* my_xid */
 #include "rpl_constants.h"
+#include "rpl_writeset.h"
 
 class Relay_log_info;
 class Gtid_index_writer;
@@ -731,6 +732,11 @@ class MYSQL_BIN_LOG: public TC_LOG, private Event_log
 
   /* Binlog GTID index. */
   Gtid_index_writer *gtid_index;
+  /*
+    Keys written by recent event groups, for
+    --binlog-transaction-dependency-tracking=WRITESET. Protected by LOCK_log.
+  */
+  Writeset_history writeset_history;
 
   /* pointer to the sync period variable, for binlog this will be
      sync_binlog_period, for relay log this will be
@@ -738,6 +744,13 @@ class MYSQL_BIN_LOG: public TC_LOG, private Event_log
   */
   uint *sync_period_ptr;
   uint sync_counter;
+  /*
+    Serializes the sync stage of group commit. The group commit leader
+    locks it before releasing LOCK_log, so that the next group can write
+    to the binlog while this one waits for fsync().
+    See trx_group_commit_with_engines().
+  */
+  mysql_mutex_t LOCK_binlog_sync;
   bool state_file_deleted;
   bool binlog_state_recover_done;
 
@@ -771,6 +784,21 @@ class MYSQL_BIN_LOG: public TC_LOG, private Event_log
   void trx_group_commit_with_engines(group_commit_entry *leader,
                                      group_commit_entry *tail,
                                      bool commit_by_rotate);
+  void trx_group_commit_sync(group_commit_entry *leader, my_off_t offset,
+                             bool need_sync);
+  static void trx_group_commit_set_error(group_commit_entry *leader);
+  int sync_log_file();
+  /*
+    Wait until a group commit in the sync stage has finished it. Called
+    with LOCK_log held, before closing the binlog file or exposing data
+    written after that group.
+  */
+  void wait_for_binlog_sync()
+  {
+    mysql_mutex_assert_owner(&LOCK_log);
+    mysql_mutex_lock(&LOCK_binlog_sync);
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  }
   bool is_xidlist_idle_nolock();
   void update_gtid_index(uint32 offset, rpl_gtid gtid);
 
@@ -980,7 +1008,8 @@ class MYSQL_BIN_LOG: public TC_LOG, private Event_log
   }
   void update_binlog_end_pos(my_off_t pos)
   {
-    mysql_mutex_assert_owner(&LOCK_log);
+    DBUG_ASSERT(mysql_mutex_is_owner(&LOCK_log) ||
+                mysql_mutex_is_owner(&LOCK_binlog_sync));
     mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
     lock_binlog_end_pos();
     /*
@@ -1129,7 +1158,8 @@ class MYSQL_BIN_LOG: public TC_LOG, private Event_log
   bool write_gtid_event(THD *thd, bool standalone, bool is_transactional,
                         uint64 commit_id,
                         bool commit_by_rotate,
-                        bool has_xid= false, bool ro_1pc= false);
+                        bool has_xid= false, bool ro_1pc= false,
+                        const Binlog_writeset *writeset= NULL);
   int read_state_from_file();
   int write_state_to_file();
   int get_most_recent_gtid_list(rpl_gtid **list, uint32 *size);
@@ -1416,6 +1446,9 @@ int online_alter_log_row(TABLE* table, const uchar *before_record,
                          const uchar *after_record, Log_func *log_func);
 binlog_cache_data* binlog_get_cache_data(binlog_cache_mngr *cache_mngr,
                                          bool use_trans_cache);
+void binlog_writeset_add_row(binlog_cache_data *cache_data, TABLE *table,
+                             const uchar *before_record,
+                             const uchar *after_record);
 
 extern MYSQL_PLUGIN_IMPORT MYSQL_BIN_LOG mysql_bin_log;
 extern transaction_participant binlog_tp;
@@ -17,6 +17,7 @@
 */
 
 #include "log_event.h"
+#include "rpl_writeset.h"
 
 static constexpr my_off_t MY_OFF_T_UNDEF= ~0ULL;
 /** Truncate cache log files bigger than this */
@@ -123,6 +124,7 @@ class binlog_cache_data
     status= 0;
     incident= FALSE;
     before_stmt_pos= MY_OFF_T_UNDEF;
+    writeset.clear();
     DBUG_ASSERT(empty());
   }
 
@@ -189,6 +191,12 @@ class binlog_cache_data
     status|= status_arg;
   }
 
+  /* Return true if events other than row events were written */
+  bool has_critical_events() const
+  {
+    return status & LOGGED_CRITICAL;
+  }
+
   /**
     This function is called everytime when anything is being written into the
     cache_log. To support rename binlog cache to binlog file, the cache_log
@@ -269,6 +277,12 @@ class binlog_cache_data
   */
   IO_CACHE cache_log;
 
+  /*
+    Keys of the rows written to the cache, for
+    --binlog-transaction-dependency-tracking=WRITESET.
+  */
+  Binlog_writeset writeset;
+
 protected:
   /*
     Binlog position before the start of the current statement.
@@ -3368,6 +3368,11 @@ class Gtid_log_event: public Log_event
   */
   uint8 extra_engines;
   my_thread_id thread_id;
+  /*
+    The largest seq_no of an earlier event group in the domain that this
+    one may conflict with, see FL_EXTRA_DEPENDENCY.
+  */
+  uint64 dependency_seq_no;
 
   /* Flags2. */
 
@@ -3414,17 +3419,29 @@ class Gtid_log_event: public Log_event
   static const uchar FL_COMMIT_ALTER_E1= 4;
   static const uchar FL_ROLLBACK_ALTER_E1= 8;
   static const uchar FL_EXTRA_THREAD_ID= 16; // thread_id like in BEGIN Query
+  /*
+    FL_EXTRA_DEPENDENCY is set when the master tracked the rows written by
+    the event group (--binlog-transaction-dependency-tracking=WRITESET), and
+    dependency_seq_no follows.
+  */
+  static const uchar FL_EXTRA_DEPENDENCY= 32;
 
 #ifdef MYSQL_SERVER
   static const uint max_data_length= GTID_HEADER_LEN + 2 + sizeof(XID)
                                      + 1 /* flags_extra: */
                                      + 1 /* Extra Engines */
                                      + 8 /* sa_seq_no */
-                                     + 4 /* FL_EXTRA_THREAD_ID */;
+                                     + 4 /* FL_EXTRA_THREAD_ID */
+                                     + 8 /* FL_EXTRA_DEPENDENCY */;
 
   Gtid_log_event(THD *thd_arg, uint64 seq_no, uint32 domain_id, bool standalone,
                  uint16 flags, bool is_transactional, uint64 commit_id,
                  bool has_xid= false, bool is_ro_1pc= false);
+  void set_dependency(uint64 dependency_seq_no_arg)
+  {
+    flags_extra|= FL_EXTRA_DEPENDENCY;
+    dependency_seq_no= dependency_seq_no_arg;
+  }
 #ifdef HAVE_REPLICATION
   void pack_info(Protocol *protocol) override;
   int do_apply_event(rpl_group_info *rgi) override;
@@ -4877,6 +4894,18 @@ class Rows_log_event : public Log_event
   uint      m_usable_key_parts; /* A number of key_parts suited to lookup */
   bool master_had_triggers;     /* set after tables opening */
 
+  /* A row of the event as located by locate_rows() */
+  struct Located_row
+  {
+    const uchar *row;   /* Start of the row in the event */
+    uint32 hash;        /* Hash of the before image */
+    bool located;       /* Whether the position of the row is known */
+  };
+  Located_row *m_located_rows;  /* The rows of the event, in event order */
+  uchar *m_located_refs;        /* The positions of the rows */
+  uint m_located_count;
+  uint m_located_next;          /* The next row to be used by find_row() */
+
   /*
     RAII helper class to automatically handle the override/restore of thd->db
     when applying row events, so it will be visible in SHOW PROCESSLIST.
@@ -4926,6 +4955,15 @@ class Rows_log_event : public Log_event
   uint find_key_parts(const KEY *key) const;
   bool use_pk_position() const;
   int find_row(rpl_group_info *);
+  int locate_rows(rpl_group_info *);
+  int read_located_row();
+  void free_located_rows()
+  {
+    my_free(m_located_rows);
+    m_located_rows= NULL;
+    m_located_count= 0;
+  }
+  void prefetch_rows(rpl_group_info *);
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
 
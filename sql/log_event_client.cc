@@ -3863,6 +3863,12 @@ Gtid_log_event::print(FILE *file, PRINT_EVENT_INFO *print_event_info)
       if (my_b_printf(&cache, " thread_id=%s", buf2))
         goto err;
     }
+    if (flags_extra & FL_EXTRA_DEPENDENCY)
+    {
+      longlong10_to_str(dependency_seq_no, buf2, 10);
+      if (my_b_printf(&cache, " dependency=%s", buf2))
+        goto err;
+    }
     if (my_b_printf(&cache, "\n"))
       goto err;
 
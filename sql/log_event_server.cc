@@ -61,6 +61,7 @@
 #include "rpl_constants.h"
 #include "sql_digest.h"
 #include "zlib.h"
+#include <algorithm>
 
 
 #define log_cs  &my_charset_latin1
@@ -2850,7 +2851,7 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
     pad_to_size(0), flags2((standalone ? FL_STANDALONE : 0) |
            (commit_id_arg ? FL_GROUP_COMMIT_ID : 0)),
     flags_extra(0), extra_engines(0),
-    thread_id(thd_arg->variables.pseudo_thread_id)
+    thread_id(thd_arg->variables.pseudo_thread_id), dependency_seq_no(0)
 {
   cache_type= Log_event::EVENT_NO_CACHE;
   bool is_tmp_table= thd_arg->lex->stmt_accessed_temp_table();
@@ -3007,7 +3008,7 @@ Gtid_log_event::write(Log_event_writer *writer)
       DBUG_IF("negate_xid_data_from_gtid") ||
       DBUG_IF("inject_fl_extra_multi_engine_into_gtid") ||
       DBUG_IF("negate_alter_fl_from_gtid"))
-    flags_extra&= ~FL_EXTRA_THREAD_ID;
+    flags_extra&= ~(FL_EXTRA_THREAD_ID | FL_EXTRA_DEPENDENCY);
 #endif
 
   DBUG_EXECUTE_IF("inject_fl_extra_multi_engine_into_gtid", {
@@ -3042,6 +3043,12 @@ Gtid_log_event::write(Log_event_writer *writer)
     write_len+= 4;
   }
 
+  if (flags_extra & FL_EXTRA_DEPENDENCY)
+  {
+    int8store(buf + write_len, dependency_seq_no);
+    write_len+= 8;
+  }
+
   if (write_len < GTID_HEADER_LEN)
   {
     bzero(buf+write_len, GTID_HEADER_LEN-write_len);
@@ -4676,7 +4683,8 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg,
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0), m_located_rows(NULL), m_located_refs(NULL),
+    m_located_count(0), m_located_next(0)
 #endif
 {
   /*
@@ -5209,6 +5217,9 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
      */
     rgi->set_row_stmt_start_timestamp();
 
+    if (!error && opt_slave_prefetch_rows && !rpl_data.is_online_alter())
+      prefetch_rows(rgi);
+
     THD_STAGE_INFO(thd, stage_executing);
     do
     {
@@ -7565,12 +7576,288 @@ bool Rows_log_event::use_pk_position() const
       && m_usable_key_parts == m_table->key_info->user_defined_key_parts;
 }
 
+/**
+  Let the storage engine start reading the index pages of all rows of the
+  event before they are applied one by one, so that applying a row does
+  not have to wait for the pages of that row to be read first.
+
+  The rows are located with the key that find_row() is going to use, or
+  with the primary key for inserts. Only the columns of that key are
+  unpacked, see unpack_row_columns(); the rows are unpacked completely
+  when they are applied. Nothing is done for events with a single row,
+  as the read ahead could not overlap with anything, nor for keys with
+  virtual columns, which could not be computed from the key columns.
+*/
+void Rows_log_event::prefetch_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  const Log_event_type type= get_general_type_code();
+  uint keynr;
+  key_part_map keypart_map;
+  uchar key[MAX_KEY_LENGTH];
+  DBUG_ENTER("Rows_log_event::prefetch_rows");
+
+  if (table->versioned())
+    DBUG_VOID_RETURN;
+  if (type == WRITE_ROWS_EVENT)
+  {
+    if ((keynr= table->s->primary_key) == MAX_KEY)
+      DBUG_VOID_RETURN;
+    keypart_map= make_prev_keypart_map(table->key_info[keynr].
+                                       user_defined_key_parts);
+  }
+  else
+  {
+    if (!m_key_info)
+      DBUG_VOID_RETURN;
+    keynr= m_key_nr;
+    keypart_map= make_keypart_map(m_usable_key_parts);
+  }
+
+  KEY *const key_info= table->key_info + keynr;
+  my_bitmap_map key_cols_buf[bitmap_buffer_size(MAX_FIELDS) /
+                             sizeof(my_bitmap_map)];
+  MY_BITMAP key_cols;
+  my_bitmap_init(&key_cols, key_cols_buf, table->s->fields);
+  for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+  {
+    const Field *field= key_info->key_part[i].field;
+    if (field->vcol_info)
+      DBUG_VOID_RETURN;
+    bitmap_set_bit(&key_cols, field->field_index);
+  }
+
+  const uchar *const curr_row= m_curr_row, *const curr_row_end= m_curr_row_end;
+  ulonglong prefetched= 0;
+  Check_level_instant_set clis(thd, CHECK_FIELD_IGNORE);
+  do
+  {
+    const bool first_row= m_curr_row == curr_row;
+    if (unpack_row_columns(rgi, table, m_width, m_curr_row, &m_cols,
+                           &key_cols, &m_curr_row_end, m_rows_end))
+      break;
+    key_copy(key, table->record[0], key_info, 0);
+    if (type == UPDATE_ROWS_EVENT)
+    {
+      /* Skip the after image */
+      m_curr_row= m_curr_row_end;
+      if (unpack_row_columns(rgi, table, m_width, m_curr_row, &m_cols_ai,
+                             NULL, &m_curr_row_end, m_rows_end))
+        break;
+    }
+    if ((first_row && m_curr_row_end >= m_rows_end) ||
+        table->file->prefetch_key(keynr, key, keypart_map))
+      break;
+    prefetched++;
+    m_curr_row= m_curr_row_end;
+  } while (m_curr_row < m_rows_end);
+
+  if (prefetched)
+    statistic_add(slave_prefetched_rows, prefetched, &LOCK_status);
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+  DBUG_VOID_RETURN;
+}
+
 static int end_of_file_error(rpl_group_info *rgi)
 {
   return rgi->speculation != rpl_group_info::SPECULATE_OPTIMISTIC
          ? HA_ERR_END_OF_FILE : HA_ERR_RECORD_CHANGED;
 }
 
+/**
+  Hash the fields of table->record[0] that record_compare() compares.
+*/
+static uint32 record_hash(TABLE *table)
+{
+  const bool all_values_set= bitmap_is_set_all(&table->has_value_set);
+  Hasher hasher;
+  for (Field **ptr= table->field; *ptr; ptr++)
+  {
+    Field *f= *ptr;
+    if ((!all_values_set && !f->has_explicit_value()) || f->vcol_info)
+      continue;
+    if (f->is_null())
+      hasher.add_null();
+    else
+      f->hash_not_null(&hasher);
+  }
+  return hasher.finalize();
+}
+
+
+/**
+  Locate the rows of an update or delete event on a table without a
+  usable key in a single table scan, instead of one table scan per row
+  in find_row().
+
+  The before images of the rows are hashed, and each row of the table is
+  assigned to the first row of the event with the same values that has no
+  row assigned yet. Rows of the event that get no row, for example because
+  they change a row that an earlier row of the event changed, are searched
+  for by find_row() as before.
+
+  @return Error code on failure, 0 on success.
+*/
+int Rows_log_event::locate_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  const uchar *const curr_row= m_curr_row, *const curr_row_end= m_curr_row_end;
+  uint count= 0, located= 0, *order;
+  int error= 0;
+  DBUG_ENTER("Rows_log_event::locate_rows");
+
+  /*
+    Count the rows. This also leaves table->has_value_set as it is going
+    to be while the rows are applied.
+  */
+  do
+  {
+    if (unpack_current_row(rgi))
+      goto end;
+    if (is_update)
+    {
+      m_curr_row= m_curr_row_end;
+      if (unpack_current_row(rgi, &m_cols_ai))
+        goto end;
+    }
+    m_curr_row= m_curr_row_end;
+    count++;
+  } while (m_curr_row < m_rows_end);
+
+  if (count < 2 ||
+      !my_multi_malloc(PSI_INSTRUMENT_ME, MYF(MY_WME),
+                       &m_located_rows, count * sizeof(Located_row),
+                       &m_located_refs, count * size_t{file->ref_length},
+                       &order, count * sizeof(uint), NullS))
+    goto end;
+  m_located_count= count;
+  m_located_next= 0;
+
+  m_curr_row= curr_row;
+  for (uint i= 0; i < count; i++)
+  {
+    Located_row *row= &m_located_rows[i];
+    row->row= m_curr_row;
+    row->located= false;
+    prepare_record(table, m_width, FALSE);
+    unpack_current_row(rgi);
+    row->hash= record_hash(table);
+    if (is_update)
+    {
+      m_curr_row= m_curr_row_end;
+      unpack_current_row(rgi, &m_cols_ai);
+    }
+    m_curr_row= m_curr_row_end;
+    order[i]= i;
+  }
+  std::sort(order, order + count, [this](uint a, uint b) {
+    return m_located_rows[a].hash < m_located_rows[b].hash ||
+           (m_located_rows[a].hash == m_located_rows[b].hash && a < b);
+  });
+
+  /* We use this to test that the correct key is used in test cases. */
+  DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
+
+  if (unlikely((error= file->ha_rnd_init_with_error(1))))
+    goto end;
+  while (located < count)
+  {
+    if (unlikely((error= file->ha_rnd_next(table->record[0]))))
+    {
+      if (error == HA_ERR_END_OF_FILE)
+        error= 0;
+      else
+        file->print_error(error, MYF(0));
+      break;
+    }
+
+    const uint32 hash= record_hash(table);
+    uint *i= std::lower_bound(order, order + count, hash,
+                              [this](uint a, uint32 h) {
+                                return m_located_rows[a].hash < h;
+                              });
+    if (i == order + count || m_located_rows[*i].hash != hash)
+      continue;
+
+    normalize_null_bits(table);
+    store_record(table, record[1]);
+    for (; i < order + count && m_located_rows[*i].hash == hash; i++)
+    {
+      Located_row *row= &m_located_rows[*i];
+      if (row->located)
+        continue;
+      prepare_record(table, m_width, FALSE);
+      m_curr_row= row->row;
+      if (unpack_current_row(rgi) || record_compare(table))
+        continue;
+      file->position(table->record[1]);
+      memcpy(m_located_refs + *i * size_t{file->ref_length}, file->ref,
+             file->ref_length);
+      row->located= true;
+      located++;
+      break;
+    }
+  }
+  file->ha_rnd_end();
+
+end:
+  if (error || !located)
+    free_located_rows();
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+  DBUG_PRINT("info", ("located %u of %u rows", located, count));
+  DBUG_RETURN(error);
+}
+
+
+/**
+  Read the row of the table that locate_rows() assigned to the current row
+  of the event into table->record[0], if it still matches the before image
+  in table->record[1].
+
+  @retval 0                     the row was read, and the table is left
+                                positioned on it
+  @retval HA_ERR_KEY_NOT_FOUND  the row has to be searched for
+  @return other error code on failure
+*/
+int Rows_log_event::read_located_row()
+{
+  TABLE *table= m_table;
+  handler *file= table->file;
+  int error;
+
+  while (m_located_next < m_located_count &&
+         m_located_rows[m_located_next].row < m_curr_row)
+    m_located_next++;
+  if (m_located_next == m_located_count ||
+      m_located_rows[m_located_next].row != m_curr_row ||
+      !m_located_rows[m_located_next].located)
+    return HA_ERR_KEY_NOT_FOUND;
+
+  if (unlikely((error= file->ha_rnd_init_with_error(0))))
+    return error;
+  error= file->ha_rnd_pos(table->record[0], m_located_refs +
+                          m_located_next * size_t{file->ref_length});
+  if (!error && !record_compare(table, m_vers_from_plain))
+    return 0;
+  file->ha_rnd_end();
+
+  switch (error) {
+  case 0:
+    /* An earlier row of the event changed the row */
+  case HA_ERR_KEY_NOT_FOUND:
+  case HA_ERR_RECORD_DELETED:
+  case HA_ERR_END_OF_FILE:
+    return HA_ERR_KEY_NOT_FOUND;
+  }
+  file->print_error(error, MYF(0));
+  return error;
+}
+
+
 /**
   Locate the current row in event's table.
 
@@ -7614,6 +7901,14 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
   bool is_table_scan= false, is_index_scan= false;
   Check_level_instant_set clis(table->in_use, CHECK_FIELD_IGNORE);
 
+  /* Without a key, locate all rows of the event at once */
+  if (!m_key_info && m_curr_row == m_rows_buf && !table->versioned())
+  {
+    if ((error= locate_rows(rgi)))
+      DBUG_RETURN(error);
+    is_table_scan= m_located_rows != NULL;
+  }
+
   /*
     rpl_row_tabledefs.test specifies that
     if the extra field on the slave does not have a default value
@@ -7819,6 +8114,13 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
   }
   else
   {
+    if (m_located_rows)
+    {
+      if ((error= read_located_row()) != HA_ERR_KEY_NOT_FOUND)
+        goto end;
+      error= 0;
+    }
+
     DBUG_PRINT("info",("locating record using table scan (rnd_next)"));
     /* We use this to test that the correct key is used in test cases. */
     DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
@@ -7928,6 +8230,7 @@ Delete_rows_log_event::do_after_row_operations(int error)
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  free_located_rows();
 
   return error;
 }
@@ -8087,6 +8390,7 @@ Update_rows_log_event::do_after_row_operations(int error)
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  free_located_rows();
 
   return error;
 }
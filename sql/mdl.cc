@@ -38,19 +38,23 @@ static PSI_memory_key key_memory_MDL_context_acquire_locks;
 
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_MDL_wait_LOCK_wait_status;
+static PSI_mutex_key key_MDL_context_LOCK_fast_path;
 
 static PSI_mutex_info all_mdl_mutexes[]=
 {
-  { &key_MDL_wait_LOCK_wait_status, "MDL_wait::LOCK_wait_status", 0}
+  { &key_MDL_wait_LOCK_wait_status, "MDL_wait::LOCK_wait_status", 0},
+  { &key_MDL_context_LOCK_fast_path, "MDL_context::LOCK_fast_path", 0}
 };
 
 static PSI_rwlock_key key_MDL_lock_rwlock;
 static PSI_rwlock_key key_MDL_context_LOCK_waiting_for;
+static PSI_rwlock_key key_LOCK_mdl_fast_path;
 
 static PSI_rwlock_info all_mdl_rwlocks[]=
 {
   { &key_MDL_lock_rwlock, "MDL_lock::rwlock", 0},
-  { &key_MDL_context_LOCK_waiting_for, "MDL_context::LOCK_waiting_for", 0}
+  { &key_MDL_context_LOCK_waiting_for, "MDL_context::LOCK_waiting_for", 0},
+  { &key_LOCK_mdl_fast_path, "LOCK_mdl_fast_path", PSI_FLAG_GLOBAL}
 };
 
 static PSI_cond_key key_MDL_wait_COND_wait_status;
@@ -162,6 +166,15 @@ void MDL_key::init_psi_keys()
 
 static bool mdl_initialized= 0;
 
+/**
+  The contexts which have acquired locks on the fast path, see
+  MDL_lock::materialize_fast_path(). Protected by LOCK_mdl_fast_path.
+*/
+static ilist<MDL_context> mdl_fast_path_contexts;
+static mysql_rwlock_t LOCK_mdl_fast_path;
+/** The number of contexts ever registered in mdl_fast_path_contexts */
+static Atomic_counter<uint> mdl_fast_path_registrations;
+
 
 /**
   A collection of all MDL locks. A singleton,
@@ -174,6 +187,21 @@ class MDL_map
   void init();
   void destroy();
   MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key);
+  MDL_lock *find_or_insert_pinned(LF_PINS *pins, const MDL_key *key);
+  /**
+    Pin a lock which the caller holds a ticket for, so that it is not
+    freed after the ticket is released.
+  */
+  void pin(LF_PINS *pins, MDL_lock *lock)
+  {
+    if (lock != m_backup_lock)
+      lf_pin(pins, 2, reinterpret_cast<uchar*>(lock) - LF_HASH_OVERHEAD);
+  }
+  void unpin(LF_PINS *pins, MDL_lock *lock)
+  {
+    if (lock != m_backup_lock)
+      lf_hash_search_unpin(pins);
+  }
   unsigned long get_lock_owner(LF_PINS *pins, const MDL_key *key);
   void remove(LF_PINS *pins, MDL_lock *lock);
   LF_PINS *get_pins() { return lf_hash_get_pins(&m_locks); }
@@ -633,6 +661,35 @@ class MDL_lock
   bitmap_t hog_lock_types_bitmap() const
   { return m_strategy->hog_lock_types_bitmap(); }
 
+  /**
+    Lock types which may be granted on the fast path, without write-locking
+    m_rwlock, while no locks of other types are granted or waiting.
+
+    These are the types which DML statements use, and which are compatible
+    with each other.
+  */
+  static bitmap_t fast_path_types(MDL_key::enum_mdl_namespace mdl_namespace)
+  {
+    switch (mdl_namespace) {
+    case MDL_key::BACKUP:
+      return (MDL_BIT(MDL_BACKUP_DML) | MDL_BIT(MDL_BACKUP_TRANS_DML) |
+              MDL_BIT(MDL_BACKUP_SYS_DML) | MDL_BIT(MDL_BACKUP_DDL) |
+              MDL_BIT(MDL_BACKUP_ALTER_COPY) | MDL_BIT(MDL_BACKUP_COMMIT));
+    case MDL_key::TABLE:
+      return (MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_SHARED_HIGH_PRIO) |
+              MDL_BIT(MDL_SHARED_READ) | MDL_BIT(MDL_SHARED_WRITE));
+    default:
+      return 0;
+    }
+  }
+
+  void block_fast_path();
+  void update_fast_path_state();
+  void materialize_fast_path(MDL_context *ctx);
+  void materialize_fast_path();
+  uint32 fast_path_granted() const;
+  void remove_if_unused(LF_PINS *pins);
+
 #ifndef DBUG_OFF
   bool check_if_conflicting_replication_locks(MDL_context *ctx);
 #endif
@@ -648,16 +705,49 @@ class MDL_lock
   */
   ulong m_hog_lock_count;
 
+  /**
+    A ticket of a type which is not in fast_path_types() is granted,
+    waiting or being acquired. No locks are granted on the fast path.
+  */
+  static constexpr uint32 FAST_PATH_BLOCKED= 1;
+  /** The lock has been removed from MDL_map */
+  static constexpr uint32 FAST_PATH_DESTROYED= 2;
+  /** The number of m_fast_path_granted counters */
+  static constexpr uint FAST_PATH_SLOTS= 8;
+
+  /**
+    The FAST_PATH_ flags. They are changed under the write-locked m_rwlock.
+  */
+  std::atomic<uint32> m_fast_path_state;
+
+  /**
+    The number of the tickets granted on the fast path, split between
+    counters in separate cache lines, so that the contexts do not write
+    to the same cache line when acquiring and releasing a lock. A counter
+    is only changed under MDL_context::m_LOCK_fast_path of a context whose
+    MDL_context::m_fast_path_slot refers to it. While the sum is not 0,
+    the lock stays in MDL_map.
+  */
+  struct fast_path_slot
+  {
+    std::atomic<uint32> granted;
+    char pad[CPU_LEVEL1_DCACHE_LINESIZE - sizeof(std::atomic<uint32>)];
+  } m_fast_path_granted[FAST_PATH_SLOTS];
+
 public:
 
   MDL_lock()
     : m_hog_lock_count(0),
+      m_fast_path_state(0),
+      m_fast_path_granted(),
       m_strategy(0)
   { mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock); }
 
   MDL_lock(const MDL_key *key_arg)
   : key(key_arg),
     m_hog_lock_count(0),
+    m_fast_path_state(0),
+    m_fast_path_granted(),
     m_strategy(&m_backup_lock_strategy)
   {
     DBUG_ASSERT(key_arg->mdl_namespace() == MDL_key::BACKUP);
@@ -680,6 +770,7 @@ class MDL_lock
     const MDL_key *key_arg= static_cast<const MDL_key *>(_key_arg);
     DBUG_ASSERT(key_arg->mdl_namespace() != MDL_key::BACKUP);
     new (&lock->key) MDL_key(key_arg);
+    lock->m_fast_path_state.store(0, std::memory_order_relaxed);
     if (key_arg->mdl_namespace() == MDL_key::SCHEMA)
       lock->m_strategy= &m_scoped_lock_strategy;
     else
@@ -734,6 +825,7 @@ void mdl_init()
   init_mdl_psi_keys();
 #endif
 
+  mysql_rwlock_init(key_LOCK_mdl_fast_path, &LOCK_mdl_fast_path);
   mdl_locks.init();
 }
 
@@ -751,6 +843,7 @@ void mdl_destroy()
   {
     mdl_initialized= FALSE;
     mdl_locks.destroy();
+    mysql_rwlock_destroy(&LOCK_mdl_fast_path);
   }
 }
 
@@ -770,7 +863,14 @@ static my_bool mdl_iterate_lock(void *lk, void *a)
     We can skip check for m_strategy here, becase m_granted
     must be empty for such locks anyway.
   */
-  mysql_prlock_rdlock(&lock->m_rwlock);
+  if (lock->fast_path_granted())
+  {
+    /* Make the locks granted on the fast path visible, too. */
+    mysql_prlock_wrlock(&lock->m_rwlock);
+    lock->materialize_fast_path();
+  }
+  else
+    mysql_prlock_rdlock(&lock->m_rwlock);
   bool res= std::any_of(lock->m_granted.begin(), lock->m_granted.end(),
                         [arg](MDL_ticket &ticket) {
                           return arg->callback(&ticket, arg->argument, true);
@@ -850,6 +950,37 @@ void MDL_map::destroy()
 */
 
 MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
+{
+  MDL_lock *lock;
+
+retry:
+  if (!(lock= find_or_insert_pinned(pins, mdl_key)))
+    return NULL;
+
+  mysql_prlock_wrlock(&lock->m_rwlock);
+  if (unlikely(!lock->m_strategy))
+  {
+    mysql_prlock_unlock(&lock->m_rwlock);
+    unpin(pins, lock);
+    goto retry;
+  }
+  unpin(pins, lock);
+
+  return lock;
+}
+
+
+/**
+  Find MDL_lock object corresponding to the key, create it
+  if it does not exist.
+
+  @retval non-NULL - Success. MDL_lock instance for the key, pinned
+                     until unpin(). It may have been removed from the
+                     map already.
+  @retval NULL     - Failure (OOM).
+*/
+
+MDL_lock* MDL_map::find_or_insert_pinned(LF_PINS *pins, const MDL_key *mdl_key)
 {
   MDL_lock *lock;
 
@@ -863,25 +994,14 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
       for them look like '<namespace-id>\0\0'.
     */
     DBUG_ASSERT(mdl_key->length() == 3);
-    mysql_prlock_wrlock(&m_backup_lock->m_rwlock);
     return m_backup_lock;
   }
 
-retry:
   while (!(lock= (MDL_lock*) lf_hash_search(&m_locks, pins, mdl_key->ptr(),
                                             mdl_key->length())))
     if (lf_hash_insert(&m_locks, pins, (uchar*) mdl_key) == -1)
       return NULL;
 
-  mysql_prlock_wrlock(&lock->m_rwlock);
-  if (unlikely(!lock->m_strategy))
-  {
-    mysql_prlock_unlock(&lock->m_rwlock);
-    lf_hash_search_unpin(pins);
-    goto retry;
-  }
-  lf_hash_search_unpin(pins);
-
   return lock;
 }
 
@@ -936,6 +1056,28 @@ void MDL_map::remove(LF_PINS *pins, MDL_lock *lock)
     return;
   }
 
+  uint32 state= 0;
+  if (!lock->m_fast_path_state.compare_exchange_strong(
+        state, MDL_lock::FAST_PATH_DESTROYED))
+  {
+    /* Another thread already removed the lock. */
+    DBUG_ASSERT(state & MDL_lock::FAST_PATH_DESTROYED);
+    mysql_prlock_unlock(&lock->m_rwlock);
+    return;
+  }
+
+  if (lock->fast_path_granted())
+  {
+    /*
+      A lock was just granted on the fast path, or a concurrent
+      MDL_context::try_acquire_lock_fast_path() will see
+      FAST_PATH_DESTROYED, back off and invoke remove_if_unused().
+    */
+    lock->m_fast_path_state.store(0, std::memory_order_relaxed);
+    mysql_prlock_unlock(&lock->m_rwlock);
+    return;
+  }
+
   lock->m_strategy= 0;
   mysql_prlock_unlock(&lock->m_rwlock);
   lf_hash_delete(&m_locks, pins, lock->key.ptr(), lock->key.length());
@@ -953,9 +1095,13 @@ MDL_context::MDL_context()
   m_owner(NULL),
   m_needs_thr_lock_abort(FALSE),
   m_waiting_for(NULL),
-  m_pins(NULL)
+  m_pins(NULL),
+  m_fast_path_registered(false),
+  m_fast_path_slot(0)
 {
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
+  mysql_mutex_init(key_MDL_context_LOCK_fast_path, &m_LOCK_fast_path,
+                   MY_MUTEX_INIT_FAST);
 }
 
 
@@ -976,7 +1122,15 @@ void MDL_context::destroy()
   DBUG_ASSERT(m_tickets[MDL_STATEMENT].is_empty());
   DBUG_ASSERT(m_tickets[MDL_TRANSACTION].is_empty());
   DBUG_ASSERT(m_tickets[MDL_EXPLICIT].is_empty());
+  DBUG_ASSERT(m_fast_path_tickets.empty());
 
+  if (m_fast_path_registered)
+  {
+    mysql_rwlock_wrlock(&LOCK_mdl_fast_path);
+    mdl_fast_path_contexts.remove(*this);
+    mysql_rwlock_unlock(&LOCK_mdl_fast_path);
+  }
+  mysql_mutex_destroy(&m_LOCK_fast_path);
   mysql_prlock_destroy(&m_LOCK_waiting_for);
   if (m_pins)
     lf_hash_put_pins(m_pins);
@@ -1833,7 +1987,8 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
-  if (is_empty())
+  update_fast_path_state();
+  if (is_empty() && !fast_path_granted())
     mdl_locks.remove(pins, this);
   else
   {
@@ -1877,6 +2032,128 @@ bool MDL_lock::has_pending_conflicting_lock(enum_mdl_type type)
 }
 
 
+/**
+  Stop granting locks on the fast path, and make the locks which were
+  granted on it visible in m_granted, before a lock of a type which
+  is not in fast_path_types() is granted or starts waiting.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::block_fast_path()
+{
+  /*
+    A concurrent MDL_context::try_acquire_lock_fast_path() either sees
+    FAST_PATH_BLOCKED, or has added its ticket to the list of its context
+    before materialize_fast_path() acquires MDL_context::m_LOCK_fast_path.
+  */
+  m_fast_path_state.fetch_or(FAST_PATH_BLOCKED);
+  if (fast_path_granted())
+    materialize_fast_path();
+}
+
+
+/**
+  Allow granting locks on the fast path again if only locks of the
+  types in fast_path_types() are granted or waiting.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::update_fast_path_state()
+{
+  const bitmap_t types= fast_path_types(key.mdl_namespace());
+  if (types && !((m_granted.bitmap() | m_waiting.bitmap()) & ~types))
+    m_fast_path_state.fetch_and(~FAST_PATH_BLOCKED);
+}
+
+
+/**
+  Move the tickets of a context for this lock from the list of the
+  tickets granted on the fast path to m_granted.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::materialize_fast_path(MDL_context *ctx)
+{
+  mysql_mutex_lock(&ctx->m_LOCK_fast_path);
+  for (auto it= ctx->m_fast_path_tickets.begin();
+       it != ctx->m_fast_path_tickets.end(); )
+  {
+    MDL_ticket *ticket= &*it;
+    if (ticket->m_lock != this)
+    {
+      ++it;
+      continue;
+    }
+    it= ctx->m_fast_path_tickets.erase(it);
+    ticket->m_fast_path= false;
+    m_granted.add_ticket(ticket);
+    m_fast_path_granted[ctx->m_fast_path_slot].granted.fetch_sub(1);
+  }
+  mysql_mutex_unlock(&ctx->m_LOCK_fast_path);
+}
+
+
+/**
+  Move the tickets of all contexts for this lock from the lists of the
+  tickets granted on the fast path to m_granted.
+
+  This walks all contexts which have ever acquired a lock on the fast
+  path, so every DDL statement or FLUSH TABLES WITH READ LOCK that blocks
+  a lock with tickets granted on the fast path takes time proportional
+  to the number of connections.
+
+  @pre m_rwlock is write-locked.
+*/
+
+void MDL_lock::materialize_fast_path()
+{
+  mysql_rwlock_rdlock(&LOCK_mdl_fast_path);
+  for (MDL_context &ctx : mdl_fast_path_contexts)
+    materialize_fast_path(&ctx);
+  mysql_rwlock_unlock(&LOCK_mdl_fast_path);
+}
+
+
+/**
+  @return the number of the tickets granted on the fast path
+
+  A context which is backing off in
+  MDL_context::try_acquire_lock_fast_path() may be counted.
+*/
+
+uint32 MDL_lock::fast_path_granted() const
+{
+  uint32 n= 0;
+  for (const fast_path_slot &slot : m_fast_path_granted)
+    n+= slot.granted.load();
+  return n;
+}
+
+
+/**
+  Remove the lock from MDL_map after the last ticket that was granted
+  on the fast path was released, like remove_ticket() does on the slow
+  path.
+
+  @pre m_rwlock is not locked, and the lock is pinned.
+*/
+
+void MDL_lock::remove_if_unused(LF_PINS *pins)
+{
+  if (key.mdl_namespace() == MDL_key::BACKUP)
+    return;
+  mysql_prlock_wrlock(&m_rwlock);
+  if (is_empty() && !m_fast_path_state.load(std::memory_order_relaxed) &&
+      !fast_path_granted())
+    mdl_locks.remove(pins, this);
+  else
+    mysql_prlock_unlock(&m_rwlock);
+}
+
+
 MDL_wait_for_graph_visitor::~MDL_wait_for_graph_visitor()
 = default;
 
@@ -2026,6 +2303,7 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       is no need to release it.
     */
     DBUG_ASSERT(! ticket->m_lock->is_empty());
+    ticket->m_lock->update_fast_path_state();
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -2110,13 +2388,6 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
-  /* The below call implicitly locks MDL_lock::m_rwlock on success. */
-  if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
-  {
-    MDL_ticket::destroy(ticket);
-    return TRUE;
-  }
-
   DBUG_ASSERT(ticket->m_psi == NULL);
   ticket->m_psi= mysql_mdl_create(ticket,
                                   &mdl_request->key,
@@ -2126,8 +2397,32 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                   mdl_request->m_src_file,
                                   mdl_request->m_src_line);
 
+  const MDL_lock::bitmap_t fast_path_types=
+    MDL_lock::fast_path_types(key->mdl_namespace());
+
+  if ((MDL_BIT(mdl_request->type) & fast_path_types) &&
+      try_acquire_lock_fast_path(ticket, key))
+  {
+    if (metadata_lock_info_plugin_loaded)
+      ticket->m_time= microsecond_interval_timer();
+    m_tickets[mdl_request->duration].push_front(ticket);
+    mdl_request->ticket= ticket;
+    mysql_mdl_set_status(ticket->m_psi, MDL_ticket::GRANTED);
+    return FALSE;
+  }
+
+  /* The below call implicitly locks MDL_lock::m_rwlock on success. */
+  if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
+  {
+    MDL_ticket::destroy(ticket);
+    return TRUE;
+  }
+
   ticket->m_lock= lock;
 
+  if (fast_path_types && !(MDL_BIT(mdl_request->type) & fast_path_types))
+    lock->block_fast_path();
+
   if (lock->can_grant_lock(mdl_request->type, this, false))
   {
     if (metadata_lock_info_plugin_loaded)
@@ -2149,6 +2444,91 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
 }
 
 
+/**
+  Try to grant a lock of a type in MDL_lock::fast_path_types() without
+  write-locking MDL_lock::m_rwlock.
+
+  The ticket is added to the list of the tickets of this context which
+  were granted on the fast path, so that only this context modifies any
+  shared data in the common case. Contexts requesting locks of other
+  types move such tickets to MDL_lock::m_granted in
+  MDL_lock::block_fast_path().
+
+  The MDL_lock is still looked up in MDL_map, and the number of the tickets
+  granted on the fast path is incremented here and decremented in
+  release_lock(), so that a lock which is not used anymore is removed from
+  MDL_map. It is counted in the MDL_lock::m_fast_path_granted slot of this
+  context, which only a few other contexts share. What is avoided is
+  write-locking MDL_lock::m_rwlock and updating MDL_lock::m_granted.
+
+  @param ticket  Ticket for the request
+  @param key     Key of the lock
+
+  @retval TRUE   The lock was granted.
+  @retval FALSE  The lock must be acquired on the slow path.
+*/
+
+bool
+MDL_context::try_acquire_lock_fast_path(MDL_ticket *ticket, const MDL_key *key)
+{
+  if (!m_fast_path_registered)
+  {
+    mysql_rwlock_wrlock(&LOCK_mdl_fast_path);
+    mdl_fast_path_contexts.push_back(*this);
+    mysql_rwlock_unlock(&LOCK_mdl_fast_path);
+    m_fast_path_slot= mdl_fast_path_registrations++ % MDL_lock::FAST_PATH_SLOTS;
+    m_fast_path_registered= true;
+  }
+
+  for (;;)
+  {
+    MDL_lock *lock= mdl_locks.find_or_insert_pinned(m_pins, key);
+    if (!lock)
+      return FALSE;
+
+    std::atomic<uint32> &granted_here=
+      lock->m_fast_path_granted[m_fast_path_slot].granted;
+    mysql_mutex_lock(&m_LOCK_fast_path);
+    /*
+      Count the ticket before checking the flags. MDL_lock::block_fast_path()
+      and MDL_map::remove() set the flags before summing the counts, so
+      that one of us will notice the other.
+    */
+    granted_here.fetch_add(1);
+    const uint32 state= lock->m_fast_path_state.load();
+    const bool granted= !(state & (MDL_lock::FAST_PATH_BLOCKED |
+                                   MDL_lock::FAST_PATH_DESTROYED));
+    if (granted)
+    {
+      /*
+        The ticket keeps the lock in MDL_map until it is released or
+        MDL_lock::block_fast_path() moves it to m_granted.
+      */
+      ticket->m_lock= lock;
+      ticket->m_fast_path= true;
+      m_fast_path_tickets.push_back(*ticket);
+    }
+    else
+      granted_here.fetch_sub(1);
+    mysql_mutex_unlock(&m_LOCK_fast_path);
+
+    if (state & MDL_lock::FAST_PATH_DESTROYED)
+    {
+      /*
+        MDL_map::remove() may have seen our count and kept the lock,
+        which nobody else would remove then.
+      */
+      lock->remove_if_unused(m_pins);
+      mdl_locks.unpin(m_pins, lock);
+      /* Retry if the lock was removed from MDL_map after we found it. */
+      continue;
+    }
+    mdl_locks.unpin(m_pins, lock);
+    return granted;
+  }
+}
+
+
 /**
   Create a copy of a granted ticket.
   This is used to make sure that HANDLER ticket
@@ -2327,6 +2707,7 @@ MDL_context::acquire_lock(MDL_request *mdl_request, double lock_wait_timeout)
   if (lock_wait_timeout == 0)
   {
     DBUG_PRINT("mdl", ("Nowait:  %s", ticket_msg));
+    lock->update_fast_path_state();
     mysql_prlock_unlock(&lock->m_rwlock);
     MDL_ticket::destroy(ticket);
     my_error(ER_LOCK_WAIT_TIMEOUT, MYF(0));
@@ -2651,6 +3032,7 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
 
   /* Merge the acquired and the original lock. @todo: move to a method. */
   mysql_prlock_wrlock(&mdl_ticket->m_lock->m_rwlock);
+  mdl_ticket->m_lock->materialize_fast_path(this);
   if (is_new_ticket)
     mdl_ticket->m_lock->m_granted.remove_ticket(mdl_xlock_request.ticket);
   /*
@@ -2933,7 +3315,33 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
   DBUG_ASSERT(this == ticket->get_ctx());
   DBUG_PRINT("mdl", ("Released: %s", dbug_print_mdl(ticket)));
 
-  lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
+  bool fast_path= false;
+  if (MDL_BIT(ticket->m_type) &
+      MDL_lock::fast_path_types(lock->key.mdl_namespace()))
+  {
+    /* The lock may be removed from MDL_map once our ticket is gone. */
+    mdl_locks.pin(m_pins, lock);
+    uint32 granted_here= 0;
+    mysql_mutex_lock(&m_LOCK_fast_path);
+    if ((fast_path= ticket->m_fast_path))
+    {
+      m_fast_path_tickets.remove(*ticket);
+      ticket->m_fast_path= false;
+      granted_here=
+        lock->m_fast_path_granted[m_fast_path_slot].granted.fetch_sub(1) - 1;
+    }
+    mysql_mutex_unlock(&m_LOCK_fast_path);
+    /*
+      Remove the lock from MDL_map if this was the last ticket. Another
+      context which shares our slot will check that on its release.
+    */
+    if (fast_path && !granted_here && !lock->fast_path_granted())
+      lock->remove_if_unused(m_pins);
+    mdl_locks.unpin(m_pins, lock);
+  }
+
+  if (!fast_path)
+    lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -3051,6 +3459,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
                 m_type == MDL_BACKUP_WAIT_FLUSH)));
 
   mysql_prlock_wrlock(&m_lock->m_rwlock);
+  m_lock->materialize_fast_path(m_ctx);
   /*
     To update state of MDL_lock object correctly we need to temporarily
     exclude ticket from the granted queue and then include it back.
@@ -3058,6 +3467,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   m_lock->m_granted.remove_ticket(this);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
+  m_lock->update_fast_path_state();
   m_lock->reschedule_waiters();
   mysql_prlock_unlock(&m_lock->m_rwlock);
   DBUG_VOID_RETURN;
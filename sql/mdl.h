@@ -748,6 +748,7 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
                          PRE_ACQUIRE_NOTIFY, POST_RELEASE_NOTIFY };
 private:
   friend class MDL_context;
+  friend class MDL_lock;
 
   MDL_ticket(MDL_context *ctx_arg, enum_mdl_type type_arg
 #ifndef DBUG_OFF
@@ -762,12 +763,14 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
      m_type(type_arg),
      m_ctx(ctx_arg),
      m_lock(NULL),
-     m_psi(NULL)
+     m_psi(NULL),
+     m_fast_path(false)
   {}
 
   virtual ~MDL_ticket()
   {
     DBUG_ASSERT(m_psi == NULL);
+    DBUG_ASSERT(!m_fast_path);
   }
 
   static MDL_ticket *create(MDL_context *ctx_arg, enum_mdl_type type_arg
@@ -792,6 +795,13 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
 
   PSI_metadata_lock *m_psi;
 
+  /**
+    TRUE if the lock was granted on the fast path, and the ticket is in
+    MDL_context::m_fast_path_tickets instead of MDL_lock::m_granted.
+    Protected by MDL_context::m_LOCK_fast_path of m_ctx.
+  */
+  bool m_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -875,7 +885,7 @@ typedef I_P_List<MDL_request, I_P_List_adapter<MDL_request,
   connection has such a context.
 */
 
-class MDL_context
+class MDL_context : public ilist_node<>
 {
 public:
   typedef I_P_List<MDL_ticket,
@@ -1063,13 +1073,35 @@ class MDL_context
   MDL_wait_for_subgraph *m_waiting_for;
   LF_PINS *m_pins;
   uint m_deadlock_overweight;
+  /**
+    Tickets of this context which were granted on the fast path, without
+    write-locking MDL_lock::m_rwlock and entering MDL_lock::m_granted.
+    Other contexts move them to MDL_lock::m_granted when they need to
+    see all granted tickets of a lock.
+  */
+  ilist<MDL_ticket> m_fast_path_tickets;
+  /**
+    Mutex protecting m_fast_path_tickets and MDL_ticket::m_fast_path.
+    Other threads only acquire it in MDL_lock::materialize_fast_path().
+  */
+  mysql_mutex_t m_LOCK_fast_path;
+  /** TRUE if the context is in the list of the contexts using the fast path */
+  bool m_fast_path_registered;
+  /**
+    Which of MDL_lock::m_fast_path_granted counts the tickets of this context
+    which were granted on the fast path. Assigned on registration.
+  */
+  uint m_fast_path_slot;
 private:
+  friend class MDL_lock;
+
   MDL_ticket *find_ticket(MDL_request *mdl_req,
                           enum_mdl_duration *duration);
   void release_locks_stored_before(enum_mdl_duration duration, MDL_ticket *sentinel);
   void release_lock(enum_mdl_duration duration, MDL_ticket *ticket);
   bool try_acquire_lock_impl(MDL_request *mdl_request,
                              MDL_ticket **out_ticket);
+  bool try_acquire_lock_fast_path(MDL_ticket *ticket, const MDL_key *key);
   bool fix_pins();
 
 public:
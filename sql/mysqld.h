@@ -70,6 +70,7 @@ enum enum_slave_parallel_mode {
   SLAVE_PARALLEL_NONE,
   SLAVE_PARALLEL_MINIMAL,
   SLAVE_PARALLEL_CONSERVATIVE,
+  SLAVE_PARALLEL_DEPENDENCY,
   SLAVE_PARALLEL_OPTIMISTIC,
   SLAVE_PARALLEL_AGGRESSIVE
 };
@@ -315,6 +316,7 @@ extern PSI_mutex_key key_PAGE_lock, key_LOCK_sync, key_LOCK_active,
 
 extern PSI_mutex_key key_BINLOG_LOCK_index, key_BINLOG_LOCK_xid_list,
   key_BINLOG_LOCK_binlog_background_thread,
+  key_BINLOG_LOCK_binlog_sync,
   key_LOCK_binlog_end_pos,
   key_delayed_insert_mutex, key_hash_filo_lock, key_LOCK_active_mi,
   key_LOCK_crypt, key_LOCK_delayed_create,
@@ -932,6 +934,7 @@ extern my_bool opt_master_verify_checksum;
 extern my_bool opt_stack_trace, disable_log_notes;
 extern my_bool opt_expect_abort;
 extern my_bool opt_slave_sql_verify_checksum;
+extern my_bool opt_slave_prefetch_rows;
 extern my_bool opt_mysql56_temporal_format, strict_password_validation;
 extern ulong binlog_checksum_options;
 extern bool max_user_connections_checking;
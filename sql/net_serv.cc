@@ -118,6 +118,12 @@ extern my_bool thd_net_is_killed(THD *thd);
 
 
 static my_bool net_write_buff(NET *, const uchar *, size_t len);
+static my_bool net_write_packet_buff(NET *net, const uchar *header,
+                                     const uchar *packet, size_t len);
+#ifndef _WIN32
+static my_bool net_real_writev(NET *, const uchar *header, size_t header_len,
+                               const uchar *packet, size_t len);
+#endif
 
 my_bool net_allocate_new_packet(NET *net, void *thd, uint my_flags);
 
@@ -427,8 +433,7 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
     const ulong z_size = MAX_PACKET_LENGTH;
     int3store(buff, z_size);
     buff[3]= (uchar) net->pkt_nr++;
-    if (net_write_buff(net, buff, NET_HEADER_SIZE) ||
-	net_write_buff(net, packet, z_size))
+    if (net_write_packet_buff(net, buff, packet, z_size))
     {
       MYSQL_NET_WRITE_DONE(1);
       return 1;
@@ -439,15 +444,10 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
   /* Write last packet */
   int3store(buff,len);
   buff[3]= (uchar) net->pkt_nr++;
-  if (net_write_buff(net, buff, NET_HEADER_SIZE))
-  {
-    MYSQL_NET_WRITE_DONE(1);
-    return 1;
-  }
 #ifndef DEBUG_DATA_PACKETS
   DBUG_DUMP("packet_header", buff, NET_HEADER_SIZE);
 #endif
-  my_bool rc= MY_TEST(net_write_buff(net, packet, len));
+  my_bool rc= MY_TEST(net_write_packet_buff(net, buff, packet, len));
   MYSQL_NET_WRITE_DONE(rc);
   return rc;
 }
@@ -581,6 +581,17 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 #endif
   if (len > left_length)
   {
+#ifndef _WIN32
+    if (!net->compress && net->vio->writev)
+    {
+      /*
+        Send the buffered data and the packet together, instead of
+        copying the packet to the write buffer first. This saves the
+        copy, which matters for big rows of result sets.
+      */
+      return net_real_writev(net, NULL, 0, packet, len);
+    }
+#endif
     if (net->write_pos != net->buff)
     {
       /* Fill up already used packet and write it */
@@ -618,6 +629,154 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 }
 
 
+/**
+  Write a packet header and the packet to the write buffer, like
+  net_write_buff() of each of them.
+
+  If they do not fit in the buffer, the buffered data, the header and
+  the packet are sent with one writev call, so that the header is
+  neither copied nor sent separately.
+
+  @param net		Network handler
+  @param header	Packet header of NET_HEADER_SIZE bytes
+  @param packet	Packet to send
+  @param len		Length of packet
+
+  @retval
+    0	ok
+  @retval
+    1	error
+*/
+
+static my_bool
+net_write_packet_buff(NET *net, const uchar *header,
+                      const uchar *packet, size_t len)
+{
+#ifndef _WIN32
+  if (!net->compress && net->vio->writev &&
+      NET_HEADER_SIZE + len > (size_t) (net->buff_end - net->write_pos))
+    return net_real_writev(net, header, NET_HEADER_SIZE, packet, len);
+#endif
+  return net_write_buff(net, header, NET_HEADER_SIZE) ||
+         net_write_buff(net, packet, len);
+}
+
+
+/**
+  Mark the connection as unusable after a failed write.
+
+  @param interrupted  whether the write was interrupted by a timeout
+  @param left         the number of bytes that could not be written
+*/
+
+static void net_write_error(NET *net, bool interrupted, size_t left)
+{
+  EXTRA_DEBUG_fprintf(stderr,
+                      "%s: write looped on vio with state %d, aborting thread\n",
+                      my_progname, (int) net->vio->type);
+  net->error= 2;				/* Close socket */
+  net->last_errno= (interrupted ? ER_NET_WRITE_INTERRUPTED :
+                    ER_NET_ERROR_ON_WRITE);
+#ifdef MYSQL_SERVER
+  if (global_system_variables.log_warnings > 3)
+  {
+    sql_print_warning("Could not write packet: fd: %lld  state: %d  "
+                      "errno: %d  vio_errno: %d  length: %ld",
+                      (longlong) vio_fd(net->vio), (int) net->vio->state,
+                      vio_errno(net->vio), net->last_errno, (ulong) left);
+  }
+#endif
+  MYSQL_SERVER_my_error(net->last_errno, MYF(0));
+}
+
+
+#ifndef _WIN32
+/**
+  Send the contents of the write buffer followed by an optional header
+  and a packet with one system call, without copying them to the write
+  buffer. The write buffer is empty afterwards.
+
+  Can only be used without compression, and if the vio supports
+  vio_writev().
+
+  @retval 0 ok
+  @retval 1 error
+*/
+
+static my_bool net_real_writev(NET *net, const uchar *header,
+                               size_t header_len,
+                               const uchar *packet, size_t len)
+{
+  struct iovec iov[3], *io= iov;
+  int iovcnt= 0;
+  uint retry_count= 0;
+  size_t left= header_len + len + (size_t) (net->write_pos - net->buff);
+  DBUG_ENTER("net_real_writev");
+  DBUG_ASSERT(!net->compress);
+
+  if (net->write_pos != net->buff)
+  {
+    iov[iovcnt].iov_base= net->buff;
+    iov[iovcnt++].iov_len= (size_t) (net->write_pos - net->buff);
+  }
+  if (header_len)
+  {
+    iov[iovcnt].iov_base= (void*) header;
+    iov[iovcnt++].iov_len= header_len;
+  }
+  iov[iovcnt].iov_base= (void*) packet;
+  iov[iovcnt++].iov_len= len;
+  net->write_pos= net->buff;
+
+#if defined(MYSQL_SERVER)
+  THD *thd= (THD *)net->thd;
+#if defined(USE_QUERY_CACHE)
+  for (int i= 0; i < iovcnt; i++)
+    query_cache_insert(thd, (char*) iov[i].iov_base, iov[i].iov_len,
+                       net->pkt_nr);
+#endif
+  if (likely(thd))
+    thd->async_state.wait_for_pending_ops();
+#endif
+
+  if (unlikely(net->error == 2))
+    DBUG_RETURN(1);				/* socket can't be used */
+
+  net->reading_or_writing=2;
+#ifdef DEBUG_DATA_PACKETS
+  for (int i= 0; i < iovcnt; i++)
+    DBUG_DUMP("data_written", (uchar*) iov[i].iov_base, iov[i].iov_len);
+#endif
+  while (left)
+  {
+    size_t length= vio_writev(net->vio, io, iovcnt);
+    if (ssize_t(length) <= 0)
+    {
+      bool interrupted= vio_should_retry(net->vio);
+      if (interrupted || !length)
+      {
+        if (retry_count++ < net->retry_count)
+          continue;
+      }
+      net_write_error(net, interrupted, left);
+      break;
+    }
+    left-= length;
+    update_statistics(thd_increment_bytes_sent(net->thd, length));
+    if (!left)
+      break;
+    /* Skip the buffers that were written completely */
+    for (; length >= io->iov_len; io++, iovcnt--)
+      length-= io->iov_len;
+    io->iov_base= (uchar*) io->iov_base + length;
+    io->iov_len-= length;
+  }
+  net->reading_or_writing= 0;
+  DBUG_RETURN(left != 0);
+}
+#endif /* !_WIN32 */
+
+
 /**
   Read and write one packet using timeouts.
   If needed, the packet is compressed before sending.
@@ -700,23 +859,7 @@ net_real_write(NET *net,const uchar *packet, size_t len)
         if (retry_count++ < net->retry_count)
           continue;
       }
-      EXTRA_DEBUG_fprintf(stderr,
-                          "%s: write looped on vio with state %d, aborting thread\n",
-                          my_progname, (int) net->vio->type);
-      net->error= 2;				/* Close socket */
-      net->last_errno= (interrupted ? ER_NET_WRITE_INTERRUPTED :
-                        ER_NET_ERROR_ON_WRITE);
-#ifdef MYSQL_SERVER
-      if (global_system_variables.log_warnings > 3)
-      {
-        sql_print_warning("Could not write packet: fd: %lld  state: %d  "
-                          "errno: %d  vio_errno: %d  length: %ld",
-                          (longlong) vio_fd(net->vio), (int) net->vio->state,
-                          vio_errno(net->vio), net->last_errno,
-                          (ulong) (end-pos));
-      }
-#endif
-      MYSQL_SERVER_my_error(net->last_errno, MYF(0));
+      net_write_error(net, interrupted, (size_t) (end - pos));
       break;
     }
     pos+=length;
@@ -186,5 +186,8 @@
 #define DISK_TEMPTABLE_LOOKUP_COST(thd) (tmp_table_optimizer_costs.key_lookup_cost + tmp_table_optimizer_costs.row_lookup_cost + tmp_table_optimizer_costs.row_copy_cost)
 #define DISK_TEMPTABLE_CREATE_COST TMPFILE_CREATE_COST*2 // 2 tmp tables
 #define DISK_TEMPTABLE_BLOCK_SIZE  IO_SIZE
+/* In-memory hash table of GROUP BY groups, see Group_by_hash */
+#define HASH_GROUP_BY_CREATE_COST   0.001 // ms
+#define HASH_GROUP_BY_LOOKUP_COST  (0.00004)
 
 #endif /* OPTIMIZER_DEFAULTS_INCLUDED */
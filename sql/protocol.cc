@@ -1469,6 +1469,42 @@ bool Protocol_text::store_numeric_string_aux(const char *from, size_t length)
 }
 
 
+/**
+  Store an integer as text. When no character set conversion is needed,
+  the digits are written directly to the packet instead of being copied
+  there from a temporary buffer.
+
+  @param radix  10 for an unsigned value, -10 for a signed one
+*/
+
+bool Protocol_text::store_integer(longlong from, int radix)
+{
+#ifndef EMBEDDED_LIBRARY
+  CHARSET_INFO *tocs= thd->variables.character_set_results;
+  // Protocol_local overrides net_store_data()
+  if (!(tocs && (tocs->state & MY_CS_NONASCII)) &&
+      likely(type() == PROTOCOL_TEXT))
+  {
+    /*
+      At most 20 digits and the sign, so the length fits in 1 byte;
+      longlong10_to_str() also writes the terminating 0
+    */
+    if (packet->reserve(1 + 21 + 1, PACKET_BUFFER_EXTRA_ALLOC))
+      return true;
+    char *to= (char*) packet->end();
+    size_t length= (size_t) (longlong10_to_str(from, to + 1, radix) -
+                             (to + 1));
+    to[0]= (char) length;
+    packet->length(packet->length() + 1 + (uint32) length);
+    return false;
+  }
+#endif
+  char buff[22];
+  size_t length= (size_t) (longlong10_to_str(from, buff, radix) - buff);
+  return store_numeric_string_aux(buff, length);
+}
+
+
 bool Protocol::store_warning(const char *from, size_t length)
 {
   BinaryStringBuffer<MYSQL_ERRMSG_SIZE> tmp;
@@ -1517,9 +1553,7 @@ bool Protocol_text::store_tiny(longlong from)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_TINY));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (int10_to_str((int) from, buff, -10) - buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer((int) from, -10);
 }
 
 
@@ -1529,9 +1563,7 @@ bool Protocol_text::store_short(longlong from)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_SHORT));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (int10_to_str((int) from, buff, -10) - buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer((int) from, -10);
 }
 
 
@@ -1541,10 +1573,7 @@ bool Protocol_text::store_long(longlong from)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_LONG));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (int10_to_str((long int)from, buff,
-                                        (from < 0) ? - 10 : 10) - buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer(from, (from < 0) ? -10 : 10);
 }
 
 
@@ -1554,11 +1583,7 @@ bool Protocol_text::store_longlong(longlong from, bool unsigned_flag)
   DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_LONGLONG));
   field_pos++;
 #endif
-  char buff[22];
-  size_t length= (size_t) (longlong10_to_str(from, buff,
-                                             unsigned_flag ? 10 : -10) -
-                           buff);
-  return store_numeric_string_aux(buff, length);
+  return store_integer(from, unsigned_flag ? 10 : -10);
 }
 
 
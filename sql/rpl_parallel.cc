@@ -3463,7 +3463,23 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     {
       uint8 flags= gco->flags;
 
-      if (mode <= SLAVE_PARALLEL_MINIMAL ||
+      if (mode == SLAVE_PARALLEL_DEPENDENCY &&
+          (gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_DEPENDENCY) &&
+          /* Only then is every event group in e of the same domain */
+          rli->mi->using_gtid != Master_info::USE_GTID_NO)
+      {
+        /*
+          The master recorded the last earlier event group that this one may
+          conflict with. If that is in an earlier batch, it will have started
+          to commit before this batch starts, so we can run in parallel with
+          the current batch.
+        */
+        if (gtid_ev->dependency_seq_no >= e->gco_first_seq_no ||
+            gtid_ev->seq_no <= e->last_seq_no ||
+            (gtid_flags & Gtid_log_event::FL_DDL))
+          flags|= group_commit_orderer::MULTI_BATCH;
+      }
+      else if (mode <= SLAVE_PARALLEL_MINIMAL ||
           !(gtid_flags & Gtid_log_event::FL_GROUP_COMMIT_ID) ||
           e->last_commit_id != gtid_ev->commit_id ||
           /*
@@ -3533,6 +3549,7 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       e->last_commit_id= gtid_ev->commit_id;
     else
       e->last_commit_id= 0;
+    e->last_seq_no= gtid_ev->seq_no;
 
     if (new_gco)
     {
@@ -3557,7 +3574,10 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       }
       gco->flags|= force_switch_flag;
       e->current_gco= gco;
+      e->gco_first_seq_no= gtid_ev->seq_no;
     }
+    else
+      set_if_smaller(e->gco_first_seq_no, gtid_ev->seq_no);
     rgi->gco= gco;
 
     qev->rgi= e->current_group_info= rgi;
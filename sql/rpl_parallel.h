@@ -375,6 +375,12 @@ struct rpl_parallel_entry {
   */
   uint32 need_sub_id_signal;
   uint64 last_commit_id;
+  /*
+    For --slave-parallel-mode=dependency, the smallest seq_no of an event
+    group in current_gco, and the seq_no of the last event group queued.
+  */
+  uint64 gco_first_seq_no;
+  uint64 last_seq_no;
   uint32 pending_start_alters;
   bool active;
   /*
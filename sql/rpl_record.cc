@@ -515,6 +515,80 @@ int unpack_row(const rpl_group_info *rgi, TABLE *table, uint const colcnt,
   DBUG_RETURN(0);
 }
 
+/**
+   Unpack some columns of a row into @c table->record[0].
+
+   Like unpack_row(), but only the columns in @c unpack_cols are
+   unpacked; the other columns of the row are skipped without decoding
+   them. Default values and virtual columns are not computed. This is
+   enough to build a key of the row, as Rows_log_event::prefetch_rows()
+   does.
+
+   @param unpack_cols  the columns of @c table to unpack, or NULL to
+                       only skip the row
+
+   @retval 0 No error
+   @retval HA_ERR_CORRUPT_EVENT
+   Found error when trying to unpack fields.
+ */
+
+int unpack_row_columns(const rpl_group_info *rgi, TABLE *table,
+                       uint const colcnt, uchar const *const row_data,
+                       MY_BITMAP const *cols, MY_BITMAP const *unpack_cols,
+                       uchar const **const current_row_end,
+                       uchar const *const row_end)
+{
+  DBUG_ENTER("unpack_row_columns");
+  DBUG_ASSERT(row_data);
+
+  Unpack_record_state st(row_data, row_end, (bitmap_bits_set(cols) + 7) / 8);
+
+  if (bitmap_is_clear_all(cols))
+  {
+    *current_row_end= st.pack_ptr;
+    DBUG_RETURN(0);
+  }
+
+  Rpl_table_data rpl_data= *(RPL_TABLE_LIST*)table->pos_in_table_list;
+  DBUG_ASSERT(!rpl_data.is_online_alter());
+  const table_def *tabledef= rpl_data.tabledef;
+  const TABLE *conv_table= rpl_data.conv_table;
+
+  st.next_null_byte();
+  uint max_cols= MY_MIN(tabledef->size(), cols->n_bits);
+  for (uint i= 0; i < max_cols; i++)
+  {
+    if (!bitmap_is_set(cols, i))
+      continue;
+    if (unpack_cols && i < colcnt && i < table->s->fields &&
+        bitmap_is_set(unpack_cols, i))
+    {
+      Field *const result_field= table->field[i];
+      Field *conv_field= conv_table ? conv_table->field[i] : NULL;
+      Field *const f= conv_field ? conv_field : result_field;
+      if (!unpack_field(tabledef, f, &st, i))
+        DBUG_RETURN(HA_ERR_CORRUPT_EVENT);
+      if (conv_field)
+        convert_field(f, result_field, conv_field);
+      continue;
+    }
+
+    /* Skip the column, like the extra columns of the master in unpack_row() */
+    if ((st.null_mask & 0xFF) == 0)
+      st.next_null_byte();
+    if (!((st.null_bits & st.null_mask) && tabledef->maybe_null(i)))
+    {
+      st.pack_ptr+= tabledef->calc_field_size(i, (uchar *) st.pack_ptr);
+      if (st.pack_ptr > row_end)
+        DBUG_RETURN(HA_ERR_CORRUPT_EVENT);
+    }
+    st.null_mask <<= 1;
+  }
+
+  *current_row_end= st.pack_ptr;
+  DBUG_RETURN(0);
+}
+
 /**
   Fills @c table->record[0] with default values.
 
@@ -0,0 +1,226 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+/**
+  @file
+
+  @brief
+  Writeset based dependency tracking, see rpl_writeset.h.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "sql_class.h"
+#include "rpl_writeset.h"
+#include <my_bit.h>
+
+ulong opt_binlog_dependency_tracking= BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER;
+ulong opt_binlog_dependency_history_size= 25000;
+
+
+/**
+  Check whether the conflicts on the rows of a table can be determined
+  from its unique keys, and compute the hash of the table name.
+  @return whether they cannot
+*/
+bool Binlog_writeset::add_table(TABLE *table)
+{
+  TABLE_SHARE *share= table->s;
+
+  /*
+    Without a primary key, two changes of the same row need not have any
+    key in common. Changes made by foreign key actions are not logged.
+  */
+  if (share->primary_key == MAX_KEY || !table->file->can_switch_engines())
+    return true;
+  for (uint k= 0; k < share->keys; k++)
+  {
+    KEY *key= &table->key_info[k];
+    if (!(key->flags & HA_NOSAME))
+      continue;
+    if (key->algorithm == HA_KEY_ALG_LONG_HASH)
+      return true;
+    for (uint p= 0; p < key->user_defined_key_parts; p++)
+    {
+      KEY_PART_INFO *part= &key->key_part[p];
+      /* Different values may conflict in a prefix key */
+      if ((part->key_part_flag & HA_PART_KEY_SEG) ||
+          !part->field->stored_in_db())
+        return true;
+    }
+  }
+
+  Hasher hasher;
+  hasher.add(&my_charset_bin, share->db.str, share->db.length);
+  hasher.add(&my_charset_bin, share->table_name.str, share->table_name.length);
+  m_table= table;
+  m_table_map_id= share->table_map_id;
+  m_table_hash= hasher.finalize();
+  return false;
+}
+
+
+/**
+  Add the unique keys of a record.
+  @param is_read     whether the record was read from the table
+  @param is_updated  whether the columns in the write_set were assigned
+  @return whether the conflicts of the record cannot be determined
+*/
+bool Binlog_writeset::add_record(TABLE *table, const uchar *record,
+                                 bool is_read, bool is_updated)
+{
+  const my_ptrdiff_t diff= record - table->record[0];
+  for (uint k= 0; k < table->s->keys; k++)
+  {
+    KEY *key= &table->key_info[k];
+    if (!(key->flags & HA_NOSAME))
+      continue;
+    Hasher hasher;
+    uchar key_nr[2];
+    int2store(key_nr, k);
+    hasher.add(&my_charset_bin, key_nr, sizeof key_nr);
+    uint p;
+    for (p= 0; p < key->user_defined_key_parts; p++)
+    {
+      Field *field= key->key_part[p].field;
+      /* A row that was read may lack the columns that were not needed */
+      if (is_read && !bitmap_is_set(table->read_set, field->field_index) &&
+          !(is_updated && bitmap_is_set(table->write_set, field->field_index)))
+        return true;
+      /* NULL values do not conflict in a unique key */
+      if (field->is_null_in_record(record))
+        break;
+      field->move_field_offset(diff);
+      field->hash_not_null(&hasher);
+      field->move_field_offset(-diff);
+    }
+    if (p < key->user_defined_key_parts)
+      continue;
+    if (m_keys.append((uint64) m_table_hash << 32 | hasher.finalize()))
+      return true;
+  }
+  return false;
+}
+
+
+void Binlog_writeset::add_row(TABLE *table, const uchar *before_record,
+                              const uchar *after_record)
+{
+  if (opt_binlog_dependency_tracking != BINLOG_DEPENDENCY_TRACKING_WRITESET)
+  {
+    /* The writeset would lack this row if the tracking is enabled later */
+    m_unsafe= true;
+    return;
+  }
+  if (m_unsafe)
+    return;
+  if ((m_table != table || m_table_map_id != table->s->table_map_id) &&
+      add_table(table))
+    return set_unsafe();
+  if ((before_record && add_record(table, before_record, true, false)) ||
+      (after_record &&
+       add_record(table, after_record, before_record != NULL, true)) ||
+      m_keys.elements() > opt_binlog_dependency_history_size)
+    set_unsafe();
+}
+
+
+void Binlog_writeset::clear()
+{
+  m_unsafe= false;
+  m_table= NULL;
+  /* Do not keep the memory of a large transaction */
+  if (m_keys.elements() > 1024)
+    m_keys.free_memory();
+  else
+    m_keys.clear();
+}
+
+
+void Writeset_history::reset(size_t size)
+{
+  m_used= 0;
+  if (size == m_size)
+  {
+    bzero(m_slots, m_size * sizeof *m_slots);
+    return;
+  }
+  my_free(m_slots);
+  m_size= 0;
+  if ((m_slots= (Slot*) my_malloc(PSI_INSTRUMENT_ME, size * sizeof *m_slots,
+                                  MYF(MY_ZEROFILL))))
+    m_size= size;
+}
+
+
+uint64 Writeset_history::add(uint32 domain_id, uint64 seq_no,
+                             const Binlog_writeset *writeset)
+{
+  const size_t limit= opt_binlog_dependency_history_size;
+  /* Keep the load factor at most 1/2 */
+  const size_t size= 2 * size_t{my_round_up_to_next_power((uint32) limit)};
+
+  if (!m_valid || domain_id != m_domain_id || seq_no <= m_last_seq_no)
+  {
+    /* We do not know what the earlier event groups of the domain changed */
+    reset(size);
+    m_valid= true;
+    m_domain_id= domain_id;
+    m_start_seq_no= m_last_seq_no= seq_no - 1;
+  }
+  else if (size != m_size ||
+           (writeset && m_used + writeset->elements() > limit))
+  {
+    reset(size);
+    m_start_seq_no= m_last_seq_no;
+  }
+
+  if (!writeset || writeset->is_unsafe() || !m_slots)
+  {
+    /* Everything after this event group depends on it */
+    m_start_seq_no= m_last_seq_no= seq_no;
+    return seq_no - 1;
+  }
+
+  uint64 dependency= m_start_seq_no;
+  for (size_t i= 0; i < writeset->elements(); i++)
+  {
+    const uint64 key= writeset->at(i) ? writeset->at(i) : 1;
+    size_t j= (size_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & (m_size - 1);
+    for (;; j= (j + 1) & (m_size - 1))
+    {
+      Slot *slot= &m_slots[j];
+      if (!slot->key)
+      {
+        slot->key= key;
+        slot->seq_no= seq_no;
+        m_used++;
+        break;
+      }
+      if (slot->key == key)
+      {
+        /* The same key may occur more than once in a writeset */
+        if (slot->seq_no != seq_no)
+        {
+          set_if_bigger(dependency, slot->seq_no);
+          slot->seq_no= seq_no;
+        }
+        break;
+      }
+    }
+  }
+  m_last_seq_no= seq_no;
+  return dependency;
+}
@@ -0,0 +1,153 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+#ifndef RPL_WRITESET_INCLUDED
+#define RPL_WRITESET_INCLUDED
+
+/**
+  @file
+
+  Writeset based dependency tracking for parallel replication.
+
+  With --binlog-transaction-dependency-tracking=WRITESET, every row that a
+  transaction changes is reduced to hashes of its unique keys (the
+  writeset of the transaction). When the transaction is written to the
+  binlog, its writeset is looked up in the writeset history, which maps
+  recently written keys to the seq_no of the last GTID that changed them.
+  The largest seq_no found is recorded in the GTID event as the
+  dependency of the event group: no earlier event group that it conflicts
+  with has a larger seq_no.
+
+  A slave with --slave-parallel-mode=dependency can then start the event
+  group as soon as its dependency has started to commit, without having
+  to guess (and roll back and retry on a conflict) like the optimistic
+  mode does.
+
+  Event groups whose conflicts cannot be determined from the row keys
+  (statement based events, tables without a primary key or with foreign
+  keys, DDL, XA) depend on the event group immediately before them.
+*/
+
+#include "sql_array.h"
+
+struct TABLE;
+
+enum enum_binlog_dependency_tracking
+{
+  BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER,
+  BINLOG_DEPENDENCY_TRACKING_WRITESET
+};
+
+extern ulong opt_binlog_dependency_tracking;
+extern ulong opt_binlog_dependency_history_size;
+
+
+/** The writeset of a transaction being written to a binlog cache */
+class Binlog_writeset
+{
+public:
+  Binlog_writeset()
+    : m_keys(PSI_INSTRUMENT_MEM, 16, 256), m_unsafe(false), m_table(NULL),
+      m_table_map_id(0), m_table_hash(0)
+  {}
+
+  /**
+    Add the unique keys of a changed row.
+    @param table          the table of the row
+    @param before_record  the row before the change, or NULL for an insert
+    @param after_record   the row after the change, or NULL for a delete
+  */
+  void add_row(TABLE *table, const uchar *before_record,
+               const uchar *after_record);
+
+  /** Forget the writeset of the current transaction */
+  void clear();
+
+  /**
+    @return whether the conflicts of the transaction with other
+    transactions cannot be determined from the writeset
+  */
+  bool is_unsafe() const { return m_unsafe; }
+
+  size_t elements() const { return m_keys.elements(); }
+  uint64 at(size_t i) const { return m_keys.at(i); }
+
+private:
+  void set_unsafe() { m_unsafe= true; m_keys.clear(); }
+  bool add_table(TABLE *table);
+  bool add_record(TABLE *table, const uchar *record, bool is_read,
+                  bool is_updated);
+
+  Dynamic_array<uint64> m_keys;
+  bool m_unsafe;
+  /** The table of the last add_row(), and the hash of its name */
+  TABLE *m_table;
+  ulonglong m_table_map_id;
+  uint32 m_table_hash;
+};
+
+
+/**
+  The keys written by recent transactions, and the seq_no of the last
+  GTID that wrote each of them. Protected by LOCK_log.
+*/
+class Writeset_history
+{
+public:
+  Writeset_history()
+    : m_slots(NULL), m_size(0), m_used(0), m_valid(false), m_domain_id(0),
+      m_start_seq_no(0), m_last_seq_no(0)
+  {}
+  ~Writeset_history() { my_free(m_slots); }
+
+  /**
+    Compute the dependency of an event group and add its writeset to the
+    history.
+    @param domain_id  the replication domain of the GTID
+    @param seq_no     the seq_no of the GTID
+    @param writeset   the writeset of the event group, or NULL if it has
+                      none, in which case it conflicts with everything
+    @return the largest seq_no of an earlier event group in the same
+    domain that the event group may conflict with
+  */
+  uint64 add(uint32 domain_id, uint64 seq_no,
+             const Binlog_writeset *writeset);
+
+  /** Forget the history, when an event group was written without it */
+  void invalidate() { m_valid= false; }
+
+private:
+  struct Slot
+  {
+    /** The hash of a key, 0 for a free slot */
+    uint64 key;
+    uint64 seq_no;
+  };
+
+  void reset(size_t size);
+
+  Slot *m_slots;
+  /** The number of slots, a power of 2 */
+  size_t m_size;
+  /** The number of used slots */
+  size_t m_used;
+  bool m_valid;
+  uint32 m_domain_id;
+  /** Every event group is assumed to conflict with this seq_no */
+  uint64 m_start_seq_no;
+  uint64 m_last_seq_no;
+};
+
+#endif /* RPL_WRITESET_INCLUDED */
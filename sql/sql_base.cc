@@ -1066,7 +1066,7 @@ void close_thread_table(THD *thd, TABLE **table_ptr)
   */
   MYSQL_UNBIND_TABLE(file);
 
-  tc_release_table(table);
+  tc_park_table(thd, table);
   DBUG_VOID_RETURN;
 }
 
@@ -9937,6 +9937,8 @@ int TABLE::unlock_hlindexes()
 {
   if (hlindex && hlindex->in_use)
   {
+    /* the statement ended without handler::ha_end_bulk_insert() */
+    (void) hlindexes_on_end_bulk_insert(true);
     hlindex->file->ha_external_unlock(in_use);
     hlindex->in_use= 0;
   }
@@ -9986,7 +9988,25 @@ int TABLE::hlindexes_on_delete_all(bool truncate)
   return 0;
 }
 
-int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
+void TABLE::hlindexes_on_start_bulk_insert()
+{
+  DBUG_ASSERT(s->hlindexes() <= 1);
+  if (s->hlindexes() && !hlindex_bulk_insert && !open_hlindexes_for_write())
+    hlindex_bulk_insert= mhnsw_start_bulk_insert(this, key_info + s->keys);
+}
+
+int TABLE::hlindexes_on_end_bulk_insert(bool abort)
+{
+  DBUG_ASSERT(s->hlindexes() == (hlindex != NULL));
+  if (!hlindex_bulk_insert)
+    return 0;
+  hlindex_bulk_insert= false;
+  DBUG_ASSERT(hlindex && hlindex->in_use);
+  return mhnsw_end_bulk_insert(this, key_info + s->keys, abort);
+}
+
+int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                              Item *cond, Rowid_filter *rowid_filter)
 {
   DBUG_ASSERT(s->hlindexes() == 1);
   DBUG_ASSERT(nr == s->keys);
@@ -9996,7 +10016,8 @@ int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
 
   DBUG_ASSERT(hlindex->in_use == in_use);
 
-  return mhnsw_read_first(this, key_info + s->keys, item, limit);
+  return mhnsw_read_first(this, key_info + s->keys, item, limit,
+                          cond, rowid_filter);
 }
 
 int TABLE::hlindex_read_next()
@@ -1275,9 +1275,9 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
 			 uint def_table_hash_size_arg)
   :query_cache_size(0),
    query_cache_limit(query_cache_limit_arg),
-   queries_in_cache(0), hits(0), inserts(0), refused(0),
-   total_blocks(0), lowmem_prunes(0),
-   m_cache_status(OK),
+   queries_in_cache(0), inserts(0), refused(0),
+   total_blocks(0), lowmem_prunes(0), hits(0),
+   m_cache_status(OK), table_filter_cs(0),
    min_allocation_unit(ALIGN_SIZE(min_allocation_unit_arg)),
    min_result_data_size(ALIGN_SIZE(min_result_data_size_arg)),
    def_query_hash_size(ALIGN_SIZE(def_query_hash_size_arg)),
@@ -1290,6 +1290,8 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
   set_if_bigger(min_allocation_unit,min_needed);
   this->min_allocation_unit= ALIGN_SIZE(min_allocation_unit);
   set_if_bigger(this->min_result_data_size,min_allocation_unit);
+  for (std::atomic<uint32> &counter : table_filter)
+    counter= 0;
 }
 
 
@@ -1687,6 +1689,21 @@ size_t build_normalized_name(char *buff, size_t bufflen,
 }
 
 
+/**
+  A copy of what send_result_to_client() needs of a Query_cache_table
+*/
+
+struct Query_cache_table_copy
+{
+  char *key;                                    // db name, table name, suffix
+  char *table_name;
+  uint32 key_length;
+  uint8 suffix_length;
+  qc_engine_callback callback;
+  ulonglong engine_data;
+};
+
+
 /*
   Check if the query is in the cache. If it was cached, send it
   to the user.
@@ -1715,7 +1732,8 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
   Query_cache_block *first_result_block;
 #endif
   Query_cache_block *result_block;
-  Query_cache_block_table *block_table, *block_table_end;
+  Query_cache_table_copy *tables;
+  TABLE_COUNTER_TYPE n_tables;
   size_t tot_length;
   Query_cache_query_flags flags;
   const char *sql, *sql_end, *found_brace= 0;
@@ -2037,16 +2055,45 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     BLOCK_UNLOCK_RD(query_block);
     goto err_unlock;
   }
-      
+
+  /*
+    Copy the tables of the query, so that they can be checked without
+    the structure lock: table blocks may be moved by pack_cache() then,
+    but the query block is neither moved nor freed while we hold its
+    read lock.
+  */
+  n_tables= query_block->n_tables;
+  if (!(tables= (Query_cache_table_copy*)
+        thd->alloc(n_tables * sizeof(Query_cache_table_copy))))
+  {
+    BLOCK_UNLOCK_RD(query_block);
+    goto err_unlock;
+  }
+  for (TABLE_COUNTER_TYPE i= 0; i < n_tables; i++)
+  {
+    Query_cache_table *table= query_block->table(i)->parent;
+    Query_cache_table_copy *copy= &tables[i];
+    if (!(copy->key= (char*) thd->memdup(table->db(), table->key_length())))
+    {
+      BLOCK_UNLOCK_RD(query_block);
+      goto err_unlock;
+    }
+    copy->table_name= copy->key + (table->table() - table->db());
+    copy->key_length= table->key_length();
+    copy->suffix_length= table->suffix_length();
+    copy->callback= table->callback();
+    copy->engine_data= table->engine_data();
+  }
+  move_to_query_list_end(query_block);
+  unlock();
+
   // Check access;
   THD_STAGE_INFO(thd, stage_checking_privileges_on_cached_query);
-  block_table= query_block->table(0);
-  block_table_end= block_table+query_block->n_tables;
-  for (; block_table != block_table_end; block_table++)
+  for (Query_cache_table_copy *table= tables; table != tables + n_tables;
+       table++)
   {
     TABLE_LIST table_list;
     TMP_TABLE_SHARE *tmptable;
-    Query_cache_table *table = block_table->parent;
 
     /*
       Check that we do not have temporary tables with same names as that of
@@ -2055,13 +2102,12 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
       query in query cache was made.
     */
     if ((tmptable=
-         thd->find_tmp_table_share_w_base_key((char *) table->data(),
-                                              table->key_length())))
+         thd->find_tmp_table_share_w_base_key(table->key,
+                                              table->key_length)))
     {
       DBUG_PRINT("qcache",
                  ("Temporary table detected: '%s.%s'",
                   tmptable->db.str, tmptable->table_name.str));
-      unlock();
       /*
         We should not store result of this query because it contain
         temporary tables => assign following variable to make check
@@ -2074,10 +2120,11 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     }
 
     bzero((char*) &table_list,sizeof(table_list));
-    table_list.db.str= table->db();
+    table_list.db.str= table->key;
     table_list.db.length= strlen(table_list.db.str);
-    table_list.alias.str= table_list.table_name.str= table->table();
-    table_list.alias.length= table_list.table_name.length= strlen(table->table());
+    table_list.alias.str= table_list.table_name.str= table->table_name;
+    table_list.alias.length= table_list.table_name.length=
+      strlen(table->table_name);
 
 #ifndef NO_EMBEDDED_ACCESS_CHECKS
     if (check_table_access(thd,SELECT_ACL,&table_list, FALSE, 1,TRUE))
@@ -2085,7 +2132,6 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
       DBUG_PRINT("qcache",
 		 ("probably no SELECT access to %s.%s =>  return to normal processing",
 		  table_list.db.str, table_list.alias.str));
-      unlock();
       thd->query_cache_is_applicable= 0;        // Query can't be cached
       thd->lex->safe_to_cache_query= 0;         // For prepared statements
       BLOCK_UNLOCK_RD(query_block);
@@ -2098,40 +2144,38 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
       BLOCK_UNLOCK_RD(query_block);
       thd->query_cache_is_applicable= 0;        // Query can't be cached
       thd->lex->safe_to_cache_query= 0;         // For prepared statements
-      goto err_unlock;				// Parse query
+      goto err_miss;				// Parse query
     }
 #endif /*!NO_EMBEDDED_ACCESS_CHECKS*/
-    engine_data= table->engine_data();
-    if (table->callback()) 
+    engine_data= table->engine_data;
+    if (table->callback)
     {
       char qcache_se_key_name[FN_REFLEN + 10];
-      size_t qcache_se_key_len, db_length= strlen(table->db());
-      engine_data= table->engine_data();
+      size_t qcache_se_key_len, db_length= table_list.db.length;
 
       qcache_se_key_len= build_normalized_name(qcache_se_key_name,
                                                sizeof(qcache_se_key_name),
-                                               table->db(),
+                                               table->key,
                                                db_length,
-                                               table->table(),
-                                               table->key_length() -
+                                               table->table_name,
+                                               table->key_length -
                                                db_length - 2 -
-                                               table->suffix_length(),
-                                               table->suffix_length());
-   
-      if (!(*table->callback())(thd, qcache_se_key_name,
-                                (uint)qcache_se_key_len, &engine_data))
+                                               table->suffix_length,
+                                               table->suffix_length);
+
+      if (!(*table->callback)(thd, qcache_se_key_name,
+                              (uint)qcache_se_key_len, &engine_data))
       {
         DBUG_PRINT("qcache", ("Handler does not allow caching for %.*s",
                               (int)qcache_se_key_len, qcache_se_key_name));
         BLOCK_UNLOCK_RD(query_block);
-        if (engine_data != table->engine_data())
+        if (engine_data != table->engine_data)
         {
           DBUG_PRINT("qcache",
                      ("Handler require invalidation queries of %.*s %llu-%llu",
                       (int)qcache_se_key_len, qcache_se_key_name,
-                      engine_data, table->engine_data()));
-          invalidate_table_internal((uchar *) table->db(),
-                                    table->key_length());
+                      engine_data, table->engine_data));
+          invalidate_table(thd, (uchar *) table->key, table->key_length);
         }
         else
         {
@@ -2148,17 +2192,15 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
         */
         DBUG_ASSERT(! thd->transaction_rollback_request);
         trans_rollback_stmt(thd);
-        goto err_unlock;				// Parse query
+        goto err_miss;				// Parse query
       }
     }
     else
       DBUG_PRINT("qcache", ("handler allow caching %s,%s",
 			    table_list.db.str, table_list.alias.str));
   }
-  move_to_query_list_end(query_block);
   hits++;
   query->increment_hits();
-  unlock();
 
   /*
     Send cached result to client
@@ -2212,6 +2254,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
 
 err_unlock:
   unlock();
+err_miss:
   MYSQL_QUERY_CACHE_MISS(thd->query());
   /*
     query_plan_flags doesn't have to be changed here as it contains
@@ -2755,6 +2798,7 @@ size_t Query_cache::init_cache()
                       &my_charset_bin : files_charset_info,
                       def_table_hash_size, 0,0, query_cache_table_get_key, 0,0);
 #endif
+  table_filter_cs= tables.charset;
 
   queries_in_cache = 0;
   queries_blocks = 0;
@@ -2835,6 +2879,8 @@ void Query_cache::free_cache()
   make_disabled();
   my_hash_free(&queries);
   my_hash_free(&tables);
+  for (std::atomic<uint32> &counter : table_filter)
+    counter= 0;
   DBUG_VOID_RETURN;
 }
 
@@ -3304,6 +3350,15 @@ void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
+  /*
+    Skip the lock if no cached query uses the table. A query that is
+    being cached registers its tables in insert_table() before it reads
+    them, so a change that was made before this check is either seen
+    by that query or the check sees its table.
+  */
+  if (table_filter_cs && !table_filter_counter(key, key_length))
+    return;
+
   /*
     Lock the query cache and queue all invalidation attempts to avoid
     the risk of a race between invalidation, cache inserts and flushes.
@@ -3577,6 +3632,8 @@ Query_cache::insert_table(THD *thd, size_t key_len, const char *key,
       free_memory_block(table_block);
       DBUG_RETURN(0);
     }
+    if (hash)
+      table_filter_counter((uchar*) key, key_len)++;
     char *db= header->db();
     header->table(db + db_length + 1);
     header->key_length((uint32)key_len);
@@ -3640,7 +3697,12 @@ void Query_cache::unlink_table(Query_cache_block_table *node)
                                &tables_blocks);
     Query_cache_table *header= table_block->table();
     if (header->is_hashed())
+    {
+      size_t key_length;
+      const uchar *key= query_cache_table_get_key(table_block, &key_length, 0);
+      table_filter_counter(key, key_length)--;
       my_hash_delete(&tables,(uchar *) table_block);
+    }
     free_memory_block(table_block);
   }
   DBUG_VOID_RETURN;
@@ -18,6 +18,8 @@
 
 #include "hash.h"
 #include "my_base.h"                            /* ha_rows */
+#include "my_counter.h"
+#include <atomic>
 
 class MY_LOCALE;
 struct TABLE_LIST;
@@ -66,6 +68,9 @@ typedef struct st_changed_table_list CHANGED_TABLE_LIST;
 #define QUERY_CACHE_PACK_ITERATION		2
 #define QUERY_CACHE_PACK_LIMIT			(512*1024L)
 
+/* number of counters of cached tables, see Query_cache::table_filter */
+#define QUERY_CACHE_TABLE_FILTER_SIZE		4096
+
 #define TABLE_COUNTER_TYPE uint
 
 struct Query_cache_block;
@@ -159,7 +164,8 @@ struct Query_cache_query
   unsigned int last_pkt_nr;
   uint8 tbls_type;
   uint8 ready;
-  ulonglong hit_count;
+  /* incremented without the structure lock */
+  Atomic_counter<ulonglong> hit_count;
 
   Query_cache_query() = default;                      /* Remove gcc warning */
   inline void init_n_lock();
@@ -303,8 +309,10 @@ class Query_cache
   /* Info */
   size_t query_cache_size, query_cache_limit;
   /* statistics */
-  size_t free_memory, queries_in_cache, hits, inserts, refused,
+  size_t free_memory, queries_in_cache, inserts, refused,
     free_memory_blocks, total_blocks, lowmem_prunes;
+  /* incremented without the structure lock */
+  Atomic_counter<size_t> hits;
 
 
 private:
@@ -321,6 +329,21 @@ class Query_cache
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(uchar *key, size_t key_length);
 
+  /**
+    The number of tables in the tables hash by the hash value of their
+    key. A table whose counter is 0 is not used by any cached query,
+    so invalidate_table() can skip it without locking the cache.
+  */
+  std::atomic<uint32> table_filter[QUERY_CACHE_TABLE_FILTER_SIZE];
+  /** The collation of the tables hash, for hashing the keys */
+  CHARSET_INFO *table_filter_cs;
+  std::atomic<uint32> &table_filter_counter(const uchar *key,
+                                            size_t key_length)
+  {
+    return table_filter[my_hash_sort(table_filter_cs, key, key_length) %
+                        QUERY_CACHE_TABLE_FILTER_SIZE];
+  }
+
 protected:
   /*
     The following mutex is locked when searching or changing global
@@ -735,6 +735,7 @@ THD::THD(my_thread_id id, bool is_wsrep_applier)
    main_da(0, false, false),
    m_stmt_da(&main_da),
    tdc_hash_pins(0),
+   parked_tables(0),
    xid_hash_pins(0),
    m_tmp_tables_locked(false),
    async_state()
@@ -1678,6 +1679,7 @@ void THD::cleanup(void)
 
   DBUG_ASSERT(open_tables == NULL);
   DBUG_ASSERT(m_transaction_psi == NULL);
+  tc_release_parked_tables(this);
 
   /*
     If the thread was in the middle of an ongoing transaction (rolled
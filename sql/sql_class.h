@@ -104,6 +104,7 @@ class Rows_log_event;
 class Sroutine_hash_entry;
 class user_var_entry;
 struct Trans_binlog_info;
+struct Parked_tables;
 class rpl_io_thread_info;
 class rpl_sql_thread_info;
 #ifdef HAVE_REPLICATION
@@ -5647,6 +5648,8 @@ class THD: public THD_count, /* this must be first */
 
 
   LF_PINS *tdc_hash_pins;
+  /** TABLE objects parked by this connection, see tc_park_table() */
+  Parked_tables *parked_tables;
   LF_PINS *xid_hash_pins;
   bool fix_xid_hash_pins();
 
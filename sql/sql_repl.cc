@@ -1050,13 +1050,14 @@ get_binlog_list(MEM_ROOT *memroot, bool reverse= true,
   to start at the very first GTID in domain D.
 */
 static bool
-contains_all_slave_gtid(slave_connection_state *st, Gtid_list_log_event *glev)
+contains_all_slave_gtid(slave_connection_state *st, const rpl_gtid *gtid_list,
+                        uint32 count)
 {
   uint32 i;
 
-  for (i= 0; i < glev->count; ++i)
+  for (i= 0; i < count; ++i)
   {
-    uint32 gl_domain_id= glev->list[i].domain_id;
+    uint32 gl_domain_id= gtid_list[i].domain_id;
     const rpl_gtid *gtid= st->find(gl_domain_id);
     if (!gtid)
     {
@@ -1066,15 +1067,15 @@ contains_all_slave_gtid(slave_connection_state *st, Gtid_list_log_event *glev)
       */
       return false;
     }
-    if (gtid->server_id == glev->list[i].server_id &&
-        gtid->seq_no <= glev->list[i].seq_no)
+    if (gtid->server_id == gtid_list[i].server_id &&
+        gtid->seq_no <= gtid_list[i].seq_no)
     {
       /*
         The slave needs to start after gtid, but it is contained in an earlier
         binlog file. So we need to search back further, unless it was the very
         last gtid logged for the domain in earlier binlog files.
       */
-      if (gtid->seq_no < glev->list[i].seq_no)
+      if (gtid->seq_no < gtid_list[i].seq_no)
         return false;
 
       /*
@@ -1087,7 +1088,7 @@ contains_all_slave_gtid(slave_connection_state *st, Gtid_list_log_event *glev)
         beginning of this group, per the special case explained in comment at
         the start of this function. If not, then we need to search back further.
       */
-      if (i+1 < glev->count && gl_domain_id == glev->list[i+1].domain_id)
+      if (i+1 < count && gl_domain_id == gtid_list[i+1].domain_id)
         return false;
     }
   }
@@ -1333,6 +1334,7 @@ gtid_check_binlog_file(slave_connection_state *state,
                        bool *found_in_index, uint32 *out_start_seek,
                        uint32 *found_count,
                        char *out_name, Gtid_list_log_event **out_glev,
+                       rpl_gtid **start_buf, uint32 *start_buf_alloc,
                        const char **out_errormsg)
 {
   Gtid_list_log_event *glev= nullptr;
@@ -1340,6 +1342,8 @@ gtid_check_binlog_file(slave_connection_state *state,
   File file;
   IO_CACHE cache;
   int res= -1;
+  int start_found;
+  uint32 start_count;
 
   *found_in_index= false;
   *out_glev= nullptr;
@@ -1356,8 +1360,30 @@ gtid_check_binlog_file(slave_connection_state *state,
     goto end;
   }
 
+  /*
+    If the GTID state at the start of the binlog file is known in memory, a
+    file that is too new can be skipped without opening it or its index.
+  */
+  start_found= Gtid_index_start_states::get(buf, start_buf, start_buf_alloc,
+                                            &start_count);
+  if (unlikely(start_found < 0))
+  {
+    *out_errormsg= "Out of memory while looking for GTID position in binlog";
+    goto end;
+  }
+  if (start_found && !contains_all_slave_gtid(state, *start_buf, start_count))
+  {
+    res= 1;
+    goto end;
+  }
+
   if (likely(reader && !reader->open_index_file(buf)))
   {
+    uint32 start_offset;
+    if (!start_found &&
+        reader->search_start_state(&start_offset, &start_count) > 0)
+      Gtid_index_start_states::add(buf, reader->search_gtid_list(),
+                                   start_count);
     int lookup= reader->search_gtid_pos(state, out_start_seek, found_count);
     reader->close_index_file();
     if (lookup >= 0)
@@ -1389,7 +1415,9 @@ gtid_check_binlog_file(slave_connection_state *state,
   if (unlikely(*out_errormsg))
     goto end;
 
-  if (!glev || contains_all_slave_gtid(state, glev))
+  if (glev && !start_found)
+    Gtid_index_start_states::add(buf, glev->list, glev->count);
+  if (!glev || contains_all_slave_gtid(state, glev->list, glev->count))
   {
     strmake(out_name, buf, FN_REFLEN);
     *out_glev= glev;
@@ -1445,6 +1473,8 @@ gtid_find_binlog_pos(slave_connection_state *state, char *out_name,
   Gtid_list_log_event *glev= NULL;
   const char *errormsg= NULL;
   Gtid_index_reader_hot *reader= NULL;
+  rpl_gtid *start_buf= NULL;
+  uint32 start_buf_alloc= 0;
   *found_in_index= false;
 
   init_alloc_root(PSI_INSTRUMENT_ME, &memroot,
@@ -1464,7 +1494,8 @@ gtid_find_binlog_pos(slave_connection_state *state, char *out_name,
     uint32 found_count;
     int res= gtid_check_binlog_file(state, reader, list, found_in_index,
                                     out_start_seek, &found_count,
-                                    out_name, &glev, &errormsg);
+                                    out_name, &glev, &start_buf,
+                                    &start_buf_alloc, &errormsg);
     if (res < 0)
       goto end;
     if (res == 0)
@@ -1558,6 +1589,7 @@ gtid_find_binlog_pos(slave_connection_state *state, char *out_name,
 
   if (reader)
     delete reader;
+  my_free(start_buf);
 
   free_root(&memroot, MYF(0));
   return errormsg;
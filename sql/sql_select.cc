@@ -61,6 +61,8 @@
 #include "sp_head.h"
 #include "sp_rcontext.h"
 #include "rowid_filter.h"
+#include "item_batch.h"
+#include "group_by_hash.h"
 #include "select_handler.h"
 #include "my_json_writer.h"
 #include "opt_trace.h"
@@ -215,7 +217,10 @@ static COND *optimize_cond(JOIN *join, COND *conds,
 bool const_expression_in_where(COND *conds,Item *item, Item **comp_item);
 static int do_select(JOIN *join, Procedure *procedure);
 
-static enum_nested_loop_state evaluate_join_record(JOIN *, JOIN_TAB *, int);
+static enum_nested_loop_state evaluate_join_record(JOIN *, JOIN_TAB *, int,
+                                                   bool batched= false);
+static Item_batch *join_tab_batch(JOIN *join, JOIN_TAB *join_tab);
+static enum_nested_loop_state evaluate_join_batch(JOIN *, JOIN_TAB *);
 static enum_nested_loop_state
 evaluate_null_complemented_join_record(JOIN *join, JOIN_TAB *join_tab);
 static enum_nested_loop_state
@@ -4675,6 +4680,8 @@ JOIN::reinit()
     for ( ; curr_tab < end_tab; curr_tab++)
     {
       TABLE *tmp_table= curr_tab->table;
+      if (curr_tab->aggr && curr_tab->aggr->group_hash)
+        curr_tab->aggr->group_hash->reset();
       if (!tmp_table->is_created())
         continue;
       tmp_table->file->extra(HA_EXTRA_RESET_STATE);
@@ -5099,6 +5106,7 @@ JOIN::destroy()
         free_tmp_table(thd, tab->table);
         delete tab->tmp_table_param;
         tab->tmp_table_param= NULL;
+        delete tab->aggr;
         tab->aggr= NULL;
       }
       tab->table= NULL;
@@ -16489,6 +16497,9 @@ void JOIN_TAB::cleanup()
   select= 0;
   delete quick;
   quick= 0;
+  delete batch;
+  batch= 0;
+  batch_checked_cond= 0;
   if (rowid_filter)
     clear_range_rowid_filter();
   if (cache)
@@ -17074,6 +17085,7 @@ void JOIN::cleanup(bool full)
             curr_tab->table= NULL;
             delete curr_tab->tmp_table_param;
             curr_tab->tmp_table_param= NULL;
+            delete curr_tab->aggr;
             curr_tab->aggr= NULL;
 
             delete curr_tab->filesort_result;
@@ -23458,6 +23470,30 @@ free_tmp_table(THD *thd, TABLE *entry)
 }
 
 
+/**
+  @brief
+  Check whether the groups should be aggregated in memory in a
+  Group_by_hash before they are written to the temporary table.
+
+  @details
+  The costs are compared for the case where every row is a group of its
+  own, which is the worst case for Group_by_hash: each group is also
+  written to the temporary table once.
+*/
+
+static bool use_hash_group_by(JOIN *join, TABLE *table)
+{
+  if (table->s->blob_fields)
+    return false;
+  const double rows= join->join_record_count;
+  TMPTABLE_COSTS tmp_cost= get_tmp_table_costs(join->thd, rows,
+                                               table->s->reclength,
+                                               false, true);
+  return (HASH_GROUP_BY_CREATE_COST + rows * HASH_GROUP_BY_LOOKUP_COST <
+          rows * tmp_cost.lookup);
+}
+
+
 /**
   @brief
   Set write_func of AGGR_OP object
@@ -23478,6 +23514,8 @@ void set_postjoin_aggr_write_func(JOIN_TAB *tab)
 
   DBUG_ASSERT(table && aggr);
 
+  delete aggr->group_hash;
+  aggr->group_hash= NULL;
   if (table->group && tmp_tbl->sum_func_count && 
       !tmp_tbl->precomputed_group_by)
   {
@@ -23489,6 +23527,12 @@ void set_postjoin_aggr_write_func(JOIN_TAB *tab)
     {
       DBUG_PRINT("info",("Using end_update"));
       aggr->set_write_func(end_update);
+      if (use_hash_group_by(join, table))
+      {
+        DBUG_PRINT("info",("Using Group_by_hash"));
+        aggr->group_hash= new Group_by_hash(table, tmp_tbl,
+                            (size_t) join->thd->variables.tmp_memory_table_size);
+      }
     }
     else
     {
@@ -24187,7 +24231,10 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
     error= (*join_tab->read_first_record)(join_tab);
     if (!error && join_tab->keep_current_rowid)
       join_tab->table->file->position(join_tab->table->record[0]);    
-    rc= evaluate_join_record(join, join_tab, error);
+    if (!error && join_tab_batch(join, join_tab))
+      rc= evaluate_join_batch(join, join_tab);
+    else
+      rc= evaluate_join_record(join, join_tab, error);
   }
 
   bool skip_over= FALSE;
@@ -24257,12 +24304,15 @@ sub_select(JOIN *join,JOIN_TAB *join_tab,bool end_of_records)
   @param  error > 0: Error, terminate processing
                 = 0: (Partial) row is available
                 < 0: No more rows available at this level
+  @param  batched  - The batch evaluated part of join_tab->select_cond
+                     was already found true for the row, only the
+                     residual part is to be checked
   @return Nested loop state (Ok, No_more_rows, Error, Killed)
 */
 
 static enum_nested_loop_state
 evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
-                     int error)
+                     int error, bool batched)
 {
   bool shortcut_for_distinct= join_tab->shortcut_for_distinct;
   ha_rows found_records=join->found_records;
@@ -24288,7 +24338,8 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_bool());
+    select_cond_result= MY_TEST(batched ? join_tab->batch->val_residual() :
+                                          select_cond->val_bool());
 
     /* check for errors evaluating the condition */
     if (unlikely(join->thd->is_error()))
@@ -24459,6 +24510,141 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
   DBUG_RETURN(NESTED_LOOP_OK);
 }
 
+/**
+  @brief Get the Item_batch for evaluating the condition attached to a table.
+
+  Batch evaluation reads the rows of join_tab ahead of processing them,
+  so it is only used where that cannot be observed: join_tab must be the
+  last table of a plain SELECT without LIMIT, outer joins or semi-join
+  strategies that stop reading early, the rows must not be locked and the
+  record images must be self-contained (no blobs). A condition with a
+  subquery is not batched, because the subquery may read the table.
+
+  @return the batch to use, or NULL if rows must be evaluated one by one
+*/
+
+static Item_batch *join_tab_batch(JOIN *join, JOIN_TAB *join_tab)
+{
+  THD *thd= join->thd;
+  TABLE *table= join_tab->table;
+
+  if (join->select_limit != HA_POS_ERROR ||
+      join->row_limit != HA_POS_ERROR ||
+      join->unit->lim.get_select_limit() != HA_POS_ERROR ||
+      thd->lex->limit_rows_examined_cnt != ULONGLONG_MAX)
+    return NULL;
+
+  if (join_tab->select_cond == join_tab->batch_checked_cond)
+    return join_tab->batch;
+
+  delete join_tab->batch;
+  join_tab->batch= NULL;
+  join_tab->batch_checked_cond= join_tab->select_cond;
+
+  if (!join_tab->select_cond ||
+      join_tab->select_cond->with_subquery() ||
+      thd->lex->sql_command != SQLCOM_SELECT ||
+      join_tab->bush_root_tab ||
+      join_tab + 1 != join->join_tab + join->top_join_tab_count ||
+      join_tab->first_inner || join_tab->last_inner ||
+      join_tab->keep_current_rowid || join_tab->loosescan_match_tab ||
+      join_tab->do_firstmatch || join_tab->check_weed_out_table ||
+      join_tab->shortcut_for_distinct || join_tab->use_quick == 2 ||
+      table->reginfo.not_exists_optimize ||
+      table->reginfo.lock_type >= TL_READ_WITH_SHARED_LOCKS ||
+      table->s->blob_fields)
+    return NULL;
+
+  switch (join_tab->type) {
+  case JT_ALL:
+  case JT_RANGE:
+  case JT_NEXT:
+  case JT_INDEX_MERGE:
+  case JT_REF:
+    break;
+  default:
+    return NULL;
+  }
+
+  Item_batch *batch= new (thd->mem_root) Item_batch;
+  if (!batch)
+    return NULL;
+  if (batch->init(table, join_tab->select_cond, 0))
+  {
+    delete batch;
+    return NULL;
+  }
+  join_tab->batch= batch;
+  return batch;
+}
+
+
+/**
+  @brief Process the rows of the last table of the join in batches.
+
+  The rows following the one in table->record[0] are read ahead into
+  join_tab->batch, the batch evaluated part of the attached condition is
+  evaluated for all of them at once, and the rows for which it is true
+  are passed to evaluate_join_record() one by one.
+
+  @param  join     - The join object
+  @param  join_tab - The join_tab being processed, with a batch
+  @return Nested loop state (Ok, No_more_rows, Error, Killed)
+*/
+
+static enum_nested_loop_state
+evaluate_join_batch(JOIN *join, JOIN_TAB *join_tab)
+{
+  THD *thd= join->thd;
+  Item_batch *batch= join_tab->batch;
+  READ_RECORD *info= &join_tab->read_record;
+  int error= 0;
+  DBUG_ENTER("evaluate_join_batch");
+
+  for (;;)
+  {
+    batch->clear();
+    while (!error)
+    {
+      batch->add_row();
+      if (batch->is_full())
+        break;
+      error= info->read_record();
+    }
+
+    if (unlikely(thd->check_killed()))
+      DBUG_RETURN(NESTED_LOOP_KILLED);
+    const bool row_by_row= batch->evaluate();
+    if (unlikely(thd->is_error()))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+
+    for (uint i= 0; i < batch->rows(); i++)
+    {
+      if (!row_by_row && !batch->result(i))
+      {
+        /* What evaluate_join_record() does for a rejected row */
+        if (unlikely(thd->check_killed()))
+          DBUG_RETURN(NESTED_LOOP_KILLED);
+        join_tab->tracker->r_rows++;
+        thd->inc_examined_row_count_fast();
+        thd->get_stmt_da()->inc_current_row_for_warning();
+        continue;
+      }
+      batch->restore_row(i);
+      enum_nested_loop_state rc=
+        evaluate_join_record(join, join_tab, 0, !row_by_row);
+      if (rc != NESTED_LOOP_OK || join->return_tab < join_tab)
+        DBUG_RETURN(rc);
+    }
+
+    if (error)
+      break;
+    error= info->read_record();
+  }
+  DBUG_RETURN(evaluate_join_record(join, join_tab, error));
+}
+
+
 /**
 
   @details
@@ -25312,9 +25498,26 @@ join_read_first(JOIN_TAB *tab)
     DBUG_ASSERT(order);
     DBUG_ASSERT(order->next == NULL);
     DBUG_ASSERT(order->item[0]->real_item()->type() == Item::FUNC_ITEM);
+    /*
+      Let the vector index skip rows that don't match the WHERE, otherwise
+      a selective condition leaves less than LIMIT rows in the result.
+      Not for inner tables of outer joins, and not if it's too expensive to
+      evaluate the condition for every visited node. The condition is
+      evaluated again for the returned rows, so it must not be pushed if
+      it has side effects or if it can evaluate differently for the same
+      row (RAND(), non-deterministic stored functions, user variables).
+    */
+    Item *cond= tab->select_cond;
+    Item_func::Functype set_user_var= Item_func::SUSERVAR_FUNC;
+    if (cond && (tab->first_inner || cond->is_expensive() ||
+                 (cond->used_tables() & RAND_TABLE_BIT) ||
+                 cond->walk(&Item::find_function_processor, false,
+                            &set_user_var)))
+      cond= nullptr;
     tab->read_record.read_record_func= join_hlindex_read_next;
     error= tab->table->hlindex_read_first(tab->index, *order->item,
-                                          tab->join->select_limit);
+                                          tab->join->select_limit,
+                                          cond, tab->rowid_filter);
   }
   else
   {
@@ -33185,6 +33388,12 @@ ulong check_selectivity(THD *thd,
   AGGR_OP implementation
 ****************************************************************************/
 
+AGGR_OP::~AGGR_OP()
+{
+  delete group_hash;
+}
+
+
 /**
   @brief Instantiate tmp table for aggregation and start index scan if needed
   @todo Tmp table always would be created, even for empty result. Extend
@@ -33225,6 +33434,8 @@ AGGR_OP::prepare_tmp_table()
     table->file->print_error(rc, MYF(0));
     return true;
   }
+  if ((use_group_hash= group_hash != NULL))
+    group_hash->reset();
   return false;
 }
 
@@ -33244,12 +33455,137 @@ AGGR_OP::put_record(bool end_of_records)
   if (!join_tab->table->file->inited)
     if (prepare_tmp_table())
       return NESTED_LOOP_ERROR;
+  if (use_group_hash)
+    return put_hash_record(end_of_records);
   enum_nested_loop_state rc= (*write_func)(join_tab->join, join_tab,
                                            end_of_records);
   return rc;
 }
 
 
+/**
+  @brief
+    Perform GROUP BY operation over rows coming in arbitrary order in
+    memory: the HashAggregation algorithm.
+
+  @details
+    Like end_update(), but the groups are looked up and updated in
+    group_hash. When group_hash runs out of memory (tmp_memory_table_size),
+    its groups are written to the temporary table and the rest of the rows
+    are aggregated in the temporary table by write_func, which converts it
+    to a disk based table if needed. Otherwise the groups are written to
+    the temporary table after the last row.
+
+  @param end_of_records  whether all rows have been put
+
+  @return return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state
+AGGR_OP::put_hash_record(bool end_of_records)
+{
+  JOIN *join= join_tab->join;
+  TABLE *table= join_tab->table;
+  TMP_TABLE_PARAM *param= join_tab->tmp_table_param;
+  DBUG_ENTER("AGGR_OP::put_hash_record");
+
+  if (end_of_records)
+  {
+    use_group_hash= false;
+    if (write_hash_groups())
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    DBUG_RETURN((*write_func)(join, join_tab, end_of_records));
+  }
+
+  copy_fields(param);
+  /* Make a key of group index, as in end_update() */
+  for (ORDER *group= table->group; group; group= group->next)
+  {
+    Item *item= *group->item;
+    if (group->fast_field_copier_setup != group->field)
+    {
+      group->fast_field_copier_setup= group->field;
+      group->fast_field_copier_func=
+        item->setup_fast_field_copier(group->field);
+    }
+    item->save_org_in_field(group->field, group->fast_field_copier_func);
+    if (item->maybe_null())
+      group->buff[-1]= (char) group->field->is_null();
+  }
+
+  uint32 hash;
+  uchar *rec;
+  if ((rec= group_hash->find(&hash)))
+  {
+    join->found_records++;
+    memcpy(table->record[0], rec, table->s->reclength);
+    update_tmptable_sum_func(join->sum_funcs, table);
+    memcpy(rec, table->record[0], table->s->reclength);
+  }
+  else if ((rec= group_hash->add(hash)))
+  {
+    join->found_records++;
+    init_tmptable_sum_functions(join->sum_funcs);
+    if (unlikely(copy_funcs(param->items_to_copy, join->thd)))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    memcpy(rec, table->record[0], table->s->reclength);
+    join_tab->send_records++;
+  }
+  else
+  {
+    /* Out of memory: continue in the temporary table */
+    use_group_hash= false;
+    if (write_hash_groups())
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    DBUG_RETURN((*write_func)(join, join_tab, end_of_records));
+  }
+
+  join->accepted_rows++;                        // For rownum()
+  if (unlikely(join->thd->check_killed()))
+    DBUG_RETURN(NESTED_LOOP_KILLED);
+  DBUG_RETURN(NESTED_LOOP_OK);
+}
+
+
+/**
+  @brief Write the groups in group_hash to the temporary table
+  @return
+    true  error
+    false ok
+*/
+
+bool
+AGGR_OP::write_hash_groups()
+{
+  TABLE *table= join_tab->table;
+  TMP_TABLE_PARAM *param= join_tab->tmp_table_param;
+  int error;
+
+  for (uchar *rec= group_hash->first_record(); rec;
+       rec= group_hash->next_record(rec))
+  {
+    memcpy(table->record[0], rec, table->s->reclength);
+    if (unlikely((error= table->file->ha_write_tmp_row(table->record[0]))))
+    {
+      if (create_internal_tmp_table_from_heap(join_tab->join->thd, table,
+                                              param->start_recinfo,
+                                              &param->recinfo,
+                                              error, 0, NULL))
+        return true;
+      /* Change method to update rows, as in end_update() */
+      if (unlikely((error= table->file->ha_index_init(0, 0))))
+      {
+        table->file->print_error(error, MYF(0));
+        return true;
+      }
+      set_write_func(end_unique_update);
+    }
+  }
+  group_hash->reset();
+  return false;
+}
+
+
 /**
   @brief Finish rnd/index scan after accumulating records, switch ref_array,
          and send accumulated records further.
@@ -247,6 +247,8 @@ class SJ_TMP_TABLE;
 class JOIN_TAB_RANGE;
 class AGGR_OP;
 class Filesort;
+class Item_batch;
+class Group_by_hash;
 struct SplM_plan_info;
 class SplM_opt_info;
 
@@ -269,6 +271,13 @@ typedef struct st_join_table {
     NULL means no index condition pushdown was performed.
   */
   Item          *pre_idx_push_select_cond;
+  /*
+    Batch evaluation of select_cond over rows that are read ahead, see
+    join_tab_batch(). batch_checked_cond is the select_cond for which
+    batch was last set up (or found to be unusable).
+  */
+  Item_batch    *batch;
+  Item          *batch_checked_cond;
   /*
     Pointer to the associated ON expression. on_expr_ref=!NULL except for
     degenerate joins. 
@@ -1175,6 +1184,9 @@ class Pushdown_query;
                          Tmp table uses the heap engine
       end_update_unique  Same as above, but the engine is myisam.
 
+    With end_update and end_update_unique, the groups may first be
+    aggregated in memory in group_hash, see put_hash_record().
+
     Lazy table initialization is used - the table will be instantiated and
     rnd/index scan started on the first put_record() call.
 
@@ -1185,8 +1197,13 @@ class AGGR_OP :public Sql_alloc
 public:
   JOIN_TAB *join_tab;
 
-  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), write_func(NULL)
+  /** In-memory aggregation of the groups, or NULL */
+  Group_by_hash *group_hash;
+
+  AGGR_OP(JOIN_TAB *tab) : join_tab(tab), group_hash(NULL), write_func(NULL),
+    use_group_hash(false)
   {};
+  ~AGGR_OP();
 
   enum_nested_loop_state put_record() { return put_record(false); };
   /*
@@ -1205,7 +1222,11 @@ class AGGR_OP :public Sql_alloc
 private:
   /** Write function that would be used for saving records in tmp table. */
   Next_select_func write_func;
+  /** Whether group_hash is used in the current execution */
+  bool use_group_hash;
   enum_nested_loop_state put_record(bool end_of_records);
+  enum_nested_loop_state put_hash_record(bool end_of_records);
+  bool write_hash_groups();
   bool prepare_tmp_table();
 };
 
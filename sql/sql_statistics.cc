@@ -2765,7 +2765,11 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   if (thd->variables.sample_percentage == 0)
   {
-    if (file->records() < MIN_THRESHOLD_FOR_SAMPLING)
+    /* records() may have to count the rows */
+    ha_rows records= file->records();
+    if (records == HA_POS_ERROR)
+      records= file->stats.records;
+    if (records < MIN_THRESHOLD_FOR_SAMPLING)
     {
       sample_fraction= 1;
     }
@@ -2773,7 +2777,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
     {
       sample_fraction= std::fmin(
                   (MIN_THRESHOLD_FOR_SAMPLING + 4096 *
-                   log(200 * file->records())) / file->records(), 1);
+                   log(200 * records)) / records, 1);
     }
   }
 
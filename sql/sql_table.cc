@@ -12669,7 +12669,8 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   restore_record(to, s->default_values);        // Create empty record
   to->reset_default_fields();
 
-  thd->progress.max_counter= from->file->records();
+  /* An estimate is enough here; records() may have to count the rows */
+  thd->progress.max_counter= from->file->stats.records;
   time_to_report_progress= MY_HOW_OFTEN_TO_WRITE/10;
   /* for now, InnoDB needs the undo log for ALTER IGNORE */
   if (!ignore && !to->s->hlindexes())
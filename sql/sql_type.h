@@ -40,6 +40,7 @@ class Item;
 class Item_const;
 class Item_literal;
 class Item_param;
+class Item_batch_vec;
 class Item_cache;
 class Item_copy;
 class Item_func_or_sum;
@@ -4316,6 +4317,16 @@ class Type_handler
   virtual void make_sort_key_part(uchar *to, Item *item,
                                   const SORT_FIELD_ATTR *sort_field,
                                   String *tmp) const= 0;
+  /*
+    Create the same key part as make_sort_key_part(), from the value of
+    the item that Item_batch computed for a row.
+    Returns false if this is not supported for the data type or the value.
+  */
+  virtual bool make_batch_sort_key_part(uchar *to, Item *item,
+                                        const SORT_FIELD_ATTR *sort_field,
+                                        const Item_batch_vec &vec,
+                                        uint row) const
+  { return false; }
 
   /*
     create a compact size key part for a sort key
@@ -5115,6 +5126,10 @@ class Type_handler_real_result: public Type_handler_numeric
   void make_sort_key_part(uchar *to, Item *item,
                           const SORT_FIELD_ATTR *sort_field,
                           String *tmp) const override;
+  bool make_batch_sort_key_part(uchar *to, Item *item,
+                                const SORT_FIELD_ATTR *sort_field,
+                                const Item_batch_vec &vec, uint row)
+                                const override;
   uint make_packed_sort_key_part(uchar *to, Item *item,
                                  const SORT_FIELD_ATTR *sort_field,
                                  String *tmp) const override;
@@ -5483,6 +5498,10 @@ class Type_handler_int_result: public Type_handler_numeric
   void make_sort_key_part(uchar *to, Item *item,
                           const SORT_FIELD_ATTR *sort_field,
                           String *tmp) const override;
+  bool make_batch_sort_key_part(uchar *to, Item *item,
+                                const SORT_FIELD_ATTR *sort_field,
+                                const Item_batch_vec &vec, uint row)
+                                const override;
   uint make_packed_sort_key_part(uchar *to, Item *item,
                                  const SORT_FIELD_ATTR *sort_field,
                                  String *tmp) const override;
@@ -64,6 +64,7 @@
 #include "sql_repl.h"
 #include "opt_range.h"
 #include "rpl_parallel.h"
+#include "rpl_writeset.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
 #include <ssl_compat.h>
@@ -2543,7 +2544,8 @@ Sys_var_slave_parallel_mode::global_value_ptr(THD *thd,
 
 /* The order here must match enum_slave_parallel_mode in mysqld.h. */
 static const char *slave_parallel_mode_names[] = {
-  "none", "minimal", "conservative", "optimistic", "aggressive", NULL
+  "none", "minimal", "conservative", "dependency", "optimistic", "aggressive",
+  NULL
 };
 export TYPELIB slave_parallel_mode_typelib =
   CREATE_TYPELIB_FOR(slave_parallel_mode_names);
@@ -2556,7 +2558,10 @@ Sys_slave_parallel_mode(
        "--slave-parallel-threads. Possible values: \"optimistic\" tries to "
        "apply most transactional DML in parallel, and handles any conflicts "
        "with rollback and retry. \"conservative\" limits parallelism in an "
-       "effort to avoid any conflicts. \"aggressive\" tries to maximise the "
+       "effort to avoid any conflicts. \"dependency\" applies transactions "
+       "in parallel when the master recorded that they change different "
+       "rows (see binlog_transaction_dependency_tracking), and as "
+       "\"conservative\" otherwise. \"aggressive\" tries to maximise the "
        "parallelism, possibly at the cost of increased conflict rate. "
        "\"minimal\" only parallelizes the commit steps of transactions. "
        "\"none\" disables parallel apply completely",
@@ -2674,6 +2679,35 @@ Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static const char *binlog_dependency_tracking_names[]=
+{ "COMMIT_ORDER", "WRITESET", NullS };
+
+static Sys_var_on_access_global<Sys_var_enum,
+               PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY_TRACKING>
+Sys_binlog_transaction_dependency_tracking(
+       "binlog_transaction_dependency_tracking",
+       "What the binlog records about the dependencies between transactions, "
+       "for parallel replication. COMMIT_ORDER: only which transactions "
+       "group-committed together. WRITESET: also, for each transaction, the "
+       "last earlier transaction that changed any of the same rows, which "
+       "--slave-parallel-mode=dependency uses to apply transactions in "
+       "parallel without conflicts",
+       GLOBAL_VAR(opt_binlog_dependency_tracking), CMD_LINE(REQUIRED_ARG),
+       binlog_dependency_tracking_names,
+       DEFAULT(BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER));
+
+
+static Sys_var_on_access_global<Sys_var_ulong,
+            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY_HISTORY_SIZE>
+Sys_binlog_transaction_dependency_history_size(
+       "binlog_transaction_dependency_history_size",
+       "Maximum number of row keys of recent transactions that are kept for "
+       "binlog_transaction_dependency_tracking=WRITESET. Transactions that "
+       "change more rows are treated as conflicting with everything before",
+       GLOBAL_VAR(opt_binlog_dependency_history_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 1000000), DEFAULT(25000), BLOCK_SIZE(1));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -3671,6 +3705,17 @@ Sys_slave_sql_verify_checksum(
        GLOBAL_VAR(opt_slave_sql_verify_checksum), CMD_LINE(OPT_ARG),
        DEFAULT(TRUE));
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                           PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_PREFETCH_ROWS>
+Sys_slave_prefetch_rows(
+       "slave_prefetch_rows",
+       "Before applying a row based event with more than one row, let the "
+       "storage engine start reading the index pages of all its rows in the "
+       "background. This can reduce the time to apply large events on a "
+       "slave that has to read the rows from disk",
+       GLOBAL_VAR(opt_slave_prefetch_rows), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_on_access_global<Sys_var_mybool,
                               PRIV_SET_SYSTEM_GLOBAL_VAR_MASTER_VERIFY_CHECKSUM>
 Sys_master_verify_checksum(
@@ -4386,6 +4431,14 @@ Sys_threadpool_dedicated_listener(
   GLOBAL_VAR(threadpool_dedicated_listener), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
   NO_MUTEX_GUARD, NOT_IN_BINLOG
 );
+
+static Sys_var_mybool Sys_threadpool_use_io_uring(
+  "thread_pool_use_io_uring",
+  "If set to 1, the thread groups poll the connections with io_uring if "
+  "the server was built with it and the kernel supports it, and with "
+  "epoll otherwise. If set to 0, epoll is always used",
+  READ_ONLY GLOBAL_VAR(threadpool_use_io_uring), CMD_LINE(OPT_ARG),
+  DEFAULT(TRUE));
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -5767,10 +5767,16 @@ bool TABLE_SHARE::visit_subgraph(Wait_for_flush *wait_for_flush,
   if (gvisitor->enter_node(src_ctx))
     goto end;
 
+  /*
+    A table that was parked by a connection (see tc_park_table()) right
+    before the share was flushed is not in use. The connection is about
+    to release it.
+  */
   while ((table= tables_it++))
   {
-    DBUG_ASSERT(table->in_use && tdc->flushed);
-    if (gvisitor->inspect_edge(&table->in_use->mdl_context))
+    THD *in_use= table->in_use;
+    DBUG_ASSERT(tdc->flushed);
+    if (in_use && gvisitor->inspect_edge(&in_use->mdl_context))
     {
       goto end_leave_node;
     }
@@ -5779,8 +5785,9 @@ bool TABLE_SHARE::visit_subgraph(Wait_for_flush *wait_for_flush,
   tables_it.rewind();
   while ((table= tables_it++))
   {
-    DBUG_ASSERT(table->in_use && tdc->flushed);
-    if (table->in_use->mdl_context.visit_subgraph(gvisitor))
+    THD *in_use= table->in_use;
+    DBUG_ASSERT(tdc->flushed);
+    if (in_use && in_use->mdl_context.visit_subgraph(gvisitor))
     {
       goto end_leave_node;
     }
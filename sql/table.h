@@ -37,6 +37,7 @@
 #include "sql_type.h"               /* vers_kind_t */
 #include "privilege.h"              /* privilege_t */
 #include "my_bit.h"
+#include "my_atomic_wrapper.h"
 
 /*
   Buffer for unix timestamp in microseconds:
@@ -1331,6 +1332,8 @@ struct TABLE
 
   uint32 instance; /** Table cache instance this TABLE is belonging to */
   THD	*in_use;                        /* Which thread uses this */
+  /** Slot of per-connection table cache this TABLE was last parked in */
+  Atomic_relaxed<std::atomic<TABLE*>*> parked_in;
 
   uchar *record[3];			/* Pointer to records */
   uchar *write_row_record;		/* Used as optimisation in
@@ -1377,6 +1380,8 @@ struct TABLE
   TABLE_LIST *internal_tables;
 
   TABLE *hlindex;
+  /* vector index writes are deferred, see mhnsw_start_bulk_insert() */
+  bool hlindex_bulk_insert;
   /*
     Not-null for temporary tables only. Non-null values means this table is
     used to compute GROUP BY, it has a unique of GROUP BY columns.
@@ -1799,7 +1804,8 @@ struct TABLE
 
   int hlindex_open(uint nr);
   int hlindex_lock(uint nr);
-  int hlindex_read_first(uint nr, Item *item, ulonglong limit);
+  int hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                         Item *cond, Rowid_filter *rowid_filter);
   int hlindex_read_next();
   int hlindex_read_end();
 
@@ -1808,6 +1814,8 @@ struct TABLE
   int hlindexes_on_update();
   int hlindexes_on_delete(const uchar *buf);
   int hlindexes_on_delete_all(bool truncate);
+  void hlindexes_on_start_bulk_insert();
+  int hlindexes_on_end_bulk_insert(bool abort= false);
   int unlock_hlindexes();
 
   void prepare_triggers_for_insert_stmt_or_event();
@@ -34,6 +34,8 @@
   - purge unused TABLE objects from cache (tc_purge())
   - purge unused TABLE objects of a table from cache (tdc_remove_table())
   - get number of TABLE objects in cache (tc_records())
+  - park TABLE object in per-connection cache (tc_park_table())
+  - release TABLE objects parked by a connection (tc_release_parked_tables())
 
   Dependencies:
   - close_cached_tables(): flush tables on shutdown
@@ -44,6 +46,18 @@
   - TABLE_SHARE::free_tables shall not contain objects with TABLE::in_use != 0
   - TABLE_SHARE::free_tables shall not receive new objects if
     TABLE_SHARE::tdc.flushed is true
+
+  Parked tables:
+  While table cache mutex contention is detected (tc_parking), a connection
+  keeps the TABLE objects it closes in its own small cache (Parked_tables)
+  instead of returning them to TABLE_SHARE::tdc.free_tables. The next open
+  of the same table by the connection takes it from there without looking
+  up the share in tdc_hash or locking LOCK_table_cache. A parked TABLE
+  object stays in TABLE_SHARE::tdc.all_tables and is counted in the table
+  cache instance it belongs to. Whoever removes unused objects from the
+  cache (tc_remove_all_unused_tables(), or tc_add_table() when the cache is
+  full) may steal it from its slot with a compare-and-swap, exactly one of
+  the connection and the stealer gets it.
 */
 
 #include "mariadb.h"
@@ -60,6 +74,8 @@ uint32 tc_instances;
 static size_t tc_allocated_size;
 static std::atomic<uint32_t> tc_active_instances(1);
 static std::atomic<bool> tc_contention_warning_reported;
+/** Whether the table cache mutexes are contended, see tc_park_table() */
+static std::atomic<bool> tc_parking;
 
 /** Data collections. */
 static LF_HASH tdc_hash; /**< Collection of TABLE_SHARE objects. */
@@ -83,14 +99,53 @@ static bool tdc_inited;
 
 static mysql_mutex_t LOCK_unused_shares;
 
+
+/** Number of TABLE objects a connection can park, a power of 2 */
+static constexpr uint parked_tables_size= 16;
+
+/**
+  TABLE objects parked by a connection, see tc_park_table().
+
+  The objects are never freed before tdc_deinit(), because a concurrent
+  tc_remove_all_unused_tables() may still access a slot through
+  TABLE::parked_in after the connection went away. They are reused by
+  other connections instead.
+*/
+struct Parked_tables
+{
+  /** The parked TABLE objects, by the hash of their table cache key */
+  std::atomic<TABLE*> tables[parked_tables_size];
+  /** The hash of the key of the last TABLE parked in a slot */
+  my_hash_value_type hash[parked_tables_size];
+  /** Link in free_parked_tables */
+  Parked_tables *next_free;
+  /** Link in all_parked_tables */
+  Parked_tables *next_all;
+
+  Parked_tables(): next_free(0), next_all(0)
+  {
+    for (uint i= 0; i < parked_tables_size; i++)
+    {
+      tables[i].store(nullptr, std::memory_order_relaxed);
+      hash[i]= 0;
+    }
+  }
+};
+
+/** Protects free_parked_tables and all_parked_tables */
+static mysql_mutex_t LOCK_parked_tables;
+static Parked_tables *free_parked_tables;
+static Parked_tables *all_parked_tables;
+
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_LOCK_unused_shares, key_TABLE_SHARE_LOCK_table_share,
-                     key_LOCK_table_cache;
+                     key_LOCK_table_cache, key_LOCK_parked_tables;
 static PSI_mutex_info all_tc_mutexes[]=
 {
   { &key_LOCK_unused_shares, "LOCK_unused_shares", PSI_FLAG_GLOBAL },
   { &key_TABLE_SHARE_LOCK_table_share, "TABLE_SHARE::tdc.LOCK_table_share", 0 },
-  { &key_LOCK_table_cache, "LOCK_table_cache", 0 }
+  { &key_LOCK_table_cache, "LOCK_table_cache", 0 },
+  { &key_LOCK_parked_tables, "LOCK_parked_tables", PSI_FLAG_GLOBAL }
 };
 
 static PSI_cond_key key_TABLE_SHARE_COND_release;
@@ -179,6 +234,7 @@ struct Table_cache_instance
       mysql_mutex_lock(&LOCK_table_cache);
       if (++mutex_waits == 20000)
       {
+        tc_parking.store(true, std::memory_order_relaxed);
         if (n_instances < tc_instances)
         {
           if (tc_active_instances.
@@ -213,6 +269,8 @@ struct Table_cache_instance
     }
     else if (++mutex_nowaits == 80000)
     {
+      /* Less than 20% waits: the contention is over */
+      tc_parking.store(false, std::memory_order_relaxed);
       mutex_waits= 0;
       mutex_nowaits= 0;
     }
@@ -285,6 +343,28 @@ static void tc_remove_all_unused_tables(TDC_element *element,
     }
     mysql_mutex_unlock(&tc[i].LOCK_table_cache);
   }
+
+  /*
+    Steal parked tables. Pairs with the fence in tc_park_table(): either
+    we see the table in its slot, or the connection sees
+    TABLE_SHARE::tdc.flushed and releases the table itself.
+  */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  All_share_tables_list::Iterator it(element->all_tables);
+  while (auto table= it++)
+  {
+    std::atomic<TABLE*> *slot= table->parked_in;
+    TABLE *parked= table;
+    if (!slot || !slot->compare_exchange_strong(parked, nullptr))
+      continue;
+    uint32 i= table->instance;
+    mysql_mutex_lock(&tc[i].LOCK_table_cache);
+    tc[i].records--;
+    mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+    DBUG_ASSERT(element->all_tables_refs == 0);
+    element->all_tables.remove(table);
+    purge_tables->push_front(table);
+  }
 }
 
 
@@ -325,6 +405,41 @@ void tc_purge()
 }
 
 
+/**
+  Evict a TABLE object parked by any connection.
+
+  Parked objects are not in the LRU list of their table cache instance.
+  This is called when the table cache is full and has no unused object
+  to evict, so that parked objects cannot make it exceed table_open_cache.
+  The object may belong to another table cache instance.
+*/
+
+static void tc_evict_parked_table(THD *thd)
+{
+  TABLE *table= nullptr;
+
+  mysql_mutex_lock(&LOCK_parked_tables);
+  for (Parked_tables *parked= all_parked_tables; parked && !table;
+       parked= parked->next_all)
+  {
+    for (uint i= 0; i < parked_tables_size && !table; i++)
+      if (parked->tables[i].load(std::memory_order_relaxed))
+        table= parked->tables[i].exchange(nullptr);
+  }
+  mysql_mutex_unlock(&LOCK_parked_tables);
+
+  if (!table)
+    return;
+  uint32 i= table->instance;
+  /* Needed if MDL deadlock detector chimes in before tc_remove_table() */
+  table->in_use= thd;
+  mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  tc[i].records--;
+  mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+  tc_remove_table(table);
+}
+
+
 /**
   Add new TABLE object to table cache.
 
@@ -339,6 +454,7 @@ void tc_purge()
 
   While unlocked:
   - free evicted object
+  - if there was no unused object to evict, evict a parked object
 */
 
 void tc_add_table(THD *thd, TABLE *table)
@@ -373,6 +489,8 @@ void tc_add_table(THD *thd, TABLE *table)
     {
       tc[i].records++;
       mysql_mutex_unlock(&tc[i].LOCK_table_cache);
+      /* Keep out of locked LOCK_table_cache */
+      tc_evict_parked_table(thd);
     }
     /* Keep out of locked LOCK_table_cache */
     status_var_increment(thd->status_var.table_open_cache_overflows);
@@ -471,6 +589,153 @@ void tc_release_table(TABLE *table)
 }
 
 
+/**
+  Get the parked tables of a connection, allocate them if needed.
+
+  @return Parked tables, or NULL if out of memory.
+*/
+
+static Parked_tables *tc_get_parked_tables(THD *thd)
+{
+  Parked_tables *parked;
+
+  if (likely((parked= thd->parked_tables) != nullptr))
+    return parked;
+
+  mysql_mutex_lock(&LOCK_parked_tables);
+  if ((parked= free_parked_tables))
+    free_parked_tables= parked->next_free;
+  else if ((parked= new Parked_tables))
+  {
+    parked->next_all= all_parked_tables;
+    all_parked_tables= parked;
+  }
+  mysql_mutex_unlock(&LOCK_parked_tables);
+  return thd->parked_tables= parked;
+}
+
+
+/**
+  Release TABLE object to the cache of the connection that used it.
+
+  @pre object is used by caller.
+
+  Parked object may be acquired again by the same connection only, see
+  tdc_acquire_share(). It may be evicted by any thread, see
+  tc_remove_all_unused_tables().
+
+  Parking is only worth it while the table cache mutexes are contended
+  (tc_parking). Otherwise the object is released to the table cache like
+  with tc_release_table(), which lets other connections reuse it.
+*/
+
+void tc_park_table(THD *thd, TABLE *table)
+{
+  TDC_element *element= table->s->tdc;
+  Parked_tables *parked;
+  DBUG_ASSERT(table->in_use == thd);
+  DBUG_ASSERT(!table->pos_in_locked_tables);
+
+  if ((!tc_parking.load(std::memory_order_relaxed) &&
+       !DBUG_IF("tc_park_tables")) ||
+      table->needs_reopen() || element->flushed || !tc_size ||
+      !(parked= tc_get_parked_tables(thd)))
+  {
+    tc_release_table(table);
+    return;
+  }
+
+  my_hash_value_type hash_value=
+    my_hash_sort(&my_charset_bin, (const uchar*) table->s->table_cache_key.str,
+                 table->s->table_cache_key.length);
+  uint i= hash_value & (parked_tables_size - 1);
+  std::atomic<TABLE*> *slot= &parked->tables[i];
+
+  parked->hash[i]= hash_value;
+  table->in_use= 0;
+  table->parked_in= slot;
+  if (TABLE *evicted= slot->exchange(table))
+  {
+    evicted->in_use= thd;
+    tc_release_table(evicted);
+  }
+
+  /*
+    The table may be stolen (and freed) any moment now. If the share was
+    flushed meanwhile, make sure that the table doesn't stay parked.
+    Pairs with the fence in tc_remove_all_unused_tables().
+  */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (unlikely(element->flushed) &&
+      slot->compare_exchange_strong(table, nullptr))
+  {
+    table->in_use= thd;
+    tc_release_table(table);
+  }
+}
+
+
+/**
+  Acquire TABLE object parked by the connection.
+
+  @return TABLE object, or NULL if the table is not parked.
+*/
+
+static TABLE *tc_acquire_parked_table(THD *thd, my_hash_value_type hash_value,
+                                      const char *key, uint key_length)
+{
+  Parked_tables *parked= thd->parked_tables;
+  uint i= hash_value & (parked_tables_size - 1);
+  TABLE *table;
+
+  if (!parked || parked->hash[i] != hash_value ||
+      !parked->tables[i].load(std::memory_order_relaxed) ||
+      !(table= parked->tables[i].exchange(nullptr)))
+    return 0;
+
+  table->in_use= thd;
+  if (table->s->table_cache_key.length != key_length ||
+      memcmp(table->s->table_cache_key.str, key, key_length))
+  {
+    /* Hash collision */
+    tc_release_table(table);
+    return 0;
+  }
+  /* The ex-parked table must be fully functional. */
+  DBUG_ASSERT(table->db_stat && table->file);
+  /* The children must be detached from the table. */
+  DBUG_ASSERT(!table->file->extra(HA_EXTRA_IS_ATTACHED_CHILDREN));
+  return table;
+}
+
+
+/**
+  Release all TABLE objects parked by the connection to table cache.
+*/
+
+void tc_release_parked_tables(THD *thd)
+{
+  Parked_tables *parked= thd->parked_tables;
+  if (!parked)
+    return;
+
+  for (uint i= 0; i < parked_tables_size; i++)
+  {
+    if (TABLE *table= parked->tables[i].exchange(nullptr))
+    {
+      table->in_use= thd;
+      tc_release_table(table);
+    }
+  }
+  thd->parked_tables= 0;
+
+  mysql_mutex_lock(&LOCK_parked_tables);
+  parked->next_free= free_parked_tables;
+  free_parked_tables= parked;
+  mysql_mutex_unlock(&LOCK_parked_tables);
+}
+
+
 static void tdc_assert_clean_share(TDC_element *element)
 {
   DBUG_ASSERT(element->share == 0);
@@ -615,6 +880,8 @@ bool tdc_init(void)
   tdc_inited= true;
   mysql_mutex_init(key_LOCK_unused_shares, &LOCK_unused_shares,
                    MY_MUTEX_INIT_FAST);
+  mysql_mutex_init(key_LOCK_parked_tables, &LOCK_parked_tables,
+                   MY_MUTEX_INIT_FAST);
   lf_hash_init(&tdc_hash,
                sizeof(TDC_element) +
                    sizeof(Share_free_tables) * (tc_instances - 1),
@@ -664,6 +931,13 @@ void tdc_deinit(void)
     tdc_inited= false;
     lf_hash_destroy(&tdc_hash);
     mysql_mutex_destroy(&LOCK_unused_shares);
+    while (Parked_tables *parked= all_parked_tables)
+    {
+      all_parked_tables= parked->next_all;
+      delete parked;
+    }
+    free_parked_tables= 0;
+    mysql_mutex_destroy(&LOCK_parked_tables);
     if (tc)
     {
       tc->mark_memory_freed();
@@ -821,6 +1095,14 @@ TABLE_SHARE *tdc_acquire_share(THD *thd, TABLE_LIST *tl, uint flags,
   bool was_unused;
   DBUG_ENTER("tdc_acquire_share");
 
+  if (out_table && (flags & GTS_TABLE) &&
+      (*out_table= tc_acquire_parked_table(thd, hash_value, key, key_length)))
+  {
+    DBUG_ASSERT(!(flags & GTS_NOLOCK));
+    status_var_increment(thd->status_var.table_open_cache_hits);
+    DBUG_RETURN((*out_table)->s);
+  }
+
   if (fix_thd_pins(thd))
     DBUG_RETURN(0);
 
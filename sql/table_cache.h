@@ -92,6 +92,8 @@ int show_tc_active_instances(THD *thd, SHOW_VAR *var, void *buff,
 extern void tc_purge();
 extern void tc_add_table(THD *thd, TABLE *table);
 extern void tc_release_table(TABLE *table);
+extern void tc_park_table(THD *thd, TABLE *table);
+extern void tc_release_parked_tables(THD *thd);
 extern TABLE *tc_acquire_table(THD *thd, TDC_element *element);
 
 /**
@@ -118,6 +118,7 @@ static void queue_put(thread_group_t *thread_group, TP_connection_generic *conne
 static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt);
 static int  wake_thread(thread_group_t *thread_group,bool due_to_stall);
 static int  wake_or_create_thread(thread_group_t *thread_group, bool due_to_stall=false);
+static bool wake_sibling(thread_group_t *thread_group);
 static int  create_worker(thread_group_t *thread_group, bool due_to_stall);
 static void *worker_main(void *param);
 static void check_stall(thread_group_t *thread_group);
@@ -175,6 +176,7 @@ static void print_pool_blocked_message(bool);
 /* Early 2.6 kernel did not have EPOLLRDHUP */
 #define EPOLLRDHUP 0
 #endif
+#define IO_POLL_CREATE_CALL "epoll_create()"
 static TP_file_handle io_poll_create()
 {
   return epoll_create(1);
@@ -251,6 +253,7 @@ static void *native_event_get_userdata(native_event *event)
 #endif
 
 
+#define IO_POLL_CREATE_CALL "kqueue()"
 TP_file_handle io_poll_create()
 {
   return kqueue();
@@ -307,6 +310,7 @@ static void* native_event_get_userdata(native_event *event)
 
 #elif defined (__sun)
 
+#define IO_POLL_CREATE_CALL "port_create()"
 static TP_file_handle io_poll_create()
 {
   return port_create();
@@ -355,6 +359,7 @@ static void* native_event_get_userdata(native_event *event)
 #elif defined(_WIN32)
 
 
+#define IO_POLL_CREATE_CALL "CreateIoCompletionPort()"
 static TP_file_handle io_poll_create()
 {
   return CreateIoCompletionPort(INVALID_HANDLE_VALUE, 0, 0, 0);
@@ -442,6 +447,270 @@ int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents,
 
 #endif
 
+#ifdef HAVE_URING
+#include <liburing.h>
+#include <poll.h>
+#include <mutex>
+#include <thread>
+
+/**
+  io_uring based poller of a thread group, used instead of epoll if
+  the kernel supports it and thread_pool_use_io_uring is set.
+
+  Like with EPOLLONESHOT, a connection is armed with a one-shot
+  IORING_OP_POLL_ADD, and must be re-armed after its request was
+  handled. Re-arming only adds an entry to the submission queue without
+  a system call. The entries are submitted in one batch by the next
+  thread that polls, or by the re-arming thread itself if the listener
+  is already blocked waiting for completions.
+
+  Since a poll is only armed while the connection is idle, there is
+  nothing to disassociate when a connection moves to another group.
+*/
+struct tp_uring
+{
+  struct io_uring ring;
+  /** protects the submission queue and waiting */
+  std::mutex sq_mutex;
+  /** protects the completion queue */
+  std::mutex cq_mutex;
+  /** whether a thread is blocked waiting for completions */
+  bool waiting;
+};
+
+/** Size of the submission queue of a thread group */
+#define URING_ENTRIES 256
+
+/**
+  How many times to retry submitting to a full submission queue while
+  the kernel cannot accept more entries (the completion queue is full)
+*/
+#define URING_SUBMIT_RETRIES 1000
+
+static tp_uring *uring_create()
+{
+  static bool reported;
+  tp_uring *u= new (std::nothrow) tp_uring;
+  if (!u)
+    return NULL;
+  unsigned entries= URING_ENTRIES;
+  DBUG_EXECUTE_IF("threadpool_uring_small_sq", entries= 2;);
+  int ret= io_uring_queue_init(entries, &u->ring, 0);
+  if (ret < 0)
+  {
+    if (!reported)
+    {
+      reported= true;
+      sql_print_information("Threadpool: io_uring_queue_init() failed with "
+                            "errno %d, using epoll", -ret);
+    }
+    delete u;
+    return NULL;
+  }
+  if (!reported)
+  {
+    reported= true;
+    sql_print_information("Threadpool: using io_uring");
+  }
+  u->waiting= false;
+  return u;
+}
+
+
+static void uring_close(tp_uring *u)
+{
+  io_uring_queue_exit(&u->ring);
+  delete u;
+}
+
+
+static int uring_start_read(tp_uring *u, TP_file_handle fd, void *data)
+{
+  std::unique_lock<std::mutex> sq_lock(u->sq_mutex);
+  struct io_uring_sqe *sqe;
+  for (uint retries= 0; !(sqe= io_uring_get_sqe(&u->ring)); )
+  {
+    /* The submission queue is full, submit the pending entries */
+    int ret= io_uring_submit(&u->ring);
+    if (ret == -EBUSY || ret == -EAGAIN || ret == -EINTR)
+    {
+      /*
+        Let the listener reap completions, but do not spin forever if
+        it does not; the connection is then closed by the caller.
+      */
+      if (++retries > URING_SUBMIT_RETRIES)
+      {
+        errno= -ret;
+        return -1;
+      }
+      sq_lock.unlock();
+      std::this_thread::yield();
+      sq_lock.lock();
+    }
+    else if (ret < 0)
+    {
+      errno= -ret;
+      return -1;
+    }
+  }
+  io_uring_prep_poll_add(sqe, fd, POLLIN | POLLRDHUP);
+  io_uring_sqe_set_data(sqe, data);
+  if (u->waiting)
+  {
+    int ret= io_uring_submit(&u->ring);
+    if (ret < 0 && ret != -EBUSY && ret != -EAGAIN && ret != -EINTR)
+    {
+      errno= -ret;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+
+/**
+  Submit the pending entries and collect completions.
+
+  @param timeout_ms  -1 to wait for at least one completion, or 0.
+                     Only one thread waits at a time; a non-blocking
+                     call returns 0 while another thread is polling.
+*/
+static int uring_wait(tp_uring *u, native_event *native_events,
+                      int maxevents, int timeout_ms)
+{
+  std::unique_lock<std::mutex> cq_lock(u->cq_mutex, std::defer_lock);
+  if (timeout_ms)
+    cq_lock.lock();
+  else if (!cq_lock.try_lock())
+    return 0;
+
+  u->sq_mutex.lock();
+  int ret= io_uring_submit(&u->ring);
+  u->waiting= timeout_ms != 0;
+  u->sq_mutex.unlock();
+
+  if (timeout_ms)
+  {
+    struct io_uring_cqe *cqe;
+    do
+      ret= io_uring_wait_cqe(&u->ring, &cqe);
+    while (ret == -EINTR);
+    u->sq_mutex.lock();
+    u->waiting= false;
+    u->sq_mutex.unlock();
+  }
+  if (ret < 0 && ret != -EBUSY && ret != -EAGAIN)
+  {
+    errno= -ret;
+    return -1;
+  }
+
+  struct io_uring_cqe *cqe;
+  unsigned head;
+  int n= 0;
+  io_uring_for_each_cqe(&u->ring, head, cqe)
+  {
+    if (n == maxevents)
+      break;
+    /*
+      A failed poll (negative res, e.g. -ECANCELED) is not an event mask.
+      The connection is still returned, because it is not armed anymore;
+      the worker finds the error when it reads from the connection.
+    */
+    native_events[n].events= cqe->res < 0 ? POLLERR : (uint32_t) cqe->res;
+    native_events[n].data.ptr= io_uring_cqe_get_data(cqe);
+    n++;
+  }
+  io_uring_cq_advance(&u->ring, n);
+  return n;
+}
+#endif /* HAVE_URING */
+
+
+/*
+  Polling of a thread group, with io_uring if it is available and
+  the functions of the platform otherwise.
+*/
+
+static bool tp_poll_create(thread_group_t *thread_group)
+{
+#ifdef HAVE_URING
+  if (threadpool_use_io_uring && (thread_group->uring= uring_create()))
+  {
+    thread_group->pollfd= thread_group->uring->ring.ring_fd;
+    return true;
+  }
+#endif
+  thread_group->pollfd= io_poll_create();
+  if (thread_group->pollfd != INVALID_HANDLE_VALUE)
+    return true;
+  sql_print_error(IO_POLL_CREATE_CALL " failed, errno=%d", errno);
+  return false;
+}
+
+
+static void tp_poll_close(thread_group_t *thread_group)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+  {
+    uring_close(thread_group->uring);
+    thread_group->uring= NULL;
+    thread_group->pollfd= INVALID_HANDLE_VALUE;
+    return;
+  }
+#endif
+  io_poll_close(thread_group->pollfd);
+  thread_group->pollfd= INVALID_HANDLE_VALUE;
+}
+
+
+static int tp_poll_associate_fd(thread_group_t *thread_group,
+                                TP_file_handle fd, void *data, void *opt)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return uring_start_read(thread_group->uring, fd, data);
+#endif
+  return io_poll_associate_fd(thread_group->pollfd, fd, data, opt);
+}
+
+
+static int tp_poll_start_read(thread_group_t *thread_group,
+                              TP_file_handle fd, void *data, void *opt)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return uring_start_read(thread_group->uring, fd, data);
+#endif
+  return io_poll_start_read(thread_group->pollfd, fd, data, opt);
+}
+
+
+static int tp_poll_disassociate_fd(thread_group_t *thread_group,
+                                   TP_file_handle fd)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return 0;
+#endif
+  return io_poll_disassociate_fd(thread_group->pollfd, fd);
+}
+
+
+static int tp_poll_wait(thread_group_t *thread_group,
+                        native_event *native_events, int maxevents,
+                        int timeout_ms)
+{
+#ifdef HAVE_URING
+  if (thread_group->uring)
+    return uring_wait(thread_group->uring, native_events, maxevents,
+                      timeout_ms);
+#endif
+  return io_poll_wait(thread_group->pollfd, native_events, maxevents,
+                      timeout_ms);
+}
+
 
 /* Dequeue element from a workqueue */
 
@@ -676,7 +945,13 @@ void check_stall(thread_group_t *thread_group)
   {
     thread_group->stalled= true;
     TP_INCREMENT_GROUP_COUNTER(thread_group,stalls);
-    wake_or_create_thread(thread_group,true);
+    /*
+      Rather than creating a new thread in this group, let an idle
+      worker of another group take over the queued connections.
+    */
+    if (!thread_group->waiting_threads.is_empty() ||
+        !wake_sibling(thread_group))
+      wake_or_create_thread(thread_group,true);
   }
 
   /* Reset queue event count */
@@ -730,7 +1005,7 @@ static TP_connection_generic * listener(worker_thread_t *current_thread,
     if (thread_group->shutdown)
       break;
 
-    cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, -1);
+    cnt = tp_poll_wait(thread_group, ev, MAX_EVENTS, -1);
     TP_INCREMENT_GROUP_COUNTER(thread_group, polls[(int)operation_origin::LISTENER]);
     if (cnt <=0)
     {
@@ -999,10 +1274,7 @@ void thread_group_destroy(thread_group_t *thread_group)
 {
   mysql_mutex_destroy(&thread_group->mutex);
   if (thread_group->pollfd != INVALID_HANDLE_VALUE)
-  {
-    io_poll_close(thread_group->pollfd);
-    thread_group->pollfd= INVALID_HANDLE_VALUE;
-  }
+    tp_poll_close(thread_group);
 #ifndef _WIN32
   for(int i=0; i < 2; i++)
   {
@@ -1057,7 +1329,7 @@ static int wake_listener(thread_group_t *thread_group)
   }
 
   /* Wake listener */
-  if (io_poll_associate_fd(thread_group->pollfd,
+  if (tp_poll_associate_fd(thread_group,
     thread_group->shutdown_pipe[0], NULL, NULL))
   {
     return -1;
@@ -1140,6 +1412,111 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Check (without the mutex of the group, so the result is only a hint)
+  whether a group has queued connections that none of its idle workers
+  can take.
+*/
+
+static bool is_overloaded(thread_group_t *thread_group)
+{
+  return !thread_group->shutdown && !is_queue_empty(thread_group) &&
+    thread_group->waiting_threads.is_empty();
+}
+
+
+/**
+  Take a queued connection from another, overloaded group and move it
+  to the current group.
+
+  Load can be skewed across groups, because connections are assigned to
+  groups by their thread id. Rather than going to sleep while another
+  group has requests waiting in its queue, an idle worker takes over
+  such a connection. The groups are scanned starting with the next one,
+  so that different groups tend to pick different victims.
+
+  @param thread_group  the group of the current worker. Its mutex is
+                       held on entry and exit, but released in between,
+                       so that at most one group mutex is held at a time.
+
+  @return the connection, or NULL if there was none
+*/
+
+static TP_connection_generic *steal_connection(thread_group_t *thread_group)
+{
+  DBUG_ENTER("steal_connection");
+  const uint id= uint(thread_group - all_groups);
+  TP_connection_generic *connection= NULL;
+
+  mysql_mutex_unlock(&thread_group->mutex);
+  for (uint i= 1; i < group_count && !connection; i++)
+  {
+    thread_group_t *victim= &all_groups[(id + i) % group_count];
+    /* Skip the group based on a hint; only a check under
+    victim->mutex is reliable. */
+    if (!is_overloaded(victim))
+      continue;
+
+    mysql_mutex_lock(&victim->mutex);
+    if (is_overloaded(victim) && (connection= queue_get(victim)))
+    {
+      victim->stalled= false;
+      if (connection->bound_to_poll_descriptor)
+      {
+        tp_poll_disassociate_fd(victim, connection->fd);
+        connection->bound_to_poll_descriptor= false;
+      }
+      victim->connection_count--;
+      connection->thread_group= thread_group;
+      TP_INCREMENT_GROUP_COUNTER(victim, stolen);
+    }
+    mysql_mutex_unlock(&victim->mutex);
+  }
+  mysql_mutex_lock(&thread_group->mutex);
+
+  if (connection)
+  {
+    thread_group->connection_count++;
+    TP_INCREMENT_GROUP_COUNTER(thread_group, steals);
+    TP_INCREMENT_GROUP_COUNTER(thread_group,
+                               dequeues[(int)operation_origin::WORKER]);
+  }
+  DBUG_RETURN(connection);
+}
+
+
+/**
+  Wake an idle worker of another group, which will then take over
+  a connection from the queue of a stalled group (see steal_connection()).
+
+  The caller holds thread_group->mutex. The mutex of a sibling is only
+  tried, because two groups may be waking each other at the same time;
+  a busy sibling is skipped.
+
+  @return whether a worker was woken
+*/
+
+static bool wake_sibling(thread_group_t *thread_group)
+{
+  mysql_mutex_assert_owner(&thread_group->mutex);
+  const uint id= uint(thread_group - all_groups);
+  for (uint i= 1; i < group_count; i++)
+  {
+    thread_group_t *sibling= &all_groups[(id + i) % group_count];
+    if (sibling->waiting_threads.is_empty() ||
+        mysql_mutex_trylock(&sibling->mutex))
+      continue;
+
+    bool woken= !sibling->shutdown && sibling->listener &&
+      is_queue_empty(sibling) && !wake_thread(sibling, true);
+    mysql_mutex_unlock(&sibling->mutex);
+    if (woken)
+      return true;
+  }
+  return false;
+}
+
+
 /**
   Retrieve a connection with pending event.
 
@@ -1165,6 +1542,8 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
   TP_connection_generic *connection = NULL;
 
 
+  bool tried_steal= false;
+
   mysql_mutex_lock(&thread_group->mutex);
   DBUG_ASSERT(thread_group->active_thread_count >= 0);
 
@@ -1210,7 +1589,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     if (!oversubscribed && !threadpool_dedicated_listener)
     {
       native_event ev[MAX_EVENTS];
-      int cnt = io_poll_wait(thread_group->pollfd, ev, MAX_EVENTS, 0);
+      int cnt = tp_poll_wait(thread_group, ev, MAX_EVENTS, 0);
       TP_INCREMENT_GROUP_COUNTER(thread_group, polls[(int)operation_origin::WORKER]);
       if (cnt > 0)
       {
@@ -1220,6 +1599,21 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
       }
     }
 
+    /*
+      Before going to sleep, help out an overloaded group, once per wait.
+      steal_connection() releases our mutex, so that a connection could
+      have been queued, the group could have been shut down or the
+      listener could have returned meanwhile. If nothing was stolen,
+      check all that again before going to sleep.
+    */
+    if (!oversubscribed && group_count > 1 && !tried_steal)
+    {
+      tried_steal= true;
+      if ((connection= steal_connection(thread_group)))
+        break;
+      continue;
+    }
+
 
     /* And now, finally sleep */
     current_thread->woken = false; /* wake() sets this to true */
@@ -1242,6 +1636,7 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
       err = mysql_cond_wait(&current_thread->cond, &thread_group->mutex);
     }
     thread_group->active_thread_count++;
+    tried_steal= false;
 
     if (!current_thread->woken)
     {
@@ -1468,7 +1863,7 @@ static int change_group(TP_connection_generic *c,
   mysql_mutex_lock(&old_group->mutex);
   if (c->bound_to_poll_descriptor)
   {
-    io_poll_disassociate_fd(old_group->pollfd,c->fd);
+    tp_poll_disassociate_fd(old_group,c->fd);
     c->bound_to_poll_descriptor= false;
   }
   c->thread_group->connection_count--;
@@ -1516,10 +1911,10 @@ int TP_connection_generic::start_io()
   if (!bound_to_poll_descriptor)
   {
     bound_to_poll_descriptor= true;
-    return io_poll_associate_fd(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+    return tp_poll_associate_fd(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
   }
 
-  return io_poll_start_read(thread_group->pollfd, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
+  return tp_poll_start_read(thread_group, fd, this, OPTIONAL_IO_POLL_READ_PARAM);
 }
 
 
@@ -1657,12 +2052,7 @@ int TP_pool_generic::set_pool_size(uint size)
     mysql_mutex_lock(&group->mutex);
     if (group->pollfd == INVALID_HANDLE_VALUE)
     {
-      group->pollfd= io_poll_create();
-      success= (group->pollfd != INVALID_HANDLE_VALUE);
-      if(!success)
-      {
-        sql_print_error("io_poll_create() failed, errno=%d", errno);
-      }
+      success= tp_poll_create(group);
     }
     mysql_mutex_unlock(&group->mutex);
     if (!success)
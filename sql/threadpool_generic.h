@@ -126,6 +126,10 @@ struct thread_group_counters_t
   ulonglong stalls;
   ulonglong dequeues[2];
   ulonglong polls[2];
+  /* connections taken from the queues of other groups */
+  ulonglong steals;
+  /* connections taken from the queue by workers of other groups */
+  ulonglong stolen;
 };
 
 struct thread_group_t
@@ -136,6 +140,10 @@ struct thread_group_t
   worker_thread_t* listener;
   pthread_attr_t* pthread_attr;
   TP_file_handle  pollfd;
+#ifdef __linux__
+  /* io_uring based poller, or NULL if epoll is used */
+  struct tp_uring *uring;
+#endif
   int  thread_count;
   int  active_thread_count;
   int  connection_count;
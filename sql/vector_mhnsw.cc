@@ -19,6 +19,7 @@
 #include "key.h"                                // key_copy()
 #include "create_options.h"
 #include "table_cache.h"
+#include "rowid_filter.h"                     // Rowid_filter
 #include "vector_mhnsw.h"
 #include <scope.h>
 #include <my_atomic_wrapper.h>
@@ -54,10 +55,20 @@ static MYSQL_THDVAR_ENUM(default_distance, PLUGIN_VAR_RQCMDARG,
        "Distance function to build the vector index for",
        nullptr, nullptr, EUCLIDEAN, &distances);
 
+/*
+  How vector coordinates are stored in the graph table and in the cache.
+  INT16 keeps 2 bytes per coordinate, INT8 only one, which fits twice as
+  many nodes into mhnsw_max_cache_size at the cost of precision. With INT8
+  the final candidates are re-ranked using the exact distance to the
+  full-precision vectors from the base table.
+*/
+enum quantization_type : uint { QUANT_INT16, QUANT_INT8 };
+
 struct ha_index_option_struct
 {
   ulonglong M; // option struct does not support uint
   metric_type metric;
+  quantization_type quantization;
 };
 
 enum Graph_table_fields {
@@ -72,6 +83,9 @@ class FVectorNode;
 
 /*
   One vector, an array of coordinates in ctx->vec_len dimensions
+
+  Coordinates are int16_t or, for QUANT_INT8, int8_t (see dims8()),
+  in the latter case all sizes below are in bytes of int8_t, not int16_t.
 */
 #pragma pack(push, 1)
 struct FVector
@@ -83,14 +97,19 @@ struct FVector
   int16_t dims[4];
 
   uchar *data() const { return (uchar*)(&scale); }
+  int8_t *dims8() const { return (int8_t*)dims; }
+
+  static size_t dim_size(quantization_type q)
+  { return q == QUANT_INT8 ? sizeof(int8_t) : sizeof(int16_t); }
 
-  static size_t data_size(size_t n)
-  { return data_header + n*2; }
+  static size_t data_size(size_t n, quantization_type q)
+  { return data_header + n*dim_size(q); }
 
-  static size_t data_to_value_size(size_t data_size)
-  { return (data_size - data_header)*2; }
+  static size_t data_to_value_size(size_t data_size, quantization_type q)
+  { return (data_size - data_header)*sizeof(float)/dim_size(q); }
 
-  static const FVector *create(metric_type metric, void *mem, const void *src, size_t src_len)
+  static const FVector *create(metric_type metric, quantization_type q,
+                               void *mem, const void *src, size_t src_len)
   {
     float scale=0, *v= (float *)src;
     size_t vec_len= src_len / sizeof(float);
@@ -99,10 +118,19 @@ struct FVector
         scale= get_float(v + i);
 
     FVector *vec= align_ptr(mem);
-    vec->scale= scale ? scale/32767 : 1;
-    for (size_t i= 0; i < vec_len; i++)
-      vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
-    vec->postprocess(vec_len);
+    if (q == QUANT_INT8)
+    {
+      vec->scale= scale ? scale/127 : 1;
+      for (size_t i= 0; i < vec_len; i++)
+        vec->dims8()[i] = static_cast<int8_t>(std::round(get_float(v + i) / vec->scale));
+    }
+    else
+    {
+      vec->scale= scale ? scale/32767 : 1;
+      for (size_t i= 0; i < vec_len; i++)
+        vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
+    }
+    vec->postprocess(vec_len, q);
     if (metric == COSINE)
     {
       if (vec->abs2 > 0.0f)
@@ -112,10 +140,17 @@ struct FVector
     return vec;
   }
 
-  void postprocess(size_t vec_len)
+  void postprocess(size_t vec_len, quantization_type q)
+  {
+    fix_tail(vec_len * dim_size(q));
+    abs2= scale * scale * dot_product(this, vec_len, q) / 2;
+  }
+
+  float dot_product(const FVector *other, size_t vec_len,
+                    quantization_type q) const
   {
-    fix_tail(vec_len);
-    abs2= scale * scale * dot_product(dims, dims, vec_len) / 2;
+    return q == QUANT_INT8 ? dot_product(dims8(), other->dims8(), vec_len)
+                           : dot_product(dims, other->dims, vec_len);
   }
 
 #ifdef AVX2_IMPLEMENTATION
@@ -140,8 +175,31 @@ struct FVector
   }
 
   AVX2_IMPLEMENTATION
-  static size_t alloc_size(size_t n)
-  { return alloc_header + MY_ALIGN(n*2, AVX2_bytes) + AVX2_bytes - 1; }
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    __m256i *p1= (__m256i*)v1;
+    __m256i *p2= (__m256i*)v2;
+    __m256i d= _mm256_setzero_si256();
+    for (size_t i= 0; i < (len + AVX2_bytes-1)/AVX2_bytes; p1++, p2++, i++)
+    {
+      __m256i lo= _mm256_madd_epi16(
+                    _mm256_cvtepi8_epi16(_mm256_castsi256_si128(*p1)),
+                    _mm256_cvtepi8_epi16(_mm256_castsi256_si128(*p2)));
+      __m256i hi= _mm256_madd_epi16(
+                    _mm256_cvtepi8_epi16(_mm256_extracti128_si256(*p1, 1)),
+                    _mm256_cvtepi8_epi16(_mm256_extracti128_si256(*p2, 1)));
+      d= _mm256_add_epi32(d, _mm256_add_epi32(lo, hi));
+    }
+    __m128i s= _mm_add_epi32(_mm256_castsi256_si128(d),
+                             _mm256_extracti128_si256(d, 1));
+    s= _mm_hadd_epi32(s, s);
+    s= _mm_hadd_epi32(s, s);
+    return static_cast<float>(_mm_cvtsi128_si32(s));
+  }
+
+  AVX2_IMPLEMENTATION
+  static size_t alloc_size(size_t bytes)
+  { return alloc_header + MY_ALIGN(bytes, AVX2_bytes) + AVX2_bytes - 1; }
 
   AVX2_IMPLEMENTATION
   static FVector *align_ptr(void *ptr)
@@ -149,9 +207,9 @@ struct FVector
                       - alloc_header); }
 
   AVX2_IMPLEMENTATION
-  void fix_tail(size_t vec_len)
+  void fix_tail(size_t bytes)
   {
-    bzero(dims + vec_len, (MY_ALIGN(vec_len, AVX2_dims) - vec_len)*2);
+    bzero((uchar*)dims + bytes, MY_ALIGN(bytes, AVX2_bytes) - bytes);
   }
 #endif
 
@@ -172,8 +230,27 @@ struct FVector
   }
 
   AVX512_IMPLEMENTATION
-  static size_t alloc_size(size_t n)
-  { return alloc_header + MY_ALIGN(n*2, AVX512_bytes) + AVX512_bytes - 1; }
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    __m512i *p1= (__m512i*)v1;
+    __m512i *p2= (__m512i*)v2;
+    __m512i d= _mm512_setzero_si512();
+    for (size_t i= 0; i < (len + AVX512_bytes-1)/AVX512_bytes; p1++, p2++, i++)
+    {
+      __m512i lo= _mm512_madd_epi16(
+                    _mm512_cvtepi8_epi16(_mm512_castsi512_si256(*p1)),
+                    _mm512_cvtepi8_epi16(_mm512_castsi512_si256(*p2)));
+      __m512i hi= _mm512_madd_epi16(
+                    _mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(*p1, 1)),
+                    _mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(*p2, 1)));
+      d= _mm512_add_epi32(d, _mm512_add_epi32(lo, hi));
+    }
+    return static_cast<float>(_mm512_reduce_add_epi32(d));
+  }
+
+  AVX512_IMPLEMENTATION
+  static size_t alloc_size(size_t bytes)
+  { return alloc_header + MY_ALIGN(bytes, AVX512_bytes) + AVX512_bytes - 1; }
 
   AVX512_IMPLEMENTATION
   static FVector *align_ptr(void *ptr)
@@ -181,9 +258,9 @@ struct FVector
                       - alloc_header); }
 
   AVX512_IMPLEMENTATION
-  void fix_tail(size_t vec_len)
+  void fix_tail(size_t bytes)
   {
-    bzero(dims + vec_len, (MY_ALIGN(vec_len, AVX512_dims) - vec_len)*2);
+    bzero((uchar*)dims + bytes, MY_ALIGN(bytes, AVX512_bytes) - bytes);
   }
 #endif
 
@@ -216,16 +293,31 @@ struct FVector
     return static_cast<float>(d);
   }
 
-  static size_t alloc_size(size_t n)
-  { return alloc_header + MY_ALIGN(n * 2, NEON_bytes) + NEON_bytes - 1; }
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int32x4_t d= vdupq_n_s32(0);
+    for (size_t i= 0; i < (len + NEON_bytes - 1) / NEON_bytes; i++)
+    {
+      int8x16_t p1= vld1q_s8(v1);
+      int8x16_t p2= vld1q_s8(v2);
+      d= vpadalq_s16(d, vmull_s8(vget_low_s8(p1), vget_low_s8(p2)));
+      d= vpadalq_s16(d, vmull_high_s8(p1, p2));
+      v1+= NEON_bytes;
+      v2+= NEON_bytes;
+    }
+    return static_cast<float>(vaddvq_s32(d));
+  }
+
+  static size_t alloc_size(size_t bytes)
+  { return alloc_header + MY_ALIGN(bytes, NEON_bytes) + NEON_bytes - 1; }
 
   static FVector *align_ptr(void *ptr)
   { return (FVector*) (MY_ALIGN(((intptr) ptr) + alloc_header, NEON_bytes)
                        - alloc_header); }
 
-  void fix_tail(size_t vec_len)
+  void fix_tail(size_t bytes)
   {
-    bzero(dims + vec_len, (MY_ALIGN(vec_len, NEON_dims) - vec_len) * 2);
+    bzero((uchar*)dims + bytes, MY_ALIGN(bytes, NEON_bytes) - bytes);
   }
 #endif
 
@@ -241,7 +333,16 @@ struct FVector
   }
 
   DEFAULT_IMPLEMENTATION
-  static size_t alloc_size(size_t n) { return alloc_header + n*2; }
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int64_t d= 0;
+    for (size_t i= 0; i < len; i++)
+      d+= int32_t(v1[i]) * int32_t(v2[i]);
+    return static_cast<float>(d);
+  }
+
+  DEFAULT_IMPLEMENTATION
+  static size_t alloc_size(size_t bytes) { return alloc_header + bytes; }
 
   DEFAULT_IMPLEMENTATION
   static FVector *align_ptr(void *ptr) { return (FVector*)ptr; }
@@ -250,10 +351,14 @@ struct FVector
   void fix_tail(size_t) {  }
 #endif
 
-  float distance_to(const FVector *other, size_t vec_len) const
+  static size_t alloc_size(size_t n, quantization_type q)
+  { return alloc_size(n * dim_size(q)); }
+
+  float distance_to(const FVector *other, size_t vec_len,
+                    quantization_type q) const
   {
     return abs2 + other->abs2 - scale * other->scale *
-           dot_product(dims, other->dims, vec_len);
+           dot_product(other, vec_len, q);
   }
 };
 #pragma pack(pop)
@@ -319,7 +424,7 @@ class FVectorNode
   const FVector *vec= nullptr;
   Neighborhood *neighbors= nullptr;
   uint8_t max_layer;
-  bool stored:1, deleted:1;
+  bool stored:1, deleted:1, dirty:1;
 
   FVectorNode(MHNSW_Share *ctx_, const void *gref_);
   FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
@@ -328,6 +433,7 @@ class FVectorNode
   int load(TABLE *graph);
   int load_from_record(TABLE *graph);
   int save(TABLE *graph);
+  int save_or_defer(TABLE *graph);
   size_t tref_len() const;
   size_t gref_len() const;
   uchar *gref() const;
@@ -368,7 +474,7 @@ class MHNSW_Share : public Sql_alloc
   void *alloc_node_internal()
   {
     return alloc_root(&root, sizeof(FVectorNode) + gref_len + tref_len
-                      + FVector::alloc_size(vec_len));
+                      + FVector::alloc_size(vec_len, quantization));
   }
 
 protected:
@@ -384,16 +490,20 @@ class MHNSW_Share : public Sql_alloc
   Atomic_relaxed<double> ef_power{0.6}; // for the bloom filter size heuristic
   Atomic_relaxed<float>  diameter{0};   // for the generosity heuristic
   FVectorNode *start= 0;
+  bool defer_writes= false;             // see mhnsw_start_bulk_insert()
+  size_t dirty_nodes= 0;                // changed, but not saved yet
   const uint tref_len;
   const uint gref_len;
   const uint M;
   metric_type metric;
+  quantization_type quantization;
 
   MHNSW_Share(TABLE *t)
     : tref_len(t->file->ref_length),
       gref_len(t->hlindex->file->ref_length),
       M(static_cast<uint>(t->s->key_info[t->s->keys].option_struct->M)),
-      metric(t->s->key_info[t->s->keys].option_struct->metric)
+      metric(t->s->key_info[t->s->keys].option_struct->metric),
+      quantization(t->s->key_info[t->s->keys].option_struct->quantization)
   {
     mysql_rwlock_init(PSI_INSTRUMENT_ME, &commit_lock);
     mysql_mutex_init(PSI_INSTRUMENT_ME, &cache_lock, MY_MUTEX_INIT_FAST);
@@ -441,6 +551,15 @@ class MHNSW_Share : public Sql_alloc
 
   virtual void reset(TABLE_SHARE *share)
   {
+    if (defer_writes)
+    {
+      // the graph is private to this connection, can be cleared in place
+      node_cache.clear();
+      free_root(&root, MYF(0));
+      start= 0;
+      dirty_nodes= 0;
+      return;
+    }
     share->lock_share();
     if (static_cast<MHNSW_Share*>(share->hlindex->hlindex_data) == this)
     {
@@ -459,7 +578,7 @@ class MHNSW_Share : public Sql_alloc
   {
     if (can_commit)
       mysql_rwlock_unlock(&commit_lock);
-    if (root_size(&root) > mhnsw_max_cache_size)
+    if (cache_is_full() && !dirty_nodes)
       reset(share);
     if (--refcnt == 0)
       this->~MHNSW_Share(); // XXX reuse
@@ -512,6 +631,22 @@ class MHNSW_Share : public Sql_alloc
     return node;
   }
 
+  bool cache_is_full()
+  {
+    return root_size(&root) > mhnsw_max_cache_size;
+  }
+
+  /* write all nodes changed with FVectorNode::save_or_defer() */
+  int flush_deferred(TABLE *graph)
+  {
+    for (FVectorNode &node : node_cache)
+      if (node.dirty)
+        if (int err= node.save(graph))
+          return err;
+    DBUG_ASSERT(dirty_nodes == 0);
+    return 0;
+  }
+
   void *alloc_neighborhood(size_t max_layer)
   {
     mysql_mutex_lock(&cache_lock);
@@ -545,11 +680,12 @@ class MHNSW_Trx : public MHNSW_Share
     node_cache.clear();
     free_root(&root, MYF(0));
     start= 0;
+    dirty_nodes= 0;
     list_of_nodes_is_lost= true;
   }
   void release(bool, TABLE_SHARE *) override
   {
-    if (--refcnt == 0 && root_size(&root) > mhnsw_max_cache_size)
+    if (--refcnt == 0 && cache_is_full() && !dirty_nodes)
       reset(nullptr);
   }
 
@@ -592,7 +728,10 @@ int MHNSW_Trx::do_savepoint_rollback(THD *thd, void *)
 {
   for (auto trx= static_cast<MHNSW_Trx*>(thd_get_ha_data(thd, &tp));
        trx; trx= trx->next)
+  {
+    trx->defer_writes= false;
     trx->reset(nullptr);
+  }
   return 0;
 }
 
@@ -728,7 +867,8 @@ int MHNSW_Share::acquire(MHNSW_Share **ctx, TABLE *table, bool for_update)
     return err;
 
   graph->file->position(graph->record[0]);
-  (*ctx)->set_lengths(FVector::data_to_value_size(graph->field[FIELD_VEC]->value_length()));
+  (*ctx)->set_lengths(FVector::data_to_value_size(
+                        graph->field[FIELD_VEC]->value_length(), (*ctx)->quantization));
 
   auto node= (*ctx)->get_node(graph->file->ref);
   if ((err= node->load_from_record(graph)))
@@ -741,18 +881,19 @@ int MHNSW_Share::acquire(MHNSW_Share **ctx, TABLE *table, bool for_update)
 /* copy the vector, preprocessed as needed */
 const FVector *FVectorNode::make_vec(const void *v)
 {
-  return FVector::create(ctx->metric, tref() + tref_len(), v, ctx->byte_len);
+  return FVector::create(ctx->metric, ctx->quantization, tref() + tref_len(), v,
+                         ctx->byte_len);
 }
 
 FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *gref_)
-  : ctx(ctx_), stored(true), deleted(false)
+  : ctx(ctx_), stored(true), deleted(false), dirty(false)
 {
   memcpy(gref(), gref_, gref_len());
 }
 
 FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
                          const void *vec_)
-  : ctx(ctx_), stored(false), deleted(false)
+  : ctx(ctx_), stored(false), deleted(false), dirty(false)
 {
   DBUG_ASSERT(tref_);
   memset(gref(), 0xff, gref_len()); // important: larger than any real gref
@@ -764,7 +905,7 @@ FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
 
 float FVectorNode::distance_to(const FVector *other) const
 {
-  return vec->distance_to(other, ctx->vec_len);
+  return vec->distance_to(other, ctx->vec_len, ctx->quantization);
 }
 
 int FVectorNode::alloc_neighborhood(uint8_t layer)
@@ -815,11 +956,11 @@ int FVectorNode::load_from_record(TABLE *graph)
   if (unlikely(!v))
     return my_errno= HA_ERR_CRASHED;
 
-  if (v->length() != FVector::data_size(ctx->vec_len))
+  if (v->length() != FVector::data_size(ctx->vec_len, ctx->quantization))
     return my_errno= HA_ERR_CRASHED;
   FVector *vec_ptr= FVector::align_ptr(tref() + tref_len());
   memcpy(vec_ptr->data(), v->ptr(), v->length());
-  vec_ptr->postprocess(ctx->vec_len);
+  vec_ptr->postprocess(ctx->vec_len, ctx->quantization);
 
   longlong layer= graph->field[FIELD_LAYER]->val_int();
   if (layer > 100) // 10e30 nodes at M=2, more at larger M's
@@ -991,7 +1132,8 @@ int FVectorNode::save(TABLE *graph)
     graph->field[FIELD_TREF]->set_notnull();
     graph->field[FIELD_TREF]->store_binary(tref(), tref_len());
   }
-  graph->field[FIELD_VEC]->store_binary(vec->data(), FVector::data_size(ctx->vec_len));
+  graph->field[FIELD_VEC]->store_binary(vec->data(),
+                         FVector::data_size(ctx->vec_len, ctx->quantization));
 
   size_t total_size= 0;
   for (size_t i=0; i <= max_layer; i++)
@@ -1025,10 +1167,35 @@ int FVectorNode::save(TABLE *graph)
     stored= true;
     ctx->cache_node(this);
   }
+  if (dirty)
+  {
+    dirty= false;
+    ctx->dirty_nodes--;
+  }
   my_safe_afree(neighbor_blob, total_size);
   return err;
 }
 
+/*
+  Save the node, or only mark it changed if writes are deferred.
+
+  Every insert rewrites up to 2*M existing nodes to update their neighbor
+  lists. In a bulk insert the same nodes are rewritten over and over,
+  deferring writes until MHNSW_Share::flush_deferred() saves each of them
+  only once.
+*/
+int FVectorNode::save_or_defer(TABLE *graph)
+{
+  if (!ctx->defer_writes || !stored)
+    return save(graph);
+  if (!dirty)
+  {
+    dirty= true;
+    ctx->dirty_nodes++;
+  }
+  return 0;
+}
+
 static int update_second_degree_neighbors(MHNSW_Share *ctx, TABLE *graph,
                                           size_t layer, FVectorNode *node)
 {
@@ -1045,7 +1212,7 @@ static int update_second_degree_neighbors(MHNSW_Share *ctx, TABLE *graph,
       if (int err= select_neighbors(ctx, graph, layer, *neigh, neighneighbors,
                                     node, max_neighbors))
         return err;
-    if (int err= neigh->save(graph))
+    if (int err= neigh->save_or_defer(graph))
       return err;
   }
   return 0;
@@ -1062,12 +1229,54 @@ static inline float generous_furthest(const Queue<Visited> &q, float maxd, float
   return d*(1 + (g - 1)/2 * (1 - sigmoid));
 }
 
+/*
+  WHERE condition and rowid filter pushed into the graph search
+
+  Nodes that don't match are traversed like deleted nodes, but never
+  returned. This way a selective WHERE doesn't make ORDER BY ... LIMIT
+  return less rows than requested.
+*/
+struct Search_filter: public Sql_alloc
+{
+  TABLE *table;
+  Item *cond;
+  Rowid_filter *rowid_filter;
+  int error= 0;
+
+  Search_filter(TABLE *t, Item *c, Rowid_filter *f)
+    : table(t), cond(c), rowid_filter(f) {}
+
+  bool matches(FVectorNode *node)
+  {
+    if (error)
+      return false;
+    if (rowid_filter && !rowid_filter->check((char*)node->tref()))
+      return false;
+    if (!cond)
+      return true;
+    /* a selective condition can make the search visit the whole graph */
+    if (table->in_use->check_killed(1))
+    {
+      error= HA_ERR_ABORTED_BY_USER;
+      return false;
+    }
+    if (int err= table->file->ha_rnd_pos(table->record[0], node->tref()))
+    {
+      error= err;
+      return false;
+    }
+    return cond->val_bool();
+  }
+};
+
 /*
   @param[in/out] inout    in: start nodes, out: result nodes
+  @param[in]     filter   only used on layer 0 when not in construction
 */
 static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
                         float threshold, uint result_size,
-                        size_t layer, Neighborhood *inout, bool construction)
+                        size_t layer, Neighborhood *inout, bool construction,
+                        Search_filter *filter)
 {
   DBUG_ASSERT(inout->num > 0);
 
@@ -1086,6 +1295,8 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
   else
   {
     skip_deleted= layer == 0;
+    if (!skip_deleted)
+      filter= nullptr;
     if (ef > 1 || layer == 0)
       ef= std::max(THDVAR(graph->in_use, ef_search), ef);
   }
@@ -1098,6 +1309,12 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
   candidates.init(max_ef, false, Visited::cmp);
   best.init(ef, true, Visited::cmp);
 
+  auto skip= [skip_deleted, filter](const Visited *v)
+  {
+    return skip_deleted && (v->node->deleted ||
+                            (filter && !filter->matches(v->node)));
+  };
+
   DBUG_ASSERT(inout->num <= result_size);
   float max_distance= ctx->diameter;
   for (size_t i=0; i < inout->num; i++)
@@ -1105,7 +1322,7 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
     Visited *v= visited.create(inout->links[i]);
     max_distance= std::max(max_distance, v->distance_to_target);
     candidates.push(v);
-    if ((skip_deleted && v->node->deleted) || threshold > NEAREST)
+    if (threshold > NEAREST || skip(v))
       continue;
     best.push(v);
   }
@@ -1114,6 +1331,8 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
                        : generous_furthest(best, max_distance, generosity);
   while (candidates.elements())
   {
+    if (filter && filter->error)
+      return filter->error;
     const Visited &cur= *candidates.pop();
     if (cur.distance_to_target > furthest_best && best.is_full())
       break; // All possible candidates are worse than what we have
@@ -1141,7 +1360,7 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
         {
           max_distance= std::max(max_distance, v->distance_to_target);
           candidates.safe_push(v);
-          if (skip_deleted && v->node->deleted)
+          if (skip(v))
             continue;
           best.push(v);
           furthest_best= generous_furthest(best, max_distance, generosity);
@@ -1149,7 +1368,7 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
         else if (v->distance_to_target < furthest_best)
         {
           candidates.safe_push(v);
-          if (skip_deleted && v->node->deleted)
+          if (skip(v))
             continue;
           if (v->distance_to_target < best.top()->distance_to_target)
           {
@@ -1160,6 +1379,9 @@ static int search_layer(MHNSW_Share *ctx, TABLE *graph, const FVector *target,
       }
     }
   }
+  if (filter && filter->error)
+    return filter->error;
+
   set_if_bigger(ctx->diameter, max_distance); // not atomic, but it's ok
   if (ef > 1 && visited.count*2 > est_size)
   {
@@ -1243,15 +1465,15 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
   for (cur_layer= max_layer; cur_layer > target_layer; cur_layer--)
   {
     if (int err= search_layer(ctx, graph, target->vec, NEAREST,
-                              1, cur_layer, &candidates, false))
+                              1, cur_layer, &candidates, false, nullptr))
       return err;
   }
 
   for (; cur_layer >= 0; cur_layer--)
   {
     uint max_neighbors= ctx->max_neighbors(cur_layer);
-    if (int err= search_layer(ctx, graph, target->vec, NEAREST,
-                              max_neighbors, cur_layer, &candidates, true))
+    if (int err= search_layer(ctx, graph, target->vec, NEAREST, max_neighbors,
+                              cur_layer, &candidates, true, nullptr))
       return err;
 
     if (int err= select_neighbors(ctx, graph, cur_layer, *target, candidates,
@@ -1271,6 +1493,11 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
       return err;
   }
 
+  // release() won't free a full cache until deferred changes are saved
+  if (ctx->dirty_nodes && ctx->cache_is_full())
+    if (int err= ctx->flush_deferred(graph))
+      return err;
+
   dbug_tmp_restore_column_map(&table->read_set, old_map);
 
   return 0;
@@ -1279,18 +1506,206 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
 
 struct Search_context: public Sql_alloc
 {
+  /* a candidate ordered by the exact distance, see rerank() */
+  struct Ranked
+  {
+    double distance;
+    FVectorNode *node;
+    size_t row;                         // offset in rows, or NO_ROW
+  };
+  static constexpr size_t NO_ROW= SIZE_MAX;
+  static constexpr size_t MISSING= SIZE_MAX - 1;
+
   Neighborhood found;
   MHNSW_Share *ctx;
   const FVector *target;
+  Item *rerank_by;                      // exact distance, or NULL
+  Search_filter *filter;                // pushed WHERE, or NULL
   ulonglong ctx_version;
   size_t pos= 0;
   float threshold= NEAREST/2;
-  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v)
-    : found(*n), ctx(s->dup(false)), target(v), ctx_version(ctx->version) {}
+  size_t capacity;                      // max number of found nodes
+  Ranked *ranked= nullptr;              // capacity elements, if rerank_by
+  uchar *rows= nullptr;                 // row images of the ranked nodes
+  size_t rows_size= 0;
+  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v, Item *d,
+                 Search_filter *f, size_t c)
+    : found(*n), ctx(s->dup(false)), target(v), rerank_by(d), filter(f),
+      ctx_version(ctx->version), capacity(c) {}
+
+  /* the graph distance to the furthest found node */
+  float furthest() const
+  {
+    if (!rerank_by)
+      return found.links[found.num-1]->distance_to(target);
+    float d= 0;
+    for (size_t i=0; i < found.num; i++)
+      d= std::max(d, found.links[i]->distance_to(target));
+    return d;
+  }
+
+  int rerank(TABLE *table);
+  int read_row(TABLE *table, size_t i);
+
+private:
+  int save_row(TABLE *table, size_t *used);
+  void restore_row(TABLE *table, size_t offset) const;
 };
 
 
-int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
+/* Append the row in record[0] and the blobs it points to to rows */
+int Search_context::save_row(TABLE *table, size_t *used)
+{
+  TABLE_SHARE *share= table->s;
+  size_t len= share->reclength;
+  for (uint i=0; i < share->blob_fields; i++)
+  {
+    auto blob= static_cast<Field_blob*>(table->field[share->blob_field[i]]);
+    if (bitmap_is_set(table->read_set, blob->field_index) && !blob->is_null())
+      len+= blob->get_length();
+  }
+
+  if (*used + len > rows_size)
+  {
+    /* grow geometrically, the memory is only freed at the end of the query */
+    size_t size= std::max(2 * rows_size, *used + len);
+    uchar *buf= table->in_use->alloc<uchar>(size);
+    if (!buf)
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    if (*used)
+      memcpy(buf, rows, *used);
+    rows= buf;
+    rows_size= size;
+  }
+
+  uchar *p= rows + *used;
+  memcpy(p, table->record[0], share->reclength);
+  p+= share->reclength;
+  for (uint i=0; i < share->blob_fields; i++)
+  {
+    auto blob= static_cast<Field_blob*>(table->field[share->blob_field[i]]);
+    if (bitmap_is_set(table->read_set, blob->field_index) && !blob->is_null())
+    {
+      uint32 length= blob->get_length();
+      if (length)
+        memcpy(p, blob->get_ptr(), length);
+      p+= length;
+    }
+  }
+  *used+= len;
+  return 0;
+}
+
+
+/* Copy a row saved by save_row() to record[0] */
+void Search_context::restore_row(TABLE *table, size_t offset) const
+{
+  TABLE_SHARE *share= table->s;
+  uchar *p= rows + offset;
+  memcpy(table->record[0], p, share->reclength);
+  p+= share->reclength;
+  for (uint i=0; i < share->blob_fields; i++)
+  {
+    auto blob= static_cast<Field_blob*>(table->field[share->blob_field[i]]);
+    if (bitmap_is_set(table->read_set, blob->field_index) && !blob->is_null())
+    {
+      uint32 length= blob->get_length();
+      blob->set_ptr(length, p);
+      p+= length;
+    }
+  }
+}
+
+
+/*
+  Reorder found nodes by the exact distance
+
+  Distances calculated on INT8 quantized vectors are good enough to navigate
+  the graph, but not to order the result. Read every candidate row from the
+  base table and sort candidates by the full-precision distance.
+
+  The rows are kept, so that read_row() does not have to read them again,
+  but only if handler::position() takes the rowid from the PRIMARY KEY in
+  record[0]. Other engines (MyISAM, Aria) return the position of the last
+  row that was read, so read_row() has to read the row again, like a row
+  that is going to be modified. Candidates whose row can no longer be
+  found are moved to the end and skipped by read_row().
+*/
+int Search_context::rerank(TABLE *table)
+{
+  if (!rerank_by)
+    return 0;
+
+  if (!ranked && !(ranked= table->in_use->alloc<Ranked>(capacity)))
+    return my_errno= HA_ERR_OUT_OF_MEM;
+
+  DBUG_ASSERT(found.num <= capacity);
+  const bool keep_rows= table->reginfo.lock_type < TL_FIRST_WRITE &&
+    (table->file->ha_table_flags() & HA_PRIMARY_KEY_REQUIRED_FOR_POSITION) &&
+    table->s->primary_key != MAX_KEY;
+  size_t used= 0;
+  for (size_t i=0; i < found.num; i++)
+  {
+    Ranked &r= ranked[i];
+    r= { DBL_MAX, found.links[i], MISSING };
+    switch (int err= table->file->ha_rnd_pos(table->record[0], r.node->tref())) {
+    case 0:
+      break;
+    case HA_ERR_RECORD_DELETED:
+    case HA_ERR_KEY_NOT_FOUND:
+      continue;
+    default:
+      return err;
+    }
+    r.distance= rerank_by->val_real();
+    r.row= NO_ROW;
+    if (keep_rows)
+    {
+      r.row= used;
+      if (int err= save_row(table, &used))
+        return err;
+    }
+  }
+  std::stable_sort(ranked, ranked + found.num,
+                   [](const Ranked &a, const Ranked &b)
+                   { return a.distance < b.distance; });
+  for (size_t i=0; i < found.num; i++)
+    found.links[i]= ranked[i].node;
+  return 0;
+}
+
+
+/*
+  Read the row of the i-th found node to record[0]
+
+  @return HA_ERR_RECORD_DELETED if rerank() did not find the row
+*/
+int Search_context::read_row(TABLE *table, size_t i)
+{
+  if (rerank_by)
+  {
+    DBUG_ASSERT(ranked[i].node == found.links[i]);
+    switch (size_t row= ranked[i].row) {
+    case MISSING:
+      return HA_ERR_RECORD_DELETED;
+    case NO_ROW:
+      break;
+    default:
+      restore_row(table, row);
+      return 0;
+    }
+  }
+  return table->file->ha_rnd_pos(table->record[0], found.links[i]->tref());
+}
+
+
+/*
+  @param cond           WHERE condition for the table to check during the
+                        search, or NULL
+  @param rowid_filter   rowid filter to check during the search, or NULL
+*/
+int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit,
+                     Item *cond, Rowid_filter *rowid_filter)
 {
   THD *thd= table->in_use;
   TABLE *graph= table->hlindex;
@@ -1300,6 +1715,7 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   limit= std::min<ulonglong>(limit, max_ef);
 
   String buf, *res= fun->get_const_arg()->val_str(&buf);
+  Item *rerank_by= fun;
   MHNSW_Share *ctx;
 
   if (int err= table->file->ha_rnd_init(0))
@@ -1324,6 +1740,7 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   */
   if (!res || ctx->byte_len != res->length())
   {
+    rerank_by= nullptr;
     res= &buf;
     buf.alloc(ctx->byte_len);
     buf.length(ctx->byte_len);
@@ -1332,8 +1749,13 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   }
 
   const longlong max_layer= candidates.links[0]->max_layer;
-  auto target= FVector::create(ctx->metric, thd->alloc(FVector::alloc_size(ctx->vec_len)),
-                               res->ptr(), res->length());
+  auto target= FVector::create(ctx->metric, ctx->quantization,
+                 thd->alloc(FVector::alloc_size(ctx->vec_len, ctx->quantization)),
+                 res->ptr(), res->length());
+
+  Search_filter *filter= nullptr;
+  if (cond || rowid_filter)
+    filter= new (thd->mem_root) Search_filter(table, cond, rowid_filter);
 
   if (int err= graph->file->ha_rnd_init(0))
     return err;
@@ -1341,7 +1763,7 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   for (size_t cur_layer= max_layer; cur_layer > 0; cur_layer--)
   {
     if (int err= search_layer(ctx, graph, target, NEAREST,
-                              1, cur_layer, &candidates, false))
+                              1, cur_layer, &candidates, false, nullptr))
     {
       graph->file->ha_rnd_end();
       return err;
@@ -1349,25 +1771,34 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   }
 
   if (int err= search_layer(ctx, graph, target, NEAREST,
-                            static_cast<uint>(limit), 0, &candidates, false))
+                            static_cast<uint>(limit), 0, &candidates, false,
+                            filter))
   {
     graph->file->ha_rnd_end();
     return err;
   }
 
-  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target);
+  if (ctx->quantization != QUANT_INT8)
+    rerank_by= nullptr;
+
+  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target,
+                                                  rerank_by, filter, limit);
   graph->context= result;
 
+  if (int err= result->rerank(table))
+    return err;
+
   return mhnsw_read_next(table);
 }
 
 int mhnsw_read_next(TABLE *table)
 {
   auto result= static_cast<Search_context*>(table->hlindex->context);
-  if (result->pos < result->found.num)
+  while (result->pos < result->found.num)
   {
-    uchar *ref= result->found.links[result->pos++]->tref();
-    return table->file->ha_rnd_pos(table->record[0], ref);
+    int err= result->read_row(table, result->pos++);
+    if (err != HA_ERR_RECORD_DELETED || !result->rerank_by)
+      return err;
   }
   if (!result->found.num)
     return my_errno= HA_ERR_END_OF_FILE;
@@ -1402,13 +1833,16 @@ int mhnsw_read_next(TABLE *table)
     std::swap(trx, ctx);        // free shared ctx in this scope, keep trx
   }
 
-  float new_threshold= result->found.links[result->found.num-1]->distance_to(result->target);
+  float new_threshold= result->furthest();
 
   if (int err= search_layer(ctx, graph, result->target, result->threshold,
-                   static_cast<uint>(result->pos), 0, &result->found, false))
+                   static_cast<uint>(result->pos), 0, &result->found, false,
+                   result->filter))
     return err;
   result->pos= 0;
   result->threshold= new_threshold + FLT_EPSILON;
+  if (int err= result->rerank(table))
+    return err;
   return mhnsw_read_next(table);
 }
 
@@ -1473,6 +1907,84 @@ int mhnsw_invalidate(TABLE *table, const uchar *rec, KEY *keyinfo)
   return 0;
 }
 
+/*
+  Bulk insert (ALTER TABLE, LOAD DATA, multi-row INSERT) that builds
+  a vector index from an empty graph.
+
+  Neighbor list updates are kept in memory and written once per node in
+  mhnsw_end_bulk_insert() or when the cache is full. It is only done when
+  the graph is private to this connection, that is, for MHNSW_Trx of
+  transactional engines and for temporary tables (e.g. the new table in
+  ALTER TABLE), otherwise a concurrent reader could reset the shared cache
+  and lose unsaved changes.
+
+  This does not make the build parallel: mhnsw_insert() still adds one
+  vector at a time, because nodes can only be loaded through the
+  connection's own graph handler.
+
+  @return whether writes are deferred, and mhnsw_end_bulk_insert() must
+  be called
+*/
+bool mhnsw_start_bulk_insert(TABLE *table, KEY *keyinfo)
+{
+  DBUG_ASSERT(keyinfo->algorithm == HA_KEY_ALG_VECTOR);
+
+  if (!table->file->has_transactions() && table->s->tmp_table == NO_TMP_TABLE)
+    return false;
+
+  MHNSW_Share *ctx;
+  int err= MHNSW_Share::acquire(&ctx, table, true);
+  SCOPE_EXIT([ctx, table](){ ctx->release(table); });
+  if (err != HA_ERR_END_OF_FILE)
+    return false;
+  ctx->defer_writes= true;
+  return true;
+}
+
+/*
+  @param abort  the statement ended without handler::ha_end_bulk_insert()
+*/
+int mhnsw_end_bulk_insert(TABLE *table, KEY *keyinfo, bool abort)
+{
+  TABLE *graph= table->hlindex;
+  DBUG_ASSERT(keyinfo->algorithm == HA_KEY_ALG_VECTOR);
+
+  if (abort && table->file->has_transactions())
+  {
+    /*
+      The statement was rolled back, and MHNSW_Trx with it, unless it is
+      a part of a larger transaction. Do not start a new one here.
+    */
+    if (MHNSW_Trx *trx= MHNSW_Trx::get_from_thd(table, false))
+    {
+      trx->defer_writes= false;
+      trx->reset(nullptr);
+      trx->release(false, nullptr);
+    }
+    return 0;
+  }
+
+  MHNSW_Share *ctx;
+  int err= MHNSW_Share::acquire(&ctx, table, true);
+  /* whatever happens below, writes are no longer deferred */
+  SCOPE_EXIT([ctx, table](){ ctx->defer_writes= false; ctx->release(table); });
+  if (err)
+    return err == HA_ERR_END_OF_FILE ? 0 : err;
+  if (!ctx->defer_writes)
+    return 0;
+
+  /*
+    The changes of a non-transactional table stay, so the graph must be
+    written even if the statement failed
+  */
+  if ((err= graph->file->ha_rnd_init(0)))
+    return err;
+  if ((err= ctx->flush_deferred(graph)))
+    ctx->reset(table->s);               // forget the unsaved changes
+  graph->file->ha_rnd_end();
+  return err;
+}
+
 int mhnsw_delete_all(TABLE *table, KEY *keyinfo, bool truncate)
 {
   TABLE *graph= table->hlindex;
@@ -1526,6 +2038,7 @@ ha_create_table_option mhnsw_index_options[]=
 {
   HA_IOPTION_SYSVAR("m", M, default_m),
   HA_IOPTION_SYSVAR("distance", metric, default_distance),
+  HA_IOPTION_ENUM("quantization", quantization, "int16,int8", QUANT_INT16),
   HA_IOPTION_END
 };
 
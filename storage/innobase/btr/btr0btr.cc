@@ -5156,6 +5156,161 @@ btr_validate_index(
   return err;
 }
 
+/** Divide an index into key ranges for a parallel scan,
+using the node pointers on the highest level of the tree that has
+enough of them, or on the level above the leaf pages.
+@param index	B-tree index
+@param n	desired number of ranges
+@param heap	memory heap for the boundaries
+@param bounds	boundaries between the ranges
+@param leaves	nullptr, or the first leaf page of each range; only valid
+while the caller prevents changes to the structure of the tree
+@return error code */
+dberr_t btr_split_key_ranges(dict_index_t *index, ulint n, mem_heap_t *heap,
+			     std::vector<const dtuple_t*> &bounds,
+			     std::vector<uint32_t> *leaves)
+{
+	mtr_t		mtr;
+	dberr_t		err;
+	mem_heap_t*	offsets_heap = nullptr;
+	rec_offs*	offsets = nullptr;
+	const ulint	n_uniq = dict_index_get_n_unique_in_tree_nonleaf(index);
+	std::vector<uint32_t>	pages{index->page};
+	std::vector<uint32_t>	children;
+	ulint			pages_level;
+
+	mtr.start();
+	/* Prevent any changes to the structure of the tree. */
+	mtr_s_lock_index(index, &mtr);
+
+	const buf_block_t* root = btr_root_block_get(index, RW_S_LATCH,
+						     &mtr, &err);
+	if (!root) {
+		goto func_exit;
+	}
+
+	pages_level = btr_page_get_level(root->page.frame);
+
+	/* After the loop, pages[r] will be the root of the subtree
+	of range r, on pages_level. */
+	for (ulint level = pages_level; level; level--) {
+		bounds.clear();
+		children.clear();
+
+		for (uint32_t page_no : pages) {
+			const buf_block_t* block = btr_block_get(
+				*index, page_no, RW_S_LATCH, &mtr, &err);
+			if (!block) {
+				goto func_exit;
+			}
+
+			const page_t* page = block->page.frame;
+			const auto comp = page_is_comp(page);
+			const rec_t* rec = page_rec_get_next_const(
+				page_get_infimum_rec(page));
+
+			if (btr_page_get_level(page) != level) {
+				rec = nullptr;
+			}
+
+			for (; rec && !page_rec_is_supremum(rec);
+			     rec = page_rec_get_next_const(rec)) {
+				offsets = rec_get_offsets(rec, index, offsets,
+							  0, ULINT_UNDEFINED,
+							  &offsets_heap);
+				children.push_back(
+					btr_node_ptr_get_child_page_no(
+						rec, offsets));
+
+				if (rec_get_info_bits(rec, comp)
+				    & REC_INFO_MIN_REC_FLAG) {
+					/* The leftmost node pointer
+					on the level */
+					continue;
+				}
+
+				dtuple_t* tuple = dtuple_create(heap, n_uniq);
+				dict_index_copy_types(tuple, index, n_uniq);
+				rec_copy_prefix_to_dtuple(tuple, rec, index, 0,
+							  n_uniq, heap);
+				dtuple_set_info_bits(tuple, 0);
+				bounds.push_back(tuple);
+			}
+
+			mtr.release_last_page();
+
+			if (!rec) {
+				err = DB_CORRUPTION;
+				goto func_exit;
+			}
+		}
+
+		pages.swap(children);
+		pages_level = level - 1;
+
+		if (bounds.size() >= n) {
+			break;
+		}
+	}
+
+	if (leaves && !pages_level) {
+		/* The root page is the only leaf page. */
+		*leaves = pages;
+	} else if (leaves) {
+		/* Descend to the leftmost leaf page of each subtree. */
+		leaves->clear();
+
+		for (uint32_t page_no : pages) {
+			for (ulint level = pages_level;; level--) {
+				const buf_block_t* block = btr_block_get(
+					*index, page_no, RW_S_LATCH, &mtr,
+					&err);
+				if (!block) {
+					goto func_exit;
+				}
+
+				const page_t* page = block->page.frame;
+
+				if (btr_page_get_level(page) != level) {
+					err = DB_CORRUPTION;
+					goto func_exit;
+				}
+
+				if (!level) {
+					mtr.release_last_page();
+					break;
+				}
+
+				const rec_t* rec = page_rec_get_next_const(
+					page_get_infimum_rec(page));
+
+				if (!rec || page_rec_is_supremum(rec)) {
+					err = DB_CORRUPTION;
+					goto func_exit;
+				}
+
+				offsets = rec_get_offsets(rec, index, offsets,
+							  0, ULINT_UNDEFINED,
+							  &offsets_heap);
+				page_no = btr_node_ptr_get_child_page_no(
+					rec, offsets);
+				mtr.release_last_page();
+			}
+
+			leaves->push_back(page_no);
+		}
+	}
+
+func_exit:
+	mtr.commit();
+
+	if (offsets_heap) {
+		mem_heap_free(offsets_heap);
+	}
+
+	return err;
+}
+
 /**************************************************************//**
 Checks if the page in the cursor can be merged with given page.
 If necessary, re-organize the merge_page.
@@ -1863,6 +1863,62 @@ dberr_t btr_cur_search_to_nth_level(ulint level,
   goto search_loop;
 }
 
+void btr_cur_prefetch_leaf(dict_index_t *index, const dtuple_t *tuple)
+{
+  ut_ad(index->is_btree());
+  ut_ad(dtuple_check_typed(tuple));
+
+  fil_space_t *space= index->table->space;
+  if (!space || index->page == FIL_NULL)
+    return;
+
+  mem_heap_t *heap= nullptr;
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs *offsets= offsets_;
+  rec_offs_init(offsets_);
+
+  mtr_t mtr;
+  mtr.start();
+
+  uint32_t page_no= index->page, leaf= FIL_NULL;
+  page_cur_t cur;
+  cur.index= index;
+
+  /* Descend with latch coupling, like BTR_SEARCH_LEAF: only the current
+  page and its parent are latched, and not the index. */
+  while (buf_block_t *block= btr_block_get(*index, page_no, RW_S_LATCH, &mtr))
+  {
+    if (mtr.get_savepoint() > 1)
+      mtr.rollback_to_savepoint(0, 1);
+    const uint32_t page_level= btr_page_get_level(block->page.frame);
+    /* A tree of one page has no leaf to read. */
+    if (!page_level)
+      break;
+
+    cur.block= block;
+    uint16_t up_match= 0, low_match= 0;
+    if (page_cur_search_with_match(tuple, PAGE_CUR_L, &up_match, &low_match,
+                                   &cur, nullptr))
+      break;
+    offsets= rec_get_offsets(cur.rec, index, offsets, 0, ULINT_UNDEFINED,
+                             &heap);
+    page_no= btr_node_ptr_get_child_page_no(cur.rec, offsets);
+    if (page_level == 1)
+    {
+      leaf= page_no;
+      break;
+    }
+  }
+
+  mtr.commit();
+  if (UNIV_LIKELY_NULL(heap))
+    mem_heap_free(heap);
+
+  if (leaf != FIL_NULL && space->acquire())
+    buf_read_page_background(space, page_id_t(space->id, leaf),
+                             space->zip_size());
+}
+
 dberr_t btr_cur_t::open_leaf(bool first, dict_index_t *index,
                              btr_latch_mode latch_mode, mtr_t *mtr)
 {
@@ -1224,6 +1224,27 @@ void buf_pool_t::page_hash_table::create(ulint n) noexcept
   array= static_cast<hash_chain*>(v);
 }
 
+#ifdef HAVE_URING
+/** Register the buffer pool chunks as fixed buffers with io_uring,
+if innodb_io_uring_fixed_buffers is set. */
+void buf_pool_t::register_io_buffers() noexcept
+{
+  if (!srv_io_uring_fixed_buffers || !srv_use_native_aio)
+    return;
+  std::vector<tpool::aio_buffer> buffers;
+  buffers.reserve(n_chunks);
+  for (const chunk_t *chunk= chunks, *const echunk= chunks + n_chunks;
+       chunk != echunk; chunk++)
+    buffers.push_back({chunk->mem, chunk->mem_size()});
+  if (int err= srv_thread_pool->register_io_buffers(buffers.data(),
+                                                   buffers.size()))
+    sql_print_warning("InnoDB: Failed to register the buffer pool"
+                      " with io_uring (errno %d)%s", -err,
+                      err == -ENOMEM || err == -EPERM
+                      ? "; check ulimit -l" : "");
+}
+#endif
+
 /** Create the buffer pool.
 @return whether the creation failed */
 bool buf_pool_t::create()
@@ -1346,6 +1367,9 @@ bool buf_pool_t::create()
 #ifdef __linux__
   if (srv_operation == SRV_OPERATION_NORMAL)
     buf_mem_pressure_detect_init();
+#endif
+#ifdef HAVE_URING
+  register_io_buffers();
 #endif
   ut_ad(is_initialised());
   return false;
@@ -1361,6 +1385,11 @@ void buf_pool_t::close() noexcept
   mysql_mutex_destroy(&mutex);
   mysql_mutex_destroy(&flush_list_mutex);
 
+#ifdef HAVE_URING
+  if (srv_io_uring_fixed_buffers && srv_thread_pool)
+    srv_thread_pool->unregister_io_buffers();
+#endif
+
   for (buf_page_t *bpage= UT_LIST_GET_LAST(LRU), *prev_bpage= nullptr; bpage;
        bpage= prev_bpage)
   {
@@ -1912,6 +1941,13 @@ inline void buf_pool_t::resize()
 
 	chunk_t::map_reg = UT_NEW_NOKEY(chunk_t::map());
 
+#ifdef HAVE_URING
+	/* the chunks will be registered again below */
+	if (srv_io_uring_fixed_buffers) {
+		srv_thread_pool->unregister_io_buffers();
+	}
+#endif
+
 	/* add/delete chunks */
 
 	buf_resize_status("Resizing buffer pool from "
@@ -2037,6 +2073,9 @@ inline void buf_pool_t::resize()
 
 	curr_size = new_size;
 	n_chunks_new = n_chunks;
+#ifdef HAVE_URING
+	register_io_buffers();
+#endif
 
 	if (chunks_old) {
 		ut_free(chunks_old);
@@ -709,6 +709,7 @@ void buf_dblwr_t::flush_buffered_writes_completed(const IORequest &request)
 
   /* The writes have been flushed to disk now and in recovery we will
   find them in the doublewrite buffer blocks. Next, write the data pages. */
+  os_aio_batch batch;
   for (ulint i= 0, first_free= flush_slot->first_free; i < first_free; i++)
   {
     auto e= flush_slot->buf_block_arr[i];
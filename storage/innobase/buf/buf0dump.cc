@@ -58,7 +58,16 @@ take after being waked up. */
 static volatile bool	buf_dump_should_start;
 static volatile bool	buf_load_should_start;
 
-static bool	buf_load_abort_flag;
+static Atomic_relaxed<bool>	buf_load_abort_flag;
+
+/** Magic bytes at the start of a dump in the compact format */
+static const char buf_dump_magic[]= "MariaDB ib_buffer_pool 1\n";
+
+/** Number of heat tiers. A dump lists the pages starting from the most
+recently used end of buf_pool.LRU, and the load reads one tier at a time,
+hottest first. Within a tier, pages are read in (space,page) order.
+The compact format stores each tier sorted and delta encoded. */
+static constexpr ulint BUF_DUMP_TIERS= 32;
 
 /** Start the buffer pool dump/load task and instructs it to start a dump. */
 void buf_dump_start()
@@ -223,6 +232,47 @@ static void buf_dump_generate_path(char *path, size_t path_size)
 }
 
 
+/** Write a variable-length unsigned integer to a compact dump.
+@param f  dump file
+@param n  value to write
+@return whether the write succeeded */
+static bool buf_dump_write_varint(FILE *f, uint32_t n)
+{
+  byte b[5], *p= b;
+  for (; n >= 0x80; n>>= 7)
+    *p++= byte(n | 0x80);
+  *p++= byte(n);
+  const size_t len= size_t(p - b);
+  return fwrite(b, 1, len, f) == len;
+}
+
+/** Write one heat tier of a compact dump: the number of pages,
+followed by (space id delta, page number delta) pairs in ascending order.
+The page number delta is relative to 0 when the tablespace changes.
+@param f      dump file
+@param first  first page of the tier
+@param last   end of the tier
+@return whether the write succeeded */
+static bool buf_dump_write_tier(FILE *f, page_id_t *first, page_id_t *last)
+{
+  std::sort(first, last);
+  if (!buf_dump_write_varint(f, uint32_t(last - first)))
+    return false;
+  uint32_t space_id= 0, page_no= 0;
+  for (; first != last; first++)
+  {
+    const uint32_t s= first->space();
+    if (s != space_id)
+      page_no= 0;
+    if (!buf_dump_write_varint(f, s - space_id) ||
+        !buf_dump_write_varint(f, first->page_no() - page_no))
+      return false;
+    space_id= s;
+    page_no= first->page_no();
+  }
+  return true;
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -349,6 +399,32 @@ buf_dump(
 	ut_a(j <= n_pages);
 	n_pages = j;
 
+	if (srv_buf_dump_format == BUF_DUMP_COMPACT) {
+		bool ok = fwrite(buf_dump_magic, sizeof buf_dump_magic - 1,
+				 1, f) == 1;
+		for (ulint t = 0; ok && t < BUF_DUMP_TIERS && !SHOULD_QUIT();
+		     t++) {
+			page_id_t* first = dump + n_pages * t / BUF_DUMP_TIERS;
+			page_id_t* last = dump
+				+ n_pages * (t + 1) / BUF_DUMP_TIERS;
+			/* Skip empty tiers, because a tier size of 0
+			terminates the dump (see buf_load_read_compact()) */
+			ok = first == last
+				|| buf_dump_write_tier(f, first, last);
+		}
+		if (!ok || !buf_dump_write_varint(f, 0)) {
+			ut_free(dump);
+			fclose(f);
+			buf_dump_status(STATUS_ERR,
+					"Cannot write to '%s': %s",
+					tmp_filename, strerror(errno));
+			/* leave tmp_filename to exist */
+			return;
+		}
+		/* Skip the text format below */
+		n_pages = 0;
+	}
+
 	for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
 		ret = fprintf(f, "%u,%u\n",
 			      dump[j].space(), dump[j].page_no());
@@ -415,12 +491,242 @@ buf_dump(
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
 }
 
+/** Read a variable-length unsigned integer from a compact dump.
+@param f  dump file
+@param n  the value
+@return whether a value was read */
+static bool buf_load_read_varint(FILE *f, uint32_t &n)
+{
+  n= 0;
+  for (unsigned shift= 0; shift < 32; shift+= 7)
+  {
+    const int c= getc(f);
+    if (c == EOF)
+      return false;
+    n|= uint32_t(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/** Page identifiers of a buffer pool load */
+struct buf_load_array
+{
+  /** the page identifiers, allocated by ut_malloc() */
+  page_id_t *ids= nullptr;
+  /** number of elements in ids[] */
+  size_t size= 0;
+  /** number of allocated elements in ids[] */
+  size_t capacity= 0;
+  /** end positions of the heat tiers in ids[] */
+  size_t tiers[BUF_DUMP_TIERS];
+  /** number of elements in tiers[] */
+  size_t n_tiers= 0;
+
+  ~buf_load_array() { ut_free(ids); }
+
+  /** @return the number of elements that push_back() would allocate */
+  size_t next_capacity() const { return capacity ? capacity * 2 : 1024; }
+
+  /** Append a page identifier.
+  @param id  page identifier
+  @return whether memory was available */
+  bool push_back(page_id_t id)
+  {
+    if (size == capacity)
+    {
+      const size_t n= next_capacity();
+      void *p= ut_realloc(ids, n * sizeof *ids);
+      if (!p)
+        return false;
+      ids= static_cast<page_id_t*>(p);
+      capacity= n;
+    }
+    ids[size++]= id;
+    return true;
+  }
+};
+
+/** Parse the tiers of a compact dump, following buf_dump_magic.
+@param f      dump file
+@param dump   page identifiers, hottest tier first
+@param limit  maximum number of pages to load
+@return error code
+@retval 0 on success
+@retval EINVAL if the file is truncated or corrupted
+@retval ENOMEM if memory could not be allocated */
+static int buf_load_read_compact(FILE *f, buf_load_array &dump, size_t limit)
+{
+  while (dump.size < limit && !SHUTTING_DOWN())
+  {
+    uint32_t n;
+    if (!buf_load_read_varint(f, n))
+      return EINVAL;
+    if (!n)
+      return 0; /* A tier size of 0 terminates the dump */
+    if (dump.n_tiers == BUF_DUMP_TIERS)
+      return EINVAL;
+    uint32_t space_id= 0, page_no= 0;
+    do
+    {
+      uint32_t space_delta, page_delta;
+      if (!buf_load_read_varint(f, space_delta) ||
+          !buf_load_read_varint(f, page_delta))
+        return EINVAL;
+      if (space_delta)
+        page_no= 0;
+      space_id+= space_delta;
+      page_no+= page_delta;
+      if (dump.size < limit && !dump.push_back(page_id_t{space_id, page_no}))
+        return ENOMEM;
+    }
+    while (--n);
+    dump.tiers[dump.n_tiers++]= dump.size;
+  }
+  return ferror(f) ? EINVAL : 0;
+}
+
+/** Parse a dump in the text format, with one "space,page" per line,
+most recently used first.
+@param f      dump file
+@param dump   page identifiers
+@param limit  maximum number of pages to load
+@return error code
+@retval 0 on success
+@retval EINVAL if the file could not be parsed
+@retval ENOMEM if memory could not be allocated */
+static int buf_load_read_text(FILE *f, buf_load_array &dump, size_t limit)
+{
+  uint32_t space_id, page_no;
+  while (fscanf(f, "%u,%u", &space_id, &page_no) == 2 && !SHUTTING_DOWN())
+    if (dump.size < limit && !dump.push_back(page_id_t{space_id, page_no}))
+      return ENOMEM;
+  if (!SHUTTING_DOWN() && !feof(f))
+    return EINVAL;
+  for (ulint t= 1; t <= BUF_DUMP_TIERS; t++)
+    dump.tiers[dump.n_tiers++]= dump.size * t / BUF_DUMP_TIERS;
+  return 0;
+}
+
+/** Number of pages of the current buffer pool load that were processed */
+static Atomic_counter<ulint> buf_load_n_done;
+
+/** A part of a heat tier that one task of buf_load_tier() processes */
+struct buf_load_slice
+{
+  const page_id_t *first;
+  const page_id_t *last;
+};
+
+/** Submit asynchronous reads for a part of a buffer pool load.
+@param arg  buf_load_slice */
+static void buf_load_slice_func(void *arg)
+{
+  const buf_load_slice *slice= static_cast<const buf_load_slice*>(arg);
+  /* Avoid calling the expensive fil_space_t::get() for each page
+  within the same tablespace. The slice is sorted by (space, page),
+  so all pages from a given tablespace are consecutive. */
+  uint32_t cur_space_id= FIL_NULL;
+  fil_space_t *space= nullptr;
+  ulint zip_size= 0;
+  os_aio_batch batch;
+
+  for (const page_id_t *id= slice->first; id != slice->last; id++)
+  {
+    if (buf_load_abort_flag || SHUTTING_DOWN())
+      break;
+#ifdef UNIV_DEBUG
+    if (buf_load_n_done + 1 >= srv_buf_pool_load_pages_abort)
+      buf_load_abort_flag= true;
+#endif
+    buf_load_n_done++;
+
+    const uint32_t space_id= id->space();
+    if (space_id >= SRV_SPACE_ID_UPPER_BOUND)
+      continue;
+
+    if (space_id != cur_space_id)
+    {
+      if (space)
+        space->release();
+      cur_space_id= space_id;
+      space= fil_space_t::get(space_id);
+      zip_size= space ? space->zip_size() : 0;
+    }
+
+    /* JAN: TODO: As we use background page read below,
+    if tablespace is encrypted we cant use it. */
+    if (!space || id->page_no() >= space->get_size() ||
+        (space->crypt_data &&
+         space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
+         space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED))
+      continue;
+
+    if (space->is_stopping())
+    {
+      space->release();
+      space= nullptr;
+      continue;
+    }
+
+    space->reacquire();
+    buf_read_page_background(space, *id, zip_size);
+  }
+
+  if (space)
+    space->release();
+}
+
+/** Submit the reads for a heat tier of a buffer pool load,
+in up to innodb_read_io_threads concurrent tasks.
+@param first  first page of the tier
+@param last   end of the tier */
+static void buf_load_tier(const page_id_t *first, const page_id_t *last)
+{
+  /* Do not bother to create tasks for fewer pages than this */
+  constexpr size_t min_slice= 256;
+  /* The maximum value of innodb_read_io_threads */
+  constexpr size_t max_slices= 64;
+  const size_t n= size_t(last - first);
+  const size_t n_slices= std::min({size_t{std::max(srv_n_read_io_threads, 1U)},
+                                   std::max<size_t>(n / min_slice, 1),
+                                   max_slices});
+  buf_load_slice slices[max_slices];
+  tpool::waitable_task *tasks[max_slices];
+  for (size_t i= 0; i < n_slices; i++)
+    slices[i]= {first + n * i / n_slices, first + n * (i + 1) / n_slices};
+
+  for (size_t i= 1; i < n_slices; i++)
+    if ((tasks[i]= new (std::nothrow) tpool::waitable_task(buf_load_slice_func,
+                                                          &slices[i])))
+      srv_thread_pool->submit_task(tasks[i]);
+
+  buf_load_slice_func(&slices[0]);
+  /* Process any slices for which no task could be allocated */
+  for (size_t i= 1; i < n_slices; i++)
+    if (!tasks[i])
+      buf_load_slice_func(&slices[i]);
+
+  tpool::tpool_wait_begin();
+  for (size_t i= 1; i < n_slices; i++)
+  {
+    if (tasks[i])
+    {
+      tasks[i]->wait();
+      delete tasks[i];
+    }
+  }
+  tpool::tpool_wait_end();
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
 innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
 The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+SET GLOBAL innodb_buffer_pool_filename='filename';
+Both the text and the compact format are accepted. */
 static
 void
 buf_load()
@@ -428,13 +734,10 @@ buf_load()
 {
 	char		full_filename[OS_FILE_MAX_PATH];
 	char		now[32];
+	char		magic[sizeof buf_dump_magic - 1];
 	FILE*		f;
-	page_id_t*	dump;
-	ulint		dump_n;
-	ulint		i;
-	uint32_t	space_id;
-	uint32_t	page_no;
-	int		fscanf_ret;
+	buf_load_array	dump;
+	int		err;
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = false;
@@ -453,119 +756,61 @@ buf_load()
 	}
 	/* else */
 
-	/* First scan the file to estimate how many entries are in it.
-	This file is tiny (approx 500KB per 1GB buffer pool), reading it
-	two times is fine. */
-	dump_n = 0;
-	while (fscanf(f, "%u,%u", &space_id, &page_no) == 2
-	       && !SHUTTING_DOWN()) {
-		dump_n++;
-	}
-
-	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
-		const char*	what;
-		if (ferror(f)) {
-			what = "reading";
-		} else {
-			what = "parsing";
-		}
-		fclose(f);
-		buf_load_status(STATUS_ERR, "Error %s '%s',"
-				" unable to load buffer pool (stage 1)",
-				what, full_filename);
-		return;
-	}
-
 	/* If dump is larger than the buffer pool(s), then we ignore the
 	extra trailing. This could happen if a dump is made, then buffer
 	pool is shrunk and then load is attempted. */
-	dump_n = std::min(dump_n, buf_pool.get_n_pages());
+	const size_t limit = buf_pool.get_n_pages();
 
-	if (dump_n != 0) {
-		dump = static_cast<page_id_t*>(ut_malloc_nokey(
-				dump_n * sizeof(*dump)));
+	if (fread(magic, sizeof magic, 1, f) == 1
+	    && !memcmp(magic, buf_dump_magic, sizeof magic)) {
+		err = buf_load_read_compact(f, dump, limit);
 	} else {
-		fclose(f);
-		ut_sprintf_timestamp(now);
-		buf_load_status(STATUS_INFO,
-				"Buffer pool(s) load completed at %s"
-				" (%s was empty)", now, full_filename);
-		return;
+		rewind(f);
+		err = buf_load_read_text(f, dump, limit);
 	}
 
-	if (dump == NULL) {
+	if (err == ENOMEM) {
 		std::ostringstream str_bytes;
 		fclose(f);
-		str_bytes << ib::bytes_iec{dump_n * sizeof(*dump)};
-		buf_dump_status(STATUS_ERR,
+		str_bytes << ib::bytes_iec{dump.next_capacity()
+					      * sizeof *dump.ids};
+		buf_load_status(STATUS_ERR,
 				"Cannot allocate %s: %s",
 				str_bytes.str().c_str(),
-				strerror(errno));
-		/* leave tmp_filename to exist */
+				strerror(ENOMEM));
 		return;
 	}
 
-	rewind(f);
-
-	export_vars.innodb_buffer_pool_load_incomplete = 1;
-
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, "%u,%u", &space_id, &page_no);
-
-		if (fscanf_ret != 2) {
-			if (feof(f)) {
-				break;
-			}
-			/* else */
-
-			ut_free(dump);
-			fclose(f);
-			buf_load_status(STATUS_ERR,
-					"Error parsing '%s', unable"
-					" to load buffer pool (stage 2)",
-					full_filename);
-			return;
-		}
-
-		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
-			fclose(f);
-			buf_load_status(STATUS_ERR,
-					"Error parsing '%s': bogus"
-					" space,page %u,%u at line " ULINTPF
-					", unable to load buffer pool",
-					full_filename,
-					space_id, page_no,
-					i);
-			return;
+	if (err) {
+		const char*	what;
+		if (ferror(f)) {
+			what = "reading";
+		} else {
+			what = "parsing";
 		}
-
-		dump[i] = page_id_t(space_id, page_no);
+		fclose(f);
+		buf_load_status(STATUS_ERR, "Error %s '%s',"
+				" unable to load buffer pool",
+				what, full_filename);
+		return;
 	}
 
-	/* Set dump_n to the actual number of initialized elements,
-	i could be smaller than dump_n here if the file got truncated after
-	we read it the first time. */
-	dump_n = i;
-
 	fclose(f);
 
-	if (dump_n == 0) {
-		ut_free(dump);
+	if (!dump.size) {
 		ut_sprintf_timestamp(now);
 		buf_load_status(STATUS_INFO,
 				"Buffer pool(s) load completed at %s"
-				" (%s was empty or had errors)", now, full_filename);
+				" (%s was empty)", now, full_filename);
 		return;
 	}
 
+	export_vars.innodb_buffer_pool_load_incomplete = 1;
+
 	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
 		std::set<uint32_t> missing;
-		for (const page_id_t id : st_::span<const page_id_t>
-		       (dump, dump_n)) {
-			missing.emplace(id.space());
+		for (size_t i = 0; i < dump.size; i++) {
+			missing.emplace(dump.ids[i].space());
 		}
 		for (std::set<uint32_t>::iterator i = missing.begin();
 		     i != missing.end(); ) {
@@ -580,106 +825,52 @@ buf_load()
 		}
 	}
 
-	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	uint32_t	cur_space_id = dump[0].space();
-	fil_space_t*	space = fil_space_t::get(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
-
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
-	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
+	mysql_stage_set_work_estimated(pfs_stage_progress, dump.size);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-
-		/* space_id for this iteration of the loop */
-		const uint32_t this_space_id = dump[i].space();
-
-		if (this_space_id >= SRV_SPACE_ID_UPPER_BOUND) {
-			continue;
-		}
-
-		if (this_space_id != cur_space_id) {
-			if (space) {
-				space->release();
-			}
-
-			cur_space_id = this_space_id;
-			space = fil_space_t::get(cur_space_id);
-
-			if (!space) {
-				continue;
-			}
-
-			zip_size = space->zip_size();
-		}
+	buf_load_n_done = 0;
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (!space || dump[i].page_no() >= space->get_size() ||
-		    (space->crypt_data &&
-		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
-
-		if (space->is_stopping()) {
-			space->release();
-			space = nullptr;
-			continue;
-		}
-
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size);
-
-		if (buf_load_abort_flag) {
-			if (space) {
-				space->release();
-			}
-			buf_load_abort_flag = false;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress, i);
-
-			mysql_end_stage();
-			return;
-		}
-
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = true;
+	/* Read the hottest tier first. Within a tier, sort the pages so
+	that buf_load_slice_func() will access each tablespace once and
+	read the pages in ascending order. */
+	size_t	start = 0;
+	for (ulint t = 0; t < dump.n_tiers; t++) {
+		if (buf_load_abort_flag || SHUTTING_DOWN()) {
+			break;
 		}
-#endif
+		const size_t end = dump.tiers[t];
+		std::sort(dump.ids + start, dump.ids + end);
+		buf_load_tier(dump.ids + start, dump.ids + end);
+		mysql_stage_set_work_completed(pfs_stage_progress,
+					       buf_load_n_done);
+		start = end;
 	}
 
-	if (space) {
-		space->release();
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = false;
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed and
+		end the current stage event. */
+		mysql_stage_set_work_estimated(pfs_stage_progress,
+					       buf_load_n_done);
+		mysql_stage_set_work_completed(pfs_stage_progress,
+					       buf_load_n_done);
+		mysql_end_stage();
+		return;
 	}
 
-	ut_free(dump);
-
-  os_aio_wait_until_no_pending_reads(true);
+	os_aio_wait_until_no_pending_reads(true);
 
 	ut_sprintf_timestamp(now);
 
-	if (i == dump_n) {
+	if (buf_load_n_done == dump.size) {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load completed at %s", now);
 		export_vars.innodb_buffer_pool_load_incomplete = 0;
-	} else if (!buf_load_abort_flag) {
-		buf_load_status(STATUS_INFO,
-			"Buffer pool(s) load aborted due to user instigated abort at %s",
-			now);
-		/* intentionally don't reset innodb_buffer_pool_load_incomplete
-                   as we don't want a shutdown to save the buffer pool */
 	} else {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load aborted due to shutdown at %s",
@@ -689,7 +880,7 @@ buf_load()
 	}
 
 	/* Make sure that estimated = completed when we end. */
-	mysql_stage_set_work_completed(pfs_stage_progress, dump_n);
+	mysql_stage_set_work_completed(pfs_stage_progress, dump.size);
 	/* End the stage progress event. */
 	mysql_end_stage();
 }
@@ -702,6 +702,17 @@ static byte *buf_page_encrypt(fil_space_t *space, buf_page_t *bpage, byte *s,
   return d;
 }
 
+/** Acquire buf_pool.mutex during a flushing batch. If we have to wait
+for it, submit the writes that the os_aio_batch has queued so far. */
+static void buf_flush_mutex_lock() noexcept
+{
+  if (UNIV_UNLIKELY(mysql_mutex_trylock(&buf_pool.mutex)))
+  {
+    os_aio_submit_queued();
+    mysql_mutex_lock(&buf_pool.mutex);
+  }
+}
+
 /** Free a page whose underlying file page has been freed. */
 ATTRIBUTE_COLD void buf_pool_t::release_freed_page(buf_page_t *bpage) noexcept
 {
@@ -755,7 +766,7 @@ bool buf_page_t::flush(fil_space_t *space) noexcept
       {
         mysql_mutex_unlock(&buf_pool.mutex);
         log_write_up_to(lsn, true);
-        mysql_mutex_lock(&buf_pool.mutex);
+        buf_flush_mutex_lock();
       }
     }
     buf_pool.release_freed_page(this);
@@ -909,7 +920,7 @@ static page_id_t buf_flush_check_neighbors(const fil_space_t &space,
   /* Determine the contiguous dirty area around id. */
   const ulint id_fold= id.fold();
 
-  mysql_mutex_lock(&buf_pool.mutex);
+  buf_flush_mutex_lock();
 
   if (id > low)
   {
@@ -1066,7 +1077,7 @@ static ulint buf_flush_try_neighbors(fil_space_t *space,
     }
 
     const buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(id_fold);
-    mysql_mutex_lock(&buf_pool.mutex);
+    buf_flush_mutex_lock();
 
     if (buf_page_t *b= buf_pool.page_hash.get(id, chain))
     {
@@ -1263,7 +1274,7 @@ static void buf_flush_LRU_list_batch(ulint max, flush_counters_t *n) noexcept
         continue;
       mysql_mutex_unlock(&buf_pool.mutex);
     reacquire_mutex:
-      mysql_mutex_lock(&buf_pool.mutex);
+      buf_flush_mutex_lock();
       continue;
     }
 
@@ -1305,10 +1316,10 @@ static void buf_flush_LRU_list_batch(ulint max, flush_counters_t *n) noexcept
           last_space_id= space_id;
           if (!space)
           {
-            mysql_mutex_lock(&buf_pool.mutex);
+            buf_flush_mutex_lock();
             goto no_space;
           }
-          mysql_mutex_lock(&buf_pool.mutex);
+          buf_flush_mutex_lock();
           buf_pool.stat.n_pages_written+= p.second;
         }
         else
@@ -1374,7 +1385,10 @@ static void buf_do_LRU_batch(ulint max, flush_counters_t *n) noexcept
     buf_free_from_unzip_LRU_list_batch();
   n->evicted= 0;
   n->flushed= 0;
-  buf_flush_LRU_list_batch(max, n);
+  {
+    os_aio_batch batch;
+    buf_flush_LRU_list_batch(max, n);
+  }
 
   mysql_mutex_assert_owner(&buf_pool.mutex);
   buf_lru_freed_page_count+= n->evicted;
@@ -1391,6 +1405,7 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
 {
   ulint count= 0;
   ulint scanned= 0;
+  os_aio_batch batch;
 
   mysql_mutex_assert_owner(&buf_pool.mutex);
   mysql_mutex_assert_owner(&buf_pool.flush_list_mutex);
@@ -1464,7 +1479,7 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
         auto p= buf_flush_space(space_id);
         space= p.first;
         last_space_id= space_id;
-        mysql_mutex_lock(&buf_pool.mutex);
+        buf_flush_mutex_lock();
         buf_pool.stat.n_pages_written+= p.second;
         mysql_mutex_lock(&buf_pool.flush_list_mutex);
       }
@@ -1491,7 +1506,7 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
           ++count;
         else
           continue;
-        mysql_mutex_lock(&buf_pool.mutex);
+        buf_flush_mutex_lock();
       }
       while (0);
     }
@@ -381,8 +381,13 @@ buf_block_t* buf_LRU_get_free_block(buf_LRU_get get)
 {
   bool waited= false;
   MONITOR_INC(MONITOR_LRU_GET_FREE_SEARCH);
-  if (UNIV_LIKELY(get != have_mutex))
+  if (UNIV_LIKELY(get != have_mutex) &&
+      UNIV_UNLIKELY(mysql_mutex_trylock(&buf_pool.mutex)))
+  {
+    /* Do not keep the read-ahead of this thread waiting for us */
+    os_aio_submit_queued();
     mysql_mutex_lock(&buf_pool.mutex);
+  }
 
   buf_LRU_check_size_of_non_data_objects();
 
@@ -108,6 +108,8 @@ static buf_page_t *buf_page_init_for_read(const page_id_t page_id,
   if (UNIV_UNLIKELY(mysql_mutex_trylock(&buf_pool.mutex)))
   {
     hash_lock.unlock();
+    /* Do not keep the read-ahead of this thread waiting for us */
+    os_aio_submit_queued();
     mysql_mutex_lock(&buf_pool.mutex);
     hash_lock.lock();
     if (buf_pool.page_hash.get(page_id, chain))
@@ -364,19 +366,23 @@ ulint buf_read_ahead_random(const page_id_t page_id) noexcept
     goto allocate_block;
   }
 
-  for (page_id_t i= low; i < high; ++i)
   {
-    if (space->is_stopping())
-      break;
-    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(i.fold());
-    space->reacquire();
-    if (buf_read_page_low(i, zip_size, chain, space, block) == DB_SUCCESS)
+    /* Submit the reads together */
+    os_aio_batch batch;
+    for (page_id_t i= low; i < high; ++i)
     {
-      count++;
-      ut_ad(!block);
-      if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
-          UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      if (space->is_stopping())
         break;
+      buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(i.fold());
+      space->reacquire();
+      if (buf_read_page_low(i, zip_size, chain, space, block) == DB_SUCCESS)
+      {
+        count++;
+        ut_ad(!block);
+        if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
+            UNIV_UNLIKELY(!(block= buf_read_acquire())))
+          break;
+      }
     }
   }
 
@@ -656,20 +662,25 @@ ulint buf_read_ahead_linear(const page_id_t page_id) noexcept
   }
 
   count= 0;
-  for (; new_low <= new_high_1; ++new_low)
   {
-    if (space->is_stopping())
-      break;
-    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(new_low.fold());
-    space->reacquire();
-    if (buf_read_page_low(new_low, zip_size, chain, space, block) ==
-        DB_SUCCESS)
+    /* Submit the reads together */
+    os_aio_batch batch;
+    for (; new_low <= new_high_1; ++new_low)
     {
-      count++;
-      ut_ad(!block);
-      if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
-          UNIV_UNLIKELY(!(block= buf_read_acquire())))
+      if (space->is_stopping())
         break;
+      buf_pool_t::hash_chain &chain=
+        buf_pool.page_hash.cell_get(new_low.fold());
+      space->reacquire();
+      if (buf_read_page_low(new_low, zip_size, chain, space, block) ==
+          DB_SUCCESS)
+      {
+        count++;
+        ut_ad(!block);
+        if ((UNIV_LIKELY(!zip_size) || (zip_size & 1)) &&
+            UNIV_UNLIKELY(!(block= buf_read_acquire())))
+          break;
+      }
     }
   }
 
@@ -337,6 +337,17 @@ This is the same as "myisam_stats_method_typelib" */
 static TYPELIB innodb_stats_method_typelib =
 			CREATE_TYPELIB_FOR(innodb_stats_method_names);
 
+/** Possible values of innodb_buffer_pool_dump_format */
+static const char* innodb_buffer_pool_dump_format_names[] = {
+	"text",
+	"compact",
+	NullS
+};
+
+/** Enumeration of innodb_buffer_pool_dump_format */
+static TYPELIB innodb_buffer_pool_dump_format_typelib =
+	CREATE_TYPELIB_FOR(innodb_buffer_pool_dump_format_names);
+
 /** Possible values of the parameter innodb_checksum_algorithm */
 const char* innodb_checksum_algorithm_names[] = {
 	"crc32",
@@ -5068,6 +5079,12 @@ ha_innobase::table_flags() const
 		flags|= HA_REQUIRE_PRIMARY_KEY;
 	}
 
+	/* With innodb_parallel_read_threads, records() is faster than
+	an index scan for SELECT COUNT(*). */
+	if (srv_parallel_read_threads > 1) {
+		flags|= HA_HAS_RECORDS;
+	}
+
 	/* Need to use tx_isolation here since table flags is (also)
 	called before prebuilt is inited. */
 
@@ -9132,6 +9149,31 @@ ha_innobase::index_read_last(
 	return(index_read(buf, key_ptr, key_len, HA_READ_PREFIX_LAST));
 }
 
+/** Start reading the leaf page of a key in the background.
+@param keynr        index number
+@param key          key value in MySQL format
+@param keypart_map  the key parts in key
+@return 0 or error code */
+int ha_innobase::prefetch_key(uint keynr, const uchar *key,
+                              key_part_map keypart_map)
+{
+  dict_index_t *index= innobase_get_index(keynr);
+  if (!index || !index->is_btree() || !index->is_committed())
+    return HA_ERR_WRONG_COMMAND;
+
+  const ulint buf_len= m_prebuilt->srch_key_val_len;
+  mem_heap_t *heap= mem_heap_create(DTUPLE_EST_ALLOC(index->n_fields) +
+                                    buf_len);
+  dtuple_t *tuple= dtuple_create(heap, index->n_fields);
+  dict_index_copy_types(tuple, index, index->n_fields);
+  row_sel_convert_mysql_key_to_innobase(
+    tuple, buf_len ? static_cast<byte*>(mem_heap_alloc(heap, buf_len)) : nullptr,
+    buf_len, index, key, calculate_key_len(table, keynr, key, keypart_map));
+  btr_cur_prefetch_leaf(index, tuple);
+  mem_heap_free(heap);
+  return 0;
+}
+
 /********************************************************************//**
 Get the index for a handle. Does not change active index.
 @return NULL or index instance. */
@@ -14594,6 +14636,49 @@ ha_innobase::estimate_rows_upper_bound()
 	DBUG_RETURN((ha_rows) estimate);
 }
 
+/** Count the rows of the table in innodb_parallel_read_threads threads.
+This is used for SELECT COUNT(*) without a WHERE condition.
+@return number of rows in the read view of the transaction
+@retval HA_POS_ERROR if the rows must be counted by an index scan */
+ha_rows ha_innobase::records()
+{
+	DBUG_ENTER("ha_innobase::records");
+
+	update_thd(ha_thd());
+
+	trx_t*		trx = m_prebuilt->trx;
+	dict_table_t*	table = m_prebuilt->table;
+	dict_index_t*	index = dict_table_get_first_index(table);
+
+	/* Locking reads (such as in SERIALIZABLE isolation level)
+	must read the records one by one. */
+	if (srv_parallel_read_threads <= 1
+	    || m_prebuilt->select_lock_type != LOCK_NONE
+	    || table->is_temporary() || table->no_rollback()
+	    || !table->space || !table->is_readable()
+	    || !index || index->is_corrupted()) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	trx_start_if_not_started(trx, false);
+	trx->read_view.open(trx);
+
+	if (!row_merge_is_index_usable(trx, index)) {
+		/* The table was rebuilt after the read view was created.
+		Let the index scan report the error. */
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	ulint	n_rows;
+
+	trx->op_info = "counting rows";
+	dberr_t err = row_parallel_read(trx, index, srv_parallel_read_threads,
+					nullptr, nullptr, nullptr, &n_rows);
+	trx->op_info = "";
+
+	DBUG_RETURN(err == DB_SUCCESS ? ha_rows(n_rows) : HA_POS_ERROR);
+}
+
 
 /*********************************************************************//**
 How many seeks it will take to read through the table. This is to be
@@ -19412,6 +19497,12 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ENUM(buffer_pool_dump_format, srv_buf_dump_format,
+  PLUGIN_VAR_RQCMDARG,
+  "Format of the buffer pool dump file: text (one space,page per line)"
+  " or compact (binary, delta encoded). Both formats can be loaded",
+  NULL, NULL, BUF_DUMP_TEXT, &innodb_buffer_pool_dump_format_typelib);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19546,6 +19637,19 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(ddl_threads, srv_ddl_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of threads that read the clustered index when secondary"
+  " indexes are created; fewer are used if their sort buffers would exceed"
+  " 64MiB",
+  NULL, NULL, 4, 1, 256, 0);
+
+static MYSQL_SYSVAR_ULONG(parallel_read_threads, srv_parallel_read_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that read the clustered index in SELECT COUNT(*)"
+  " and CHECK TABLE (1=disable)",
+  NULL, NULL, 1, 1, 256, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19788,6 +19892,19 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform",
   NULL, NULL, innodb_use_native_aio_default());
 
+#ifdef HAVE_URING
+static MYSQL_SYSVAR_BOOL(io_uring_sqpoll, srv_io_uring_sqpoll,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Let a kernel thread poll for io_uring submissions"
+  " (requires Linux 5.11 or CAP_SYS_NICE)",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(io_uring_fixed_buffers, srv_io_uring_fixed_buffers,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Register the buffer pool memory with io_uring, locking it in memory",
+  NULL, NULL, FALSE);
+#endif
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -20044,6 +20161,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_dump_format),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -20132,6 +20250,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(ddl_threads),
+  MYSQL_SYSVAR(parallel_read_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -20140,6 +20260,10 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(tmpdir),
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef HAVE_URING
+  MYSQL_SYSVAR(io_uring_sqpoll),
+  MYSQL_SYSVAR(io_uring_fixed_buffers),
+#endif
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
@@ -20246,6 +20370,7 @@ i_s_innodb_ft_index_cache,
 i_s_innodb_ft_index_table,
 i_s_innodb_sys_tables,
 i_s_innodb_sys_tablestats,
+i_s_innodb_purge_table_stats,
 i_s_innodb_sys_indexes,
 i_s_innodb_sys_columns,
 i_s_innodb_sys_fields,
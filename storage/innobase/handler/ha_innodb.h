@@ -154,6 +154,9 @@ class ha_innobase final : public handler
 
 	int rnd_pos(uchar * buf, uchar *pos) override;
 
+	int prefetch_key(uint keynr, const uchar *key,
+			 key_part_map keypart_map) override;
+
 	int ft_init() override;
 	void ft_end() override { rnd_end(); }
 	FT_INFO *ft_init_ext(uint flags, uint inx, String* key) override;
@@ -185,6 +188,8 @@ class ha_innobase final : public handler
 
 	ha_rows estimate_rows_upper_bound() override;
 
+	ha_rows records() override;
+
 	void update_create_info(HA_CREATE_INFO* create_info) override;
 
 	int create(
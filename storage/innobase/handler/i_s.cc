@@ -4927,6 +4927,125 @@ struct st_maria_plugin	i_s_innodb_sys_tablestats =
 	MariaDB_PLUGIN_MATURITY_STABLE
 };
 
+namespace Show {
+/**  PURGE_TABLE_STATS  ********************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_PURGE_TABLE_STATS */
+static ST_FIELD_INFO innodb_purge_table_stats_fields_info[]=
+{
+#define PURGE_TABLE_STATS_ID		0
+  Column("TABLE_ID", ULonglong(), NOT_NULL),
+
+#define PURGE_TABLE_STATS_NAME		1
+  Column("NAME", Varchar(NAME_CHAR_LEN), NOT_NULL),
+
+#define PURGE_TABLE_STATS_RECORDS	2
+  Column("PURGED_RECORDS", ULonglong(), NOT_NULL),
+
+#define PURGE_TABLE_STATS_SPLIT		3
+  Column("SPLIT_BATCHES", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Fill information_schema.innodb_purge_table_stats with the tables in
+the dictionary cache whose undo log records have been handed to purge.
+The counts start from 0 when a table is loaded to the dictionary cache,
+and they are lost when the table is evicted.
+@param thd     connection
+@param tables  the table to fill
+@return 0 on success */
+static int i_s_purge_table_stats_fill(THD *thd, TABLE_LIST *tables, Item*)
+{
+  DBUG_ENTER("i_s_purge_table_stats_fill");
+  RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+  /* deny access to user without PROCESS_ACL privilege */
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(0);
+
+  Field **fields= tables->table->field;
+  int err= 0;
+
+  dict_sys.freeze(SRW_LOCK_CALL);
+  for (const auto *list : {&dict_sys.table_LRU, &dict_sys.table_non_LRU})
+  {
+    for (const dict_table_t *table= UT_LIST_GET_FIRST(*list); table;
+         table= UT_LIST_GET_NEXT(table_LRU, table))
+    {
+      const uint64_t n_recs= table->n_purged_recs;
+      if (!n_recs)
+        continue;
+      if (fields[PURGE_TABLE_STATS_ID]->store(longlong(table->id), true) ||
+          field_store_string(fields[PURGE_TABLE_STATS_NAME],
+                             table->name.m_name) ||
+          fields[PURGE_TABLE_STATS_RECORDS]->store(longlong(n_recs), true) ||
+          fields[PURGE_TABLE_STATS_SPLIT]->store(
+            longlong(table->n_split_batches), true) ||
+          schema_table_store_record(thd, tables->table))
+      {
+        err= 1;
+        goto func_exit;
+      }
+    }
+  }
+
+func_exit:
+  dict_sys.unfreeze();
+  DBUG_RETURN(err);
+}
+
+/** Bind the dynamic table INFORMATION_SCHEMA.INNODB_PURGE_TABLE_STATS
+@param p  table schema object
+@return 0 on success */
+static int innodb_purge_table_stats_init(void *p)
+{
+  DBUG_ENTER("innodb_purge_table_stats_init");
+  ST_SCHEMA_TABLE *schema= static_cast<ST_SCHEMA_TABLE*>(p);
+  schema->fields_info= Show::innodb_purge_table_stats_fields_info;
+  schema->fill_table= i_s_purge_table_stats_fill;
+  DBUG_RETURN(0);
+}
+
+struct st_maria_plugin	i_s_innodb_purge_table_stats =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	MYSQL_INFORMATION_SCHEMA_PLUGIN,
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	&i_s_info,
+
+	/* plugin name */
+	/* const char* */
+	"INNODB_PURGE_TABLE_STATS",
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	plugin_author,
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	"InnoDB undo log records handed to purge by cached table,"
+	" counted since the table was loaded",
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	PLUGIN_LICENSE_GPL,
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	innodb_purge_table_stats_init,
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	i_s_common_deinit,
+
+	i_s_version, nullptr, nullptr, PACKAGE_VERSION,
+	MariaDB_PLUGIN_MATURITY_STABLE
+};
+
 namespace Show {
 /**  SYS_INDEXES  **************************************************/
 /* Fields of the dynamic table INFORMATION_SCHEMA.SYS_INDEXES */
@@ -53,6 +53,7 @@ extern struct st_maria_plugin	i_s_innodb_buffer_page_lru;
 extern struct st_maria_plugin	i_s_innodb_buffer_stats;
 extern struct st_maria_plugin	i_s_innodb_sys_tables;
 extern struct st_maria_plugin	i_s_innodb_sys_tablestats;
+extern struct st_maria_plugin	i_s_innodb_purge_table_stats;
 extern struct st_maria_plugin	i_s_innodb_sys_indexes;
 extern struct st_maria_plugin	i_s_innodb_sys_columns;
 extern struct st_maria_plugin	i_s_innodb_sys_fields;
@@ -509,6 +509,21 @@ btr_validate_index(
 	const trx_t*	trx)	/*!< in: transaction or 0 */
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Divide an index into key ranges for a parallel scan.
+Range r covers the keys from bounds[r - 1] (inclusive)
+to bounds[r] (exclusive).
+@param index	B-tree index
+@param n	desired number of ranges
+@param heap	memory heap for the boundaries
+@param bounds	boundaries between the ranges
+@param leaves	nullptr, or the first leaf page of each range; only valid
+while the caller prevents changes to the structure of the tree
+@return error code */
+dberr_t btr_split_key_ranges(dict_index_t *index, ulint n, mem_heap_t *heap,
+			     std::vector<const dtuple_t*> &bounds,
+			     std::vector<uint32_t> *leaves= nullptr)
+	MY_ATTRIBUTE((nonnull(1,3), warn_unused_result));
+
 /** Remove a page from the level list of pages.
 @param[in]	block		page to remove
 @param[in]	index		index tree
@@ -132,6 +132,13 @@ dberr_t btr_cur_search_to_nth_level(ulint level,
                                     rw_lock_type_t rw_latch,
                                     btr_cur_t *cursor, mtr_t *mtr);
 
+/** Start reading the leaf page that a search tuple would be located on in
+the background, unless the page is in the buffer pool already. The non-leaf
+pages are read synchronously.
+@param index  B-tree index
+@param tuple  search tuple */
+void btr_cur_prefetch_leaf(dict_index_t *index, const dtuple_t *tuple);
+
 /*************************************************************//**
 Tries to perform an insert to a page in an index tree, next to cursor.
 It is assumed that mtr holds an x-latch on the page. The operation does
@@ -1148,6 +1148,12 @@ class buf_pool_t
   @return whether retry is needed */
   inline bool withdraw_blocks() noexcept;
 
+#ifdef HAVE_URING
+  /** Register the chunks with io_uring if innodb_io_uring_fixed_buffers=ON,
+  so that page I/O will avoid mapping the page frames for each request */
+  void register_io_buffers() noexcept;
+#endif
+
   /** Determine if a pointer belongs to a buf_block_t. It can be a pointer to
   the buf_block_t itself or a member of it.
   @param ptr    a pointer that will not be dereferenced
@@ -27,6 +27,15 @@ Created April 08, 2011 Vasil Dimov
 #ifndef buf0dump_h
 #define buf0dump_h
 
+/** Possible values of innodb_buffer_pool_dump_format */
+enum buf_dump_format_t
+{
+  /** one "space,page" line per page */
+  BUF_DUMP_TEXT,
+  /** binary, delta encoded and grouped by page heat */
+  BUF_DUMP_COMPACT
+};
+
 /** Start the buffer pool dump/load task and instructs it to start a dump. */
 void buf_dump_start();
 /** Start the buffer pool dump/load task and instructs it to start a load. */
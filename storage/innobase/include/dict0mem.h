@@ -2503,6 +2503,17 @@ struct dict_table_t {
   @see innobase_query_caching_table_check_low()
   @see trx_t::commit_tables() */
   Atomic_relaxed<trx_id_t> query_cache_inv_trx_id;
+  /** Number of undo log records of this table that have been handed
+  to purge tasks since the table was loaded to the cache; the count
+  starts from 0 again if the table is evicted and loaded again.
+  Only modified by the purge coordinator.
+  @see INFORMATION_SCHEMA.INNODB_PURGE_TABLE_STATS */
+  Atomic_relaxed<uint64_t> n_purged_recs;
+  /** Number of purge batches since the table was loaded to the cache
+  in which the undo log records of this table were split among
+  multiple purge tasks. Only modified by the purge coordinator.
+  @see INFORMATION_SCHEMA.INNODB_PURGE_TABLE_STATS */
+  Atomic_relaxed<uint64_t> n_split_batches;
 
 #ifdef UNIV_DEBUG
 	/** Value of 'magic_n'. */
@@ -1009,6 +1009,25 @@ void os_fake_read(const IORequest &type, os_offset_t offset) noexcept;
 dberr_t os_aio(const IORequest &type, void *buf, os_offset_t offset, size_t n)
   noexcept;
 
+/** Defer the submission of asynchronous requests that os_aio() issues
+in the current thread, so that they can be submitted together at the
+end of the scope. A doublewrite batch is always submitted immediately,
+because the thread may end up waiting for it to complete. */
+class os_aio_batch
+{
+  /** whether this is the outermost os_aio_batch in the thread */
+  const bool outermost;
+public:
+  os_aio_batch() noexcept;
+  ~os_aio_batch() noexcept;
+};
+
+/** Submit the requests that are queued in an os_aio_batch of the
+current thread. This must be invoked before the thread waits for
+something that could be waiting for those requests, such as
+buf_pool.mutex or a free block. */
+void os_aio_submit_queued() noexcept;
+
 /** @return number of pending reads */
 size_t os_aio_pending_reads() noexcept;
 /** @return approximate number of pending reads */
@@ -178,6 +178,51 @@ current read view.
 dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/** Function to invoke on each record in row_parallel_read().
+@param arg      argument of row_parallel_read()
+@param thread   number of the invoking thread, less than n_threads
+@param range    number of the key range that rec belongs to
+@param rec      clustered index record version that is not delete-marked
+@param offsets  rec_get_offsets(rec)
+@return error code */
+typedef dberr_t (*row_parallel_read_callback)(void *arg, ulint thread,
+                                              ulint range,
+                                              const rec_t *rec,
+                                              const rec_offs *offsets);
+
+/** Function to invoke on a corrupted record in row_parallel_read().
+@param arg      argument of row_parallel_read()
+@param thread   number of the invoking thread, less than n_threads
+@param range    number of the key range
+@param err      DB_CORRUPTION or DB_INDEX_CORRUPT
+@param msg      description of the corruption */
+typedef void (*row_parallel_read_corrupted)(void *arg, ulint thread,
+                                            ulint range, dberr_t err,
+                                            const char *msg);
+
+/** Read the clustered index of a table in multiple threads.
+The index is divided into key ranges at the node pointers, and
+the threads read the ranges in the read view of the transaction,
+or the latest versions of the records at READ UNCOMMITTED.
+If corrupted is set, the index tree is SX-latched for the whole read,
+so that no page can be split or merged, and the ranges are divided at
+leaf pages: each range covers all records of its pages, also those that
+are out of order, and corrupted records are reported to corrupted
+instead of ending the read.
+@param trx        transaction
+@param index      clustered index of a persistent table
+@param n_threads  maximum number of threads
+@param callback   function to invoke on each record, or nullptr
+@param corrupted  function to invoke on corrupted records, or nullptr
+@param arg        argument of callback and corrupted
+@param n_rows     number of records that were read
+@return error code */
+dberr_t row_parallel_read(trx_t *trx, dict_index_t *index, ulint n_threads,
+                          row_parallel_read_callback callback,
+                          row_parallel_read_corrupted corrupted, void *arg,
+                          ulint *n_rows)
+  MY_ATTRIBUTE((nonnull(1,2,7), warn_unused_result));
+
 /** Read the max AUTOINC value from an index.
 @param[in] index	index starting with an AUTO_INCREMENT column
 @return	the largest AUTO_INCREMENT value
@@ -170,6 +170,12 @@ extern my_bool	srv_file_per_table;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** innodb_ddl_threads: number of threads that read the clustered index
+when secondary indexes are created */
+extern ulong	srv_ddl_threads;
+/** innodb_parallel_read_threads: number of threads that read
+the clustered index in SELECT COUNT(*) and CHECK TABLE */
+extern ulong	srv_parallel_read_threads;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -179,6 +185,14 @@ use simulated aio.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
 extern my_bool	srv_numa_interleave;
+#ifdef HAVE_URING
+/** innodb_io_uring_sqpoll: whether a kernel thread polls for io_uring
+submissions */
+extern my_bool	srv_io_uring_sqpoll;
+/** innodb_io_uring_fixed_buffers: whether the buffer pool is registered
+with io_uring */
+extern my_bool	srv_io_uring_fixed_buffers;
+#endif
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
@@ -236,6 +250,8 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** innodb_buffer_pool_dump_format; @see buf_dump_format_t */
+extern ulong	srv_buf_dump_format;
 #ifdef UNIV_DEBUG
 /** Abort load after this amount of pages */
 extern ulong srv_buf_pool_load_pages_abort;
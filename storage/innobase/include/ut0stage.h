@@ -95,13 +95,14 @@ class ut_stage_alter_t {
 	begin_phase_read_pk(
 		ulint	n_sort_indexes);
 
-	/** Increment the number of records in PK (table) with 1.
+	/** Increment the number of records in PK (table).
 	This is used to get more accurate estimate about the number of
 	records per page which is needed because some phases work on
 	per-page basis while some work on per-record basis and we want
-	to get the progress as even as possible. */
+	to get the progress as even as possible.
+	@param[in]	n	number of records read */
 	void
-	n_pk_recs_inc();
+	n_pk_recs_inc(ulint n = 1);
 
 	/** Flag either one record or one page processed, depending on the
 	current phase.
@@ -235,12 +236,13 @@ ut_stage_alter_t::begin_phase_read_pk(
 This is used to get more accurate estimate about the number of
 records per page which is needed because some phases work on
 per-page basis while some work on per-record basis and we want
-to get the progress as even as possible. */
+to get the progress as even as possible.
+@param[in]	n	number of records read */
 inline
 void
-ut_stage_alter_t::n_pk_recs_inc()
+ut_stage_alter_t::n_pk_recs_inc(ulint n)
 {
-	m_n_pk_recs++;
+	m_n_pk_recs += n;
 }
 
 /** Flag either one record or one page processed, depending on the
@@ -476,7 +478,7 @@ class ut_stage_alter_t {
 
 	void begin_phase_read_pk(ulint)	{}
 
-	void n_pk_recs_inc() {}
+	void n_pk_recs_inc(ulint = 1) {}
 
 	void inc() {}
 	void inc(ulint) {}
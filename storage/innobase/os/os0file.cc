@@ -93,6 +93,20 @@ class io_slots
 	{
 		return m_cache.get();
 	}
+	/* Get cached AIO control block. Before waiting, submit any
+	requests that were queued by the current thread, because
+	os_aio_resize() or the completion of other requests may be
+	waiting for them. */
+	tpool::aiocb* acquire(bool batching)
+	{
+		if (batching) {
+			if (tpool::aiocb* cb = m_cache.try_get()) {
+				return cb;
+			}
+			srv_thread_pool->submit_queued_io();
+		}
+		return m_cache.get();
+	}
 	/* Release AIO control block back to cache */
 	void release(tpool::aiocb* aiocb)
 	{
@@ -155,6 +169,8 @@ class io_slots
 
 static io_slots *read_slots;
 static io_slots *write_slots;
+/** whether os_aio() is within an os_aio_batch */
+static thread_local bool os_aio_batching;
 
 /**
   Statistics for asynchronous I/O
@@ -1244,7 +1260,7 @@ os_file_create_func(
 
 				if (!os_file_lock(file, name)) {
 					*success = true;
-					return(file);
+					goto locked;
 				}
 			}
 
@@ -1254,9 +1270,16 @@ os_file_create_func(
 
 		*success = false;
 		close(file);
-		file = -1;
+		return(-1);
 	}
 
+locked:
+#ifdef HAVE_URING
+	/* Register the file for submitting io_uring requests */
+	if (type != OS_LOG_FILE && srv_thread_pool) {
+		srv_thread_pool->bind(file);
+	}
+#endif
 	return(file);
 }
 
@@ -1414,6 +1437,12 @@ os_file_get_last_error.
 @return true if success */
 bool os_file_close_func(os_file_t file)
 {
+#ifdef HAVE_URING
+  /* A registered file must be unregistered before the descriptor
+  can be reused */
+  if (srv_thread_pool)
+    srv_thread_pool->unbind(file);
+#endif
   int ret= close(file);
 
   if (!ret)
@@ -3203,7 +3232,13 @@ int os_aio_init() noexcept
     goto disable;
 #endif
 
+#ifdef HAVE_URING
+  ret= srv_thread_pool->configure_aio(srv_use_native_aio, max_events,
+                                      srv_io_uring_sqpoll
+                                      ? tpool::AIO_SQPOLL : 0);
+#else
   ret= srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
+#endif
 
 #ifdef LINUX_NATIVE_AIO
   if (ret)
@@ -3261,6 +3296,10 @@ int os_aio_resize(ulint n_reader_threads, ulint n_writer_threads) noexcept
   std::unique_lock<std::mutex> lk_read(read_slots->mutex()),
     lk_write(write_slots->mutex());
 
+  /* Requests that were queued in an os_aio_batch before we acquired
+  the locks would otherwise only be submitted by os_aio_batch::~os_aio_batch()
+  or by an os_aio() call, which would wait for us. */
+  srv_thread_pool->submit_queued_io();
   read_slots->wait(lk_read);
   write_slots->wait(lk_write);
 
@@ -3441,7 +3480,7 @@ dberr_t os_aio(const IORequest &type, void *buf, os_offset_t offset, size_t n)
 	}
 
 	compile_time_assert(sizeof(IORequest) <= tpool::MAX_AIO_USERDATA_LEN);
-	tpool::aiocb* cb = slots->acquire();
+	tpool::aiocb* cb = slots->acquire(os_aio_batching);
 
 	cb->m_buffer = buf;
 	cb->m_callback = callback;
@@ -3452,7 +3491,9 @@ dberr_t os_aio(const IORequest &type, void *buf, os_offset_t offset, size_t n)
 	cb->m_opcode = opcode;
 	new (cb->m_userdata) IORequest{type};
 
-	if (srv_thread_pool->submit_io(cb)) {
+	if (os_aio_batching && type.type != IORequest::DBLWR_BATCH
+	    ? srv_thread_pool->queue_io(cb)
+	    : srv_thread_pool->submit_io(cb)) {
 		slots->release(cb);
 		os_file_handle_error_no_exit(type.node->name, type.is_read()
 					     ? "aio read" : "aio write",
@@ -3464,6 +3505,27 @@ dberr_t os_aio(const IORequest &type, void *buf, os_offset_t offset, size_t n)
 	goto func_exit;
 }
 
+os_aio_batch::os_aio_batch() noexcept : outermost(!os_aio_batching)
+{
+  os_aio_batching= true;
+}
+
+os_aio_batch::~os_aio_batch() noexcept
+{
+  if (outermost)
+  {
+    os_aio_batching= false;
+    if (srv_thread_pool)
+      srv_thread_pool->submit_queued_io();
+  }
+}
+
+void os_aio_submit_queued() noexcept
+{
+  if (os_aio_batching)
+    srv_thread_pool->submit_queued_io();
+}
+
 void os_aio_print(FILE *file) noexcept
 {
 	time_t		current_time;
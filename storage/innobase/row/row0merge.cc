@@ -1219,35 +1219,36 @@ dberr_t row_merge_buf_write(const row_merge_buf_t *buf,
 	DBUG_RETURN(err);
 }
 
-/******************************************************//**
-Create a memory heap and allocate space for row_merge_rec_offsets()
-and mrec_buf_t[3].
+/** Create a memory heap and allocate space for the offsets and
+the buffers of merging n runs.
+@param[in]	index	record descriptor
+@param[in]	n	number of runs
+@param[out]	buf	n + 1 buffers
+@param[out]	offsets	n offsets
 @return memory heap */
 static
 mem_heap_t*
 row_merge_heap_create(
-/*==================*/
-	const dict_index_t*	index,		/*!< in: record descriptor */
-	mrec_buf_t**		buf,		/*!< out: 3 buffers */
-	rec_offs**		offsets1,	/*!< out: offsets */
-	rec_offs**		offsets2)	/*!< out: offsets */
+	const dict_index_t*	index,
+	ulint			n,
+	mrec_buf_t**		buf,
+	rec_offs**		offsets)
 {
 	ulint		i	= 1 + REC_OFFS_HEADER_SIZE
 		+ dict_index_get_n_fields(index);
-	mem_heap_t*	heap	= mem_heap_create(2 * i * sizeof **offsets1
-						  + 3 * sizeof **buf);
+	mem_heap_t*	heap	= mem_heap_create(n * i * sizeof **offsets
+						  + (n + 1) * sizeof **buf);
 
 	*buf = static_cast<mrec_buf_t*>(
-		mem_heap_alloc(heap, 3 * sizeof **buf));
-	*offsets1 = static_cast<rec_offs*>(
-		mem_heap_alloc(heap, i * sizeof **offsets1));
-	*offsets2 = static_cast<rec_offs*>(
-		mem_heap_alloc(heap, i * sizeof **offsets2));
-
-	rec_offs_set_n_alloc(*offsets1, i);
-	rec_offs_set_n_alloc(*offsets2, i);
-	rec_offs_set_n_fields(*offsets1, dict_index_get_n_fields(index));
-	rec_offs_set_n_fields(*offsets2, dict_index_get_n_fields(index));
+		mem_heap_alloc(heap, (n + 1) * sizeof **buf));
+
+	for (ulint j = 0; j < n; j++) {
+		offsets[j] = static_cast<rec_offs*>(
+			mem_heap_alloc(heap, i * sizeof **offsets));
+		rec_offs_set_n_alloc(offsets[j], i);
+		rec_offs_set_n_fields(offsets[j],
+				      dict_index_get_n_fields(index));
+	}
 
 	return(heap);
 }
@@ -1799,6 +1800,685 @@ row_geo_field_is_valid(
 	return(true);
 }
 
+/** Note the newest transaction that modified an index that is being
+created online, when the scan of the clustered index was completed.
+We prevent older readers from accessing this index, to ensure read
+consistency.
+@param index	secondary index that is being created */
+static void row_merge_note_max_trx(dict_index_t *index)
+{
+	index->lock.x_lock(SRW_LOCK_CALL);
+	ut_a(dict_index_get_online_status(index) == ONLINE_INDEX_CREATION);
+
+	trx_id_t max_trx_id = row_log_get_max_trx(index);
+
+	if (max_trx_id > index->trx_id) {
+		index->trx_id = max_trx_id;
+	}
+
+	index->lock.x_unlock();
+}
+
+/** Maximum size of the sort and file buffers that
+row_merge_read_clustered_index_parallel() allocates for all its threads,
+in addition to the buffers of the caller */
+static constexpr size_t ROW_MERGE_SCAN_BUF_BUDGET = 64U << 20;
+
+/** State of a clustered index scan that is executed by
+innodb_ddl_threads threads, each of which reads some ranges of the
+clustered index and writes sorted blocks of index entries to the
+temporary files. Because row_merge_sort() treats each block as a run,
+the blocks of the threads may be interleaved in the files. */
+struct row_merge_scan_t
+{
+	/** transaction */
+	trx_t*			trx;
+	/** MySQL table object, for reporting duplicate keys */
+	TABLE*			table;
+	/** the table where the indexes are being created */
+	dict_table_t*		old_table;
+	/** indexes to be created */
+	dict_index_t**		index;
+	/** temporary files, protected by mutex */
+	merge_file_t*		files;
+	/** MySQL key numbers to create */
+	const ulint*		key_numbers;
+	/** number of indexes to create */
+	ulint			n_index;
+	/** whether the indexes are being created online */
+	bool			online;
+	/** columns whose collations changed, or nullptr */
+	const col_collations*	col_collate;
+	/** temporary file handle, protected by mutex */
+	pfs_os_file_t*		tmpfd;
+	/** directory of the temporary files */
+	const char*		path;
+	/** performance schema accounting object, protected by mutex */
+	ut_stage_alter_t*	stage;
+	/** percent of task weight out of total alter job */
+	double			pct_cost;
+	/** estimated number of rows in the table */
+	ib_uint64_t		table_total_rows;
+	/** boundaries of the ranges; range r covers the keys
+	from bounds[r - 1] (inclusive) to bounds[r] (exclusive) */
+	std::vector<const dtuple_t*>	bounds;
+	/** the next range to scan */
+	Atomic_counter<ulint>	next_range;
+	/** mutex protecting the following fields and the above ones
+	that are noted to be protected by it */
+	srw_mutex		mutex;
+	/** number of rows read */
+	ib_uint64_t		read_rows;
+	/** the first error that was encountered */
+	dberr_t			err;
+
+	/** Note an error, unless an error was already noted.
+	@param error	error code
+	@param key_num	value for trx->error_key_num
+	@return error */
+	dberr_t set_error(dberr_t error, ulint key_num)
+	{
+		mutex.wr_lock();
+		if (err == DB_SUCCESS) {
+			err = error;
+			trx->error_key_num = key_num;
+		}
+		mutex.wr_unlock();
+		return error;
+	}
+};
+
+/** A thread of a parallel clustered index scan */
+struct row_merge_scan_thread_t
+{
+	/** the scan */
+	row_merge_scan_t*	scan;
+	/** sort buffers, one for each index */
+	row_merge_buf_t**	merge_buf;
+	/** file buffer */
+	row_merge_block_t*	block;
+	/** encrypted file buffer, or nullptr */
+	row_merge_block_t*	crypt_block;
+	/** heap memory to create clustered index tuples */
+	mem_heap_t*		row_heap;
+	/** heap memory to process virtual columns */
+	mem_heap_t*		v_heap;
+};
+
+/** Sort a buffer of a parallel clustered index scan and write it to
+the temporary file of the index, and empty the buffer.
+@param thr	scan thread
+@param i	index number
+@return error code */
+static dberr_t row_merge_scan_write(row_merge_scan_thread_t *thr, ulint i)
+{
+	row_merge_scan_t*	scan = thr->scan;
+	row_merge_buf_t*	buf = thr->merge_buf[i];
+	const dict_index_t*	index = buf->index;
+
+	ut_ad(buf->n_tuples);
+
+	if (dict_index_is_unique(index)) {
+		/* Reporting a duplicate would modify table->record[0],
+		which is shared by all threads. */
+		row_merge_dup_t	dup = {buf->index, nullptr, nullptr, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			scan->mutex.wr_lock();
+			if (scan->err == DB_SUCCESS) {
+				dup.table = scan->table;
+				dup.n_dup = 0;
+				/* The duplicates are adjacent in the sorted
+				buffer. Report the first one. */
+				for (ulint j = 1; !dup.n_dup
+				     && j < buf->n_tuples; j++) {
+					std::ignore = row_merge_tuple_cmp(
+						index, index->n_uniq,
+						index->n_fields,
+						buf->tuples[j - 1],
+						buf->tuples[j], &dup);
+				}
+				scan->err = DB_DUPLICATE_KEY;
+				scan->trx->error_key_num
+					= scan->key_numbers[i];
+			}
+			scan->mutex.wr_unlock();
+			return DB_DUPLICATE_KEY;
+		}
+	} else {
+		row_merge_buf_sort(buf, nullptr);
+	}
+
+	merge_file_t*	file = &scan->files[i];
+	merge_file_t	of;
+
+	/* Reserve a block in the file. */
+	scan->mutex.wr_lock();
+	const bool created = row_merge_file_create_if_needed(
+		file, scan->tmpfd, 0, scan->path);
+	if (created) {
+		of = *file;
+		file->offset++;
+		file->n_rec += buf->n_tuples;
+	}
+	scan->mutex.wr_unlock();
+
+	if (!created) {
+		return scan->set_error(DB_OUT_OF_MEMORY, i);
+	}
+
+	row_merge_buf_write(buf,
+#ifndef DBUG_OFF
+			    &of,
+#endif
+			    thr->block);
+
+	if (!row_merge_write(of.fd, of.offset, thr->block, thr->crypt_block,
+			     scan->old_table->space_id)) {
+		return scan->set_error(DB_TEMP_FILE_WRITE_FAIL, i);
+	}
+
+	MEM_UNDEFINED(&thr->block[0], srv_sort_buf_size);
+
+	thr->merge_buf[i] = row_merge_buf_empty(buf);
+	return DB_SUCCESS;
+}
+
+/** Add the index entries for a row in a parallel clustered index scan.
+@param thr	scan thread
+@param row	table row
+@param ext	cache of externally stored column prefixes, or nullptr
+@return error code */
+static dberr_t row_merge_scan_add(row_merge_scan_thread_t *thr,
+				  dtuple_t *row, const row_ext_t *ext)
+{
+	row_merge_scan_t*	scan = thr->scan;
+
+	for (ulint i = 0; i < scan->n_index; i++) {
+		doc_id_t	doc_id = 0;
+		dberr_t		err = DB_SUCCESS;
+
+		if (row_merge_buf_add(thr->merge_buf[i], nullptr,
+				      scan->old_table, scan->old_table,
+				      nullptr, row, ext, &doc_id, nullptr,
+				      &err, &thr->v_heap, nullptr, scan->trx,
+				      scan->col_collate)) {
+			if (err != DB_SUCCESS) {
+				return scan->set_error(err, i);
+			}
+			continue;
+		}
+
+		if (err != DB_SUCCESS) {
+			return scan->set_error(err, i);
+		}
+
+		/* The buffer is full. Write it out and try again. */
+		err = row_merge_scan_write(thr, i);
+		if (err != DB_SUCCESS) {
+			return err;
+		}
+
+		if (!row_merge_buf_add(thr->merge_buf[i], nullptr,
+				       scan->old_table, scan->old_table,
+				       nullptr, row, ext, &doc_id, nullptr,
+				       &err, &thr->v_heap, nullptr, scan->trx,
+				       scan->col_collate)) {
+			/* An empty buffer should have enough
+			room for at least one record. */
+			ut_ad(err == DB_OUT_OF_MEMORY
+			      || err == DB_TOO_BIG_RECORD);
+			return scan->set_error(err, i);
+		} else if (err != DB_SUCCESS) {
+			return scan->set_error(err, i);
+		}
+	}
+
+	return DB_SUCCESS;
+}
+
+/** Account for a clustered index page that was read in a parallel scan.
+@param scan	the scan
+@param n_recs	number of records on the page
+@param n_rows	number of rows that were read
+@return error code */
+static dberr_t row_merge_scan_page_done(row_merge_scan_t *scan,
+					ulint n_recs, ulint n_rows)
+{
+	if (UNIV_UNLIKELY(trx_is_interrupted(scan->trx))) {
+		return scan->set_error(DB_INTERRUPTED, 0);
+	}
+
+	scan->mutex.wr_lock();
+	scan->stage->n_pk_recs_inc(n_recs);
+	scan->stage->inc();
+	scan->read_rows += n_rows;
+	/* Increment innodb_onlineddl_pct_progress status variable */
+	double curr_progress = scan->read_rows >= scan->table_total_rows
+		? scan->pct_cost
+		: scan->pct_cost * static_cast<double>(scan->read_rows)
+		/ static_cast<double>(scan->table_total_rows);
+	/* presenting 10.12% as 1012 integer */
+	onlineddl_pct_progress = (ulint) (curr_progress * 100);
+	dberr_t err = scan->err;
+	scan->mutex.wr_unlock();
+	return err;
+}
+
+/** Read a range of the clustered index in a parallel scan.
+@param thr	scan thread
+@param r	range number
+@return error code */
+static dberr_t row_merge_scan_range(row_merge_scan_thread_t *thr, ulint r)
+{
+	row_merge_scan_t*	scan = thr->scan;
+	trx_t*			trx = scan->trx;
+	dict_table_t*		old_table = scan->old_table;
+	dict_index_t*		clust_index = dict_table_get_first_index(
+		old_table);
+	const dtuple_t*		hi = r < scan->bounds.size()
+		? scan->bounds[r] : nullptr;
+	btr_pcur_t		pcur;
+	mtr_t			mtr;
+	dberr_t			err;
+	ulint			n_recs = 0;
+	ulint			n_rows = 0;
+
+	mtr.start();
+
+	if (r) {
+		/* Position on the last record before the range. */
+		pcur.btr_cur.page_cur.index = clust_index;
+		err = btr_pcur_open(scan->bounds[r - 1], PAGE_CUR_L,
+				    BTR_SEARCH_LEAF, &pcur, &mtr);
+	} else {
+		err = pcur.open_leaf(true, clust_index, BTR_SEARCH_LEAF,
+				     &mtr);
+		/* Skip the metadata pseudo-record, which was validated
+		in row_merge_read_clustered_index(). */
+		if (err == DB_SUCCESS && clust_index->is_instant()
+		    && !page_cur_move_to_next(btr_pcur_get_page_cur(&pcur))) {
+			err = DB_CORRUPTION;
+		}
+	}
+
+	if (err != DB_SUCCESS) {
+		goto func_exit;
+	}
+
+	for (;;) {
+		page_cur_t*	cur = btr_pcur_get_page_cur(&pcur);
+		const rec_t*	rec;
+		trx_id_t	rec_trx_id;
+		rec_offs*	offsets;
+		dtuple_t*	row;
+		row_ext_t*	ext;
+
+		n_recs++;
+
+		if (!page_cur_move_to_next(cur)) {
+corrupted_rec:
+			err = DB_CORRUPTION;
+			goto func_exit;
+		}
+
+		if (page_cur_is_after_last(cur)) {
+			err = row_merge_scan_page_done(scan, n_recs, n_rows);
+			n_recs = n_rows = 0;
+
+			if (err != DB_SUCCESS) {
+				goto func_exit;
+			}
+
+			/* Do not continue if table pages are still
+			encrypted */
+			if (!old_table->is_readable()) {
+				err = DB_DECRYPTION_FAILED;
+				goto func_exit;
+			}
+
+			uint32_t next_page_no = btr_page_get_next(
+				page_cur_get_page(cur));
+
+			if (next_page_no == FIL_NULL) {
+				goto func_exit;
+			}
+
+			buf_block_t* block = buf_page_get_gen(
+				page_id_t(old_table->space->id, next_page_no),
+				old_table->space->zip_size(),
+				RW_S_LATCH, nullptr, BUF_GET, &mtr, &err);
+			if (!block) {
+				goto func_exit;
+			}
+
+			buf_page_make_young_if_needed(&block->page);
+
+			const auto s = mtr.get_savepoint();
+			mtr.rollback_to_savepoint(s - 2, s - 1);
+
+			page_cur_set_before_first(block, cur);
+			if (!page_cur_move_to_next(cur)
+			    || page_cur_is_after_last(cur)) {
+				goto corrupted_rec;
+			}
+		}
+
+		mem_heap_empty(thr->row_heap);
+
+		rec = page_cur_get_rec(cur);
+		offsets = rec_get_offsets(rec, clust_index, NULL,
+					  clust_index->n_core_fields,
+					  ULINT_UNDEFINED, &thr->row_heap);
+
+		if (hi && cmp_dtuple_rec(hi, rec, clust_index, offsets) <= 0) {
+			/* The rest belongs to the next range. */
+			break;
+		}
+
+		if (scan->online) {
+			/* Perform a REPEATABLE READ, like
+			row_merge_read_clustered_index() does. */
+			rec_trx_id = row_get_rec_trx_id(rec, clust_index,
+							offsets);
+			ut_ad(trx->read_view.is_open());
+			ut_ad(rec_trx_id != trx->id);
+
+			if (!trx->read_view.changes_visible(rec_trx_id)) {
+				if (rec_trx_id
+				    >= trx->read_view.low_limit_id()
+				    && rec_trx_id
+				    >= trx_sys.get_max_trx_id()) {
+					goto corrupted_rec;
+				}
+
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					&trx->read_view, &thr->row_heap,
+					thr->row_heap, &old_vers, NULL);
+
+				if (!old_vers) {
+					continue;
+				}
+
+				ut_ad(row_get_rec_trx_id(old_vers, clust_index,
+							 offsets) < trx->id);
+
+				rec = old_vers;
+				rec_trx_id = 0;
+			}
+
+			if (rec_get_deleted_flag(
+				    rec, dict_table_is_comp(old_table))) {
+				ut_ad(rec == page_cur_get_rec(cur)
+				      ? rec_trx_id
+				      : !rec_trx_id);
+				continue;
+			}
+		} else if (rec_get_deleted_flag(
+				   rec, dict_table_is_comp(old_table))) {
+			/* Skip purgeable delete-marked records. */
+			ut_d(rec_trx_id = rec_get_trx_id(rec, clust_index));
+			ut_ad(rec_trx_id);
+			ut_ad(rec_trx_id < trx->id);
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row = row_build_w_add_vcol(ROW_COPY_POINTERS, clust_index,
+					   rec, offsets, old_table,
+					   nullptr, nullptr, nullptr, &ext,
+					   thr->row_heap);
+		ut_ad(row);
+
+		err = row_merge_scan_add(thr, row, ext);
+		if (err != DB_SUCCESS) {
+			goto func_exit;
+		}
+
+		if (thr->v_heap) {
+			mem_heap_empty(thr->v_heap);
+		}
+
+		n_rows++;
+	}
+
+func_exit:
+	mtr.commit();
+	ut_free(pcur.old_rec_buf);
+
+	if (err == DB_SUCCESS) {
+		return row_merge_scan_page_done(scan, n_recs, n_rows);
+	}
+
+	/* The error may have been noted already. */
+	return scan->set_error(err, 0);
+}
+
+/** Read clustered index ranges until none are left, and write out
+the remaining index entries.
+@param arg	scan thread */
+static void row_merge_scan_thread(void *arg)
+{
+	row_merge_scan_thread_t*	thr
+		= static_cast<row_merge_scan_thread_t*>(arg);
+	row_merge_scan_t*		scan = thr->scan;
+	dberr_t				err = DB_SUCCESS;
+
+	thr->row_heap = mem_heap_create(sizeof(mrec_buf_t));
+
+	for (ulint r; err == DB_SUCCESS
+	     && (r = scan->next_range++) <= scan->bounds.size(); ) {
+		err = row_merge_scan_range(thr, r);
+	}
+
+	for (ulint i = 0; err == DB_SUCCESS && i < scan->n_index; i++) {
+		if (thr->merge_buf[i]->n_tuples) {
+			err = row_merge_scan_write(thr, i);
+		}
+	}
+
+	mem_heap_free(thr->row_heap);
+	thr->row_heap = nullptr;
+
+	if (thr->v_heap) {
+		mem_heap_free(thr->v_heap);
+		thr->v_heap = nullptr;
+	}
+}
+
+/** Determine whether row_merge_read_clustered_index() can read the
+clustered index in multiple threads.
+@param old_table	table where rows are read from
+@param new_table	table where indexes are created
+@param index		indexes to be created
+@param n_index		number of indexes to create
+@param add_v		newly added virtual columns, or nullptr
+@param pcur		cursor on the first clustered index leaf page
+@return whether a parallel scan can be used */
+static bool row_merge_scan_is_parallel(const dict_table_t *old_table,
+				       const dict_table_t *new_table,
+				       dict_index_t **index, ulint n_index,
+				       const dict_add_v_col_t *add_v,
+				       btr_pcur_t *pcur)
+{
+	/* Only secondary indexes that can be written to temporary files
+	are supported. Building their entries does not modify any state
+	that is shared between the rows. */
+	if (srv_ddl_threads <= 1 || old_table != new_table || add_v
+	    || !page_has_next(btr_pcur_get_page(pcur))) {
+		return false;
+	}
+
+	for (ulint i = 0; i < n_index; i++) {
+		if (index[i]->is_clust()
+		    || (index[i]->type & (DICT_FTS | DICT_SPATIAL))
+		    || index[i]->has_virtual()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** Read the clustered index in innodb_ddl_threads threads and create
+temporary files containing the index entries for the indexes to be built.
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table object, for reporting
+				duplicate keys
+@param[in]	old_table	table where rows are read from and
+				where indexes are created
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in,out]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in,out]	merge_buf	sort buffers for the first thread
+@param[in,out]	block		file buffer for the first thread
+@param[in,out]	crypt_block	encrypted file buffer for the first
+				thread, or NULL
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	stage		performance schema accounting object
+@param[in]	pct_cost	percent of task weight out of total
+				alter job
+@param[in]	table_total_rows	estimated number of rows
+@param[in]	col_collate	columns whose collations changed, or nullptr
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+	trx_t*			trx,
+	struct TABLE*		table,
+	dict_table_t*		old_table,
+	bool			online,
+	dict_index_t**		index,
+	merge_file_t*		files,
+	const ulint*		key_numbers,
+	ulint			n_index,
+	row_merge_buf_t**	merge_buf,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	pfs_os_file_t*		tmpfd,
+	ut_stage_alter_t*	stage,
+	double			pct_cost,
+	ib_uint64_t		table_total_rows,
+	const col_collations*	col_collate)
+{
+	row_merge_scan_t	scan;
+	/* Assume at least 8 times as many ranges as threads, so
+	that the work will be evenly distributed. */
+	const ulint		n_ranges = srv_ddl_threads * 8;
+	mem_heap_t*		heap = mem_heap_create(1024);
+	dict_index_t*		clust_index = dict_table_get_first_index(
+		old_table);
+
+	scan.err = btr_split_key_ranges(clust_index, n_ranges, heap,
+					scan.bounds);
+
+	if (scan.err != DB_SUCCESS) {
+		trx->error_key_num = 0;
+		mem_heap_free(heap);
+		return scan.err;
+	}
+
+	scan.trx = trx;
+	scan.table = table;
+	scan.old_table = old_table;
+	scan.index = index;
+	scan.files = files;
+	scan.key_numbers = key_numbers;
+	scan.n_index = n_index;
+	scan.online = online;
+	scan.col_collate = col_collate;
+	scan.tmpfd = tmpfd;
+	scan.path = thd_innodb_tmpdir(trx->mysql_thd);
+	scan.stage = stage;
+	scan.pct_cost = pct_cost;
+	scan.table_total_rows = table_total_rows;
+	scan.next_range = 0;
+	scan.read_rows = 0;
+	scan.mutex.init();
+
+	/* The buffers of the additional threads must fit in
+	ROW_MERGE_SCAN_BUF_BUDGET. Each thread allocates a sort buffer
+	for each index, and a file buffer for encryption if needed. */
+	size_t	thread_buf_size = srv_sort_buf_size;
+	if (crypt_block) {
+		thread_buf_size += srv_sort_buf_size;
+	}
+	for (ulint i = 0; i < n_index; i++) {
+		const ulint max_tuples = srv_sort_buf_size
+			/ std::max<ulint>(1, dict_index_get_min_size(index[i]));
+		thread_buf_size += srv_sort_buf_size
+			+ 2 * max_tuples * sizeof(mtuple_t);
+	}
+
+	const ulint n_threads = std::min<ulint>(
+		std::min<ulint>(srv_ddl_threads, scan.bounds.size() + 1),
+		1 + ROW_MERGE_SCAN_BUF_BUDGET / thread_buf_size);
+	std::vector<row_merge_scan_thread_t> threads(n_threads);
+	std::vector<std::unique_ptr<tpool::waitable_task>> tasks;
+
+	threads[0] = {&scan, merge_buf, block, crypt_block, nullptr, nullptr};
+
+	for (ulint t = 1; t < n_threads; t++) {
+		row_merge_scan_thread_t& thr = threads[t];
+		thr = {&scan, nullptr, nullptr, nullptr, nullptr, nullptr};
+
+		thr.merge_buf = static_cast<row_merge_buf_t**>(
+			ut_malloc_nokey(n_index * sizeof *thr.merge_buf));
+		for (ulint i = 0; i < n_index; i++) {
+			thr.merge_buf[i] = row_merge_buf_create(index[i]);
+		}
+
+		thr.block = static_cast<row_merge_block_t*>(
+			aligned_malloc(srv_sort_buf_size, 1024));
+		if (crypt_block) {
+			thr.crypt_block = static_cast<row_merge_block_t*>(
+				aligned_malloc(srv_sort_buf_size, 1024));
+		}
+
+		tasks.emplace_back(new tpool::waitable_task(
+					   row_merge_scan_thread, &thr));
+		srv_thread_pool->submit_task(tasks.back().get());
+	}
+
+	row_merge_scan_thread(&threads[0]);
+
+	tpool::tpool_wait_begin();
+	for (auto& task : tasks) {
+		task->wait();
+	}
+	tpool::tpool_wait_end();
+
+	for (ulint t = 1; t < n_threads; t++) {
+		row_merge_scan_thread_t& thr = threads[t];
+
+		for (ulint i = 0; i < n_index; i++) {
+			row_merge_buf_free(thr.merge_buf[i]);
+		}
+		ut_free(thr.merge_buf);
+		aligned_free(thr.block);
+		aligned_free(thr.crypt_block);
+	}
+
+	if (scan.err == DB_SUCCESS && online) {
+		for (ulint i = 0; i < n_index; i++) {
+			row_merge_note_max_trx(index[i]);
+		}
+	}
+
+	scan.mutex.destroy();
+	mem_heap_free(heap);
+
+	return scan.err;
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -2069,6 +2749,18 @@ row_merge_read_clustered_index(
 		}
 	}
 
+	if (row_merge_scan_is_parallel(old_table, new_table, index, n_index,
+				       add_v, &pcur)) {
+		mtr.commit();
+		mtr_started = false;
+		err = row_merge_read_clustered_index_parallel(
+			trx, table, new_table, online, index, files,
+			key_numbers, n_index, merge_buf, block, crypt_block,
+			tmpfd, stage, pct_cost, table_total_rows,
+			col_collate);
+		goto func_exit;
+	}
+
 	if (old_table != new_table) {
 		/* The table is being rebuilt.  Identify the columns
 		that were flagged NOT NULL in the new table, so that
@@ -2768,27 +3460,8 @@ row_merge_read_clustered_index(
 					row_merge_buf_sort(buf, NULL);
 				}
 			} else if (online && new_table == old_table) {
-				/* Note the newest transaction that
-				modified this index when the scan was
-				completed. We prevent older readers
-				from accessing this index, to ensure
-				read consistency. */
-
 				ut_a(row == NULL);
-
-				dict_index_t* index = buf->index;
-				index->lock.x_lock(SRW_LOCK_CALL);
-				ut_a(dict_index_get_online_status(index)
-				     == ONLINE_INDEX_CREATION);
-
-				trx_id_t max_trx_id = row_log_get_max_trx(
-					index);
-
-				if (max_trx_id > index->trx_id) {
-					index->trx_id = max_trx_id;
-				}
-
-				index->lock.x_unlock();
+				row_merge_note_max_trx(buf->index);
 			}
 
 			/* Secondary index and clustered index which is
@@ -3060,407 +3733,290 @@ row_merge_read_clustered_index(
 	DBUG_RETURN(err);
 }
 
-/** Write a record via buffer 2 and read the next record to buffer N.
-@param N number of the buffer (0 or 1)
-@param INDEX record descriptor
-@param AT_END statement to execute at end of input */
-#define ROW_MERGE_WRITE_GET_NEXT_LOW(N, INDEX, AT_END)			\
-	do {								\
-		b2 = row_merge_write_rec(&block[2 * srv_sort_buf_size], \
-					 &buf[2], b2,			\
-					 of->fd, &of->offset,		\
-					 mrec##N, offsets##N,		\
-			crypt_block ? &crypt_block[2 * srv_sort_buf_size] : NULL , \
-					space);				\
-		if (UNIV_UNLIKELY(!b2 || ++of->n_rec > file->n_rec)) {	\
-			goto corrupt;					\
-		}							\
-		b##N = row_merge_read_rec(&block[N * srv_sort_buf_size],\
-					  &buf[N], b##N, INDEX,		\
-					  file->fd, foffs##N,		\
-					  &mrec##N, offsets##N,		\
-			crypt_block ? &crypt_block[N * srv_sort_buf_size] : NULL, \
-					  space);			\
-									\
-		if (UNIV_UNLIKELY(!b##N)) {				\
-			if (mrec##N) {					\
-				goto corrupt;				\
-			}						\
-			AT_END;						\
-		}							\
-	} while (0)
-
-#ifdef HAVE_PSI_STAGE_INTERFACE
-#define ROW_MERGE_WRITE_GET_NEXT(N, INDEX, AT_END)			\
-	do {								\
-		if (stage != NULL) {					\
-			stage->inc();					\
-		}							\
-		ROW_MERGE_WRITE_GET_NEXT_LOW(N, INDEX, AT_END);		\
-	} while (0)
-#else /* HAVE_PSI_STAGE_INTERFACE */
-#define ROW_MERGE_WRITE_GET_NEXT(N, INDEX, AT_END)			\
-	ROW_MERGE_WRITE_GET_NEXT_LOW(N, INDEX, AT_END)
-#endif /* HAVE_PSI_STAGE_INTERFACE */
-
-/** Merge two blocks of records on disk and write a bigger block.
-@param[in]	dup	descriptor of index being created
-@param[in]	file	file containing index entries
-@param[in,out]	block	3 buffers
-@param[in,out]	foffs0	offset of first source list in the file
-@param[in,out]	foffs1	offset of second source list in the file
-@param[in,out]	of	output file
-@param[in,out]	stage	performance schema accounting object, used by
-ALTER TABLE. If not NULL stage->inc() will be called for each record
-processed.
-@param[in,out]	crypt_block	encryption buffer
-@param[in]	space	tablespace ID for encryption
-@return DB_SUCCESS or error code */
-static MY_ATTRIBUTE((warn_unused_result))
-dberr_t
-row_merge_blocks(
-	const row_merge_dup_t*	dup,
-	const merge_file_t*	file,
-	row_merge_block_t*	block,
-	ulint*			foffs0,
-	ulint*			foffs1,
-	merge_file_t*		of,
-	ut_stage_alter_t*	stage MY_ATTRIBUTE((unused)),
-	row_merge_block_t*	crypt_block,
-	ulint			space)
-{
-	mem_heap_t*	heap;	/*!< memory heap for offsets0, offsets1 */
-
-	mrec_buf_t*	buf;	/*!< buffer for handling
-				split mrec in block[] */
-	const byte*	b0;	/*!< pointer to block[0] */
-	const byte*	b1;	/*!< pointer to block[srv_sort_buf_size] */
-	byte*		b2;	/*!< pointer to block[2 * srv_sort_buf_size] */
-	const mrec_t*	mrec0;	/*!< merge rec, points to block[0] or buf[0] */
-	const mrec_t*	mrec1;	/*!< merge rec, points to
-				block[srv_sort_buf_size] or buf[1] */
-	rec_offs*	offsets0;/* offsets of mrec0 */
-	rec_offs*	offsets1;/* offsets of mrec1 */
-
-	DBUG_ENTER("row_merge_blocks");
-	DBUG_LOG("ib_merge_sort",
-		 "fd=" << file->fd << ',' << *foffs0 << '+' << *foffs1
-		 << " to fd=" << of->fd << ',' << of->offset);
-
-	heap = row_merge_heap_create(dup->index, &buf, &offsets0, &offsets1);
-
-	/* Write a record and read the next record.  Split the output
-	file in two halves, which can be merged on the following pass. */
-
-	if (!row_merge_read(file->fd, *foffs0, &block[0],
-			    crypt_block ? &crypt_block[0] : NULL,
-			    space) ||
-	    !row_merge_read(file->fd, *foffs1, &block[srv_sort_buf_size],
-			    crypt_block ? &crypt_block[srv_sort_buf_size] : NULL,
-			    space)) {
-corrupt:
-		mem_heap_free(heap);
-		DBUG_RETURN(DB_CORRUPTION);
-	}
-
-	b0 = &block[0];
-	b1 = &block[srv_sort_buf_size];
-	b2 = &block[2 * srv_sort_buf_size];
+/** Maximum number of runs that row_merge_sort() merges at a time */
+static constexpr ulint ROW_MERGE_MAX_FAN_IN = 8;
 
-	b0 = row_merge_read_rec(
-		&block[0], &buf[0], b0, dup->index,
-		file->fd, foffs0, &mrec0, offsets0,
-		crypt_block ? &crypt_block[0] : NULL,
-		space);
+/** Maximum size of the merge buffers that row_merge_sort() allocates
+for all its threads, in addition to the 3 buffers of the caller */
+static constexpr size_t ROW_MERGE_SORT_BUF_BUDGET = 64U << 20;
 
-	b1 = row_merge_read_rec(
-		&block[srv_sort_buf_size],
-		&buf[srv_sort_buf_size], b1, dup->index,
-		file->fd, foffs1, &mrec1, offsets1,
-		crypt_block ? &crypt_block[srv_sort_buf_size] : NULL,
-		space);
+/** A pass of row_merge_sort(), which merges groups of up to fan_in
+consecutive runs of the input file in innodb_ddl_threads threads.
 
-	if (UNIV_UNLIKELY(!b0 && mrec0)
-	    || UNIV_UNLIKELY(!b1 && mrec1)) {
-
-		goto corrupt;
-	}
-
-	while (mrec0 && mrec1) {
-		int cmp = cmp_rec_rec_simple(
-			mrec0, mrec1, offsets0, offsets1,
-			dup->index, dup->table);
-		if (cmp < 0) {
-			ROW_MERGE_WRITE_GET_NEXT(0, dup->index, goto merged);
-		} else if (cmp) {
-			ROW_MERGE_WRITE_GET_NEXT(1, dup->index, goto merged);
-		} else {
-			mem_heap_free(heap);
-			DBUG_RETURN(DB_DUPLICATE_KEY);
-		}
-	}
-
-merged:
-	if (mrec0) {
-		/* append all mrec0 to output */
-		for (;;) {
-			ROW_MERGE_WRITE_GET_NEXT(0, dup->index, goto done0);
-		}
-	}
-done0:
-	if (mrec1) {
-		/* append all mrec1 to output */
-		for (;;) {
-			ROW_MERGE_WRITE_GET_NEXT(1, dup->index, goto done1);
-		}
-	}
-done1:
-
-	mem_heap_free(heap);
-
-	b2 = row_merge_write_eof(
-		&block[2 * srv_sort_buf_size],
-		b2, of->fd, &of->offset,
-		crypt_block ? &crypt_block[2 * srv_sort_buf_size] : NULL,
-		space);
-	DBUG_RETURN(b2 ? DB_SUCCESS : DB_CORRUPTION);
-}
-
-/** Copy a block of index entries.
-@param[in]	index	index being created
-@param[in]	file	input file
-@param[in,out]	block	3 buffers
-@param[in,out]	foffs0	input file offset
-@param[in,out]	of	output file
-@param[in,out]	stage	performance schema accounting object, used by
-ALTER TABLE. If not NULL stage->inc() will be called for each record
-processed.
-@param[in,out]	crypt_block	encryption buffer
-@param[in]	space	tablespace ID for encryption
-@return TRUE on success, FALSE on failure */
-static MY_ATTRIBUTE((warn_unused_result))
-ibool
-row_merge_blocks_copy(
-	const dict_index_t*	index,
-	const merge_file_t*	file,
-	row_merge_block_t*	block,
-	ulint*			foffs0,
-	merge_file_t*		of,
-	ut_stage_alter_t*	stage MY_ATTRIBUTE((unused)),
-	row_merge_block_t*	crypt_block,
-	ulint			space)
+The output of a group cannot occupy more blocks than its input, because
+the records of a run are packed into the blocks without gaps and only
+the last block of a run is partially filled. Therefore, each group is
+written to the output file starting at the offset where its first run
+starts in the input file, and the groups can be merged independently. */
+struct row_merge_pass_t
 {
-	mem_heap_t*	heap;	/*!< memory heap for offsets0, offsets1 */
-
-	mrec_buf_t*	buf;	/*!< buffer for handling
-				split mrec in block[] */
-	const byte*	b0;	/*!< pointer to block[0] */
-	byte*		b2;	/*!< pointer to block[2 * srv_sort_buf_size] */
-	const mrec_t*	mrec0;	/*!< merge rec, points to block[0] */
-	rec_offs*	offsets0;/* offsets of mrec0 */
-	rec_offs*	offsets1;/* dummy offsets */
-
-	DBUG_ENTER("row_merge_blocks_copy");
-	DBUG_LOG("ib_merge_sort",
-		 "fd=" << file->fd << ',' << foffs0
-		 << " to fd=" << of->fd << ',' << of->offset);
-
-	heap = row_merge_heap_create(index, &buf, &offsets0, &offsets1);
-
-	/* Write a record and read the next record.  Split the output
-	file in two halves, which can be merged on the following pass. */
-
-	if (!row_merge_read(file->fd, *foffs0, &block[0],
-			crypt_block ? &crypt_block[0] : NULL,
-			space)) {
-corrupt:
-		mem_heap_free(heap);
-		DBUG_RETURN(FALSE);
-	}
-
-	b0 = &block[0];
-
-	b2 = &block[2 * srv_sort_buf_size];
-
-	b0 = row_merge_read_rec(&block[0], &buf[0], b0, index,
-				file->fd, foffs0, &mrec0, offsets0,
-				crypt_block ? &crypt_block[0] : NULL,
-				space);
-
-	if (UNIV_UNLIKELY(!b0 && mrec0)) {
-
-		goto corrupt;
-	}
-
-	if (mrec0) {
-		/* append all mrec0 to output */
-		for (;;) {
-			ROW_MERGE_WRITE_GET_NEXT(0, index, goto done0);
-		}
-	}
-done0:
-
-	/* The file offset points to the beginning of the last page
-	that has been read.  Update it to point to the next block. */
-	(*foffs0)++;
-
-	mem_heap_free(heap);
+	/** transaction */
+	trx_t*			trx;
+	/** descriptor of index being created */
+	const row_merge_dup_t*	dup;
+	/** input file */
+	const merge_file_t*	file;
+	/** output file */
+	pfs_os_file_t		out_fd;
+	/** number of runs in the input file */
+	ulint			n_run;
+	/** the first offset of each run in the input file */
+	const ulint*		run_offset;
+	/** number of runs merged at a time */
+	ulint			fan_in;
+	/** tablespace ID for encryption */
+	ulint			space;
+	/** performance schema accounting object, or NULL;
+	protected by mutex */
+	ut_stage_alter_t*	stage;
+	/** the next group to merge */
+	Atomic_counter<ulint>	next_group;
+	/** mutex protecting the following fields and stage */
+	srw_mutex		mutex;
+	/** number of records written */
+	ulint			n_rec;
+	/** the end offset of the output of the last group */
+	ulint			end_offset;
+	/** the first error that was encountered */
+	dberr_t			err;
+};
 
-	DBUG_RETURN(row_merge_write_eof(
-			    &block[2 * srv_sort_buf_size],
-			    b2, of->fd, &of->offset,
-			    crypt_block
-			    ? &crypt_block[2 * srv_sort_buf_size]
-			    : NULL, space)
-		    != NULL);
-}
+/** A thread of a row_merge_sort() pass */
+struct row_merge_pass_thread_t
+{
+	/** the pass */
+	row_merge_pass_t*	pass;
+	/** fan_in + 1 buffers */
+	row_merge_block_t*	block;
+	/** fan_in + 1 encryption buffers, or NULL */
+	row_merge_block_t*	crypt_block;
+	/** memory heap for buf, offsets */
+	mem_heap_t*		heap;
+	/** fan_in + 1 buffers for handling split mrec in block[] */
+	mrec_buf_t*		buf;
+	/** fan_in offsets */
+	rec_offs*		offsets[ROW_MERGE_MAX_FAN_IN];
+};
 
-/** Merge disk files.
-@param[in]	trx		transaction
-@param[in]	dup		descriptor of index being created
-@param[in,out]	file		file containing index entries
-@param[in,out]	block		3 buffers
-@param[in,out]	tmpfd		temporary file handle
-@param[in,out]	num_run		Number of runs that remain to be merged
-@param[in,out]	run_offset	Array that contains the first offset number
-for each merge run
-@param[in,out]	stage		performance schema accounting object, used by
-@param[in,out]	crypt_block	encryption buffer
-@param[in]	space		tablespace ID for encryption
-ALTER TABLE. If not NULL stage->inc() will be called for each record
-processed.
+/** Merge a group of runs to the output file.
+@param thr	merge thread
+@param g	group number
 @return DB_SUCCESS or error code */
-static
-dberr_t
-row_merge(
-	trx_t*			trx,
-	const row_merge_dup_t*	dup,
-	merge_file_t*		file,
-	row_merge_block_t*	block,
-	pfs_os_file_t*		tmpfd,
-	ulint*			num_run,
-	ulint*			run_offset,
-	ut_stage_alter_t*	stage,
-	row_merge_block_t*	crypt_block,
-	ulint			space)
+static dberr_t row_merge_group(row_merge_pass_thread_t *thr, ulint g)
 {
-	ulint		foffs0;	/*!< first input offset */
-	ulint		foffs1;	/*!< second input offset */
-	dberr_t		error;	/*!< error code */
-	merge_file_t	of;	/*!< output file */
-	const ulint	ihalf	= run_offset[*num_run / 2];
-				/*!< half the input file */
-	ulint		n_run	= 0;
-				/*!< num of runs generated from this merge */
-
-	MEM_CHECK_ADDRESSABLE(&block[0], 3 * srv_sort_buf_size);
-
-	if (crypt_block) {
-		MEM_CHECK_ADDRESSABLE(&crypt_block[0], 3 * srv_sort_buf_size);
+	row_merge_pass_t*	pass = thr->pass;
+	const merge_file_t*	file = pass->file;
+	const dict_index_t*	index = pass->dup->index;
+	const ulint		first = g * pass->fan_in;
+	const ulint		n = std::min(pass->fan_in, pass->n_run - first);
+	const ulint		end = first + n < pass->n_run
+		? pass->run_offset[first + n] : file->offset;
+	const ulint		space = pass->space;
+	row_merge_block_t*	block[ROW_MERGE_MAX_FAN_IN + 1];
+	row_merge_block_t*	crypt_block[ROW_MERGE_MAX_FAN_IN + 1];
+	ulint			foffs[ROW_MERGE_MAX_FAN_IN];
+	const byte*		b[ROW_MERGE_MAX_FAN_IN];
+	const mrec_t*		mrec[ROW_MERGE_MAX_FAN_IN];
+	rec_offs**		offsets = thr->offsets;
+	/* min-heap of the runs that have not been exhausted */
+	ulint			h[ROW_MERGE_MAX_FAN_IN];
+	ulint			n_h = 0;
+	ulint			of_offset = pass->run_offset[first];
+	ulint			n_rec = 0;
+	ulint			dup0 = 0, dup1 = 0;
+
+	ut_ad(n);
+	ut_ad(n <= ROW_MERGE_MAX_FAN_IN);
+
+	for (ulint i = 0; i <= pass->fan_in; i++) {
+		block[i] = &thr->block[i * srv_sort_buf_size];
+		crypt_block[i] = thr->crypt_block
+			? &thr->crypt_block[i * srv_sort_buf_size] : NULL;
 	}
 
-	ut_ad(ihalf < file->offset);
-
-	of.fd = *tmpfd;
-	of.offset = 0;
-	of.n_rec = 0;
-
-#ifdef POSIX_FADV_SEQUENTIAL
-	/* The input file will be read sequentially, starting from the
-	beginning and the middle.  In Linux, the POSIX_FADV_SEQUENTIAL
-	affects the entire file.  Each block will be read exactly once. */
-	posix_fadvise(file->fd, 0, 0,
-		      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
-#endif /* POSIX_FADV_SEQUENTIAL */
-
-	/* Merge blocks to the output file. */
-	foffs0 = 0;
-	foffs1 = ihalf;
-
-	MEM_UNDEFINED(run_offset, *num_run * sizeof *run_offset);
+	row_merge_block_t* const out = block[pass->fan_in];
+	row_merge_block_t* const crypt_out = crypt_block[pass->fan_in];
+	byte*			b2 = out;
 
-	for (; foffs0 < ihalf && foffs1 < file->offset; foffs0++, foffs1++) {
+	/* Compare the current records of two runs.
+	0 means that the records are duplicates. */
+	auto cmp = [&](ulint i, ulint j) {
+		return cmp_rec_rec_simple(mrec[i], mrec[j],
+					  offsets[i], offsets[j],
+					  index, NULL);
+	};
 
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
+	/* Restore the heap property from h[i] downwards. */
+	auto sift_down = [&](ulint i) {
+		for (;;) {
+			ulint c = 2 * i + 1;
+			if (c >= n_h) {
+				return true;
+			}
+			if (c + 1 < n_h) {
+				int r = cmp(h[c + 1], h[c]);
+				if (!r) {
+					dup0 = h[c + 1];
+					dup1 = h[c];
+					return false;
+				}
+				if (r < 0) {
+					c++;
+				}
+			}
+			int r = cmp(h[i], h[c]);
+			if (!r) {
+				dup0 = h[i];
+				dup1 = h[c];
+				return false;
+			}
+			if (r < 0) {
+				return true;
+			}
+			std::swap(h[i], h[c]);
+			i = c;
 		}
+	};
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+	DBUG_LOG("ib_merge_sort",
+		 "fd=" << file->fd << ',' << of_offset << '+' << n
+		 << " to fd=" << pass->out_fd << ',' << of_offset);
 
-		error = row_merge_blocks(dup, file, block,
-					 &foffs0, &foffs1, &of, stage,
-					 crypt_block, space);
+	for (ulint i = 0; i < n; i++) {
+		foffs[i] = pass->run_offset[first + i];
 
-		if (error != DB_SUCCESS) {
-			return(error);
+		if (!row_merge_read(file->fd, foffs[i], block[i],
+				    crypt_block[i], space)) {
+			return DB_CORRUPTION;
 		}
 
-	}
-
-	/* Copy the last blocks, if there are any. */
-
-	while (foffs0 < ihalf) {
-
-		if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
-			return(DB_INTERRUPTED);
+		b[i] = row_merge_read_rec(block[i], &thr->buf[i], block[i],
+					  index, file->fd, &foffs[i],
+					  &mrec[i], offsets[i],
+					  crypt_block[i], space);
+		if (b[i]) {
+			h[n_h++] = i;
+		} else if (mrec[i]) {
+			return DB_CORRUPTION;
 		}
+	}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs0, &of, stage,
-					   crypt_block, space)) {
-			return(DB_CORRUPTION);
+	for (ulint i = n_h / 2; i--; ) {
+		if (!sift_down(i)) {
+			goto duplicate;
 		}
 	}
 
-	ut_ad(foffs0 == ihalf);
-
-	while (foffs1 < file->offset) {
+	while (n_h) {
+		const ulint top = h[0];
+
+		/* The next record to be written is the smaller child of
+		the top. Check if it is a duplicate of the top record. */
+		if (n_h > 1) {
+			ulint c = 1;
+			if (n_h > 2) {
+				int r = cmp(h[1], h[2]);
+				if (!r) {
+					dup0 = h[1];
+					dup1 = h[2];
+					goto duplicate;
+				}
+				if (r > 0) {
+					c = 2;
+				}
+			}
+			if (!cmp(top, h[c])) {
+				dup0 = top;
+				dup1 = h[c];
+				goto duplicate;
+			}
+		}
 
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
+		b2 = row_merge_write_rec(out, &thr->buf[pass->fan_in], b2,
+					 pass->out_fd, &of_offset,
+					 mrec[top], offsets[top],
+					 crypt_out, space);
+		if (UNIV_UNLIKELY(!b2 || ++n_rec > file->n_rec
+				  || of_offset >= end)) {
+			return DB_CORRUPTION;
 		}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+		b[top] = row_merge_read_rec(block[top], &thr->buf[top],
+					    b[top], index, file->fd,
+					    &foffs[top], &mrec[top],
+					    offsets[top], crypt_block[top],
+					    space);
+		if (!b[top]) {
+			if (mrec[top]) {
+				return DB_CORRUPTION;
+			}
+			h[0] = h[--n_h];
+		}
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs1, &of, stage,
-					   crypt_block, space)) {
-			return(DB_CORRUPTION);
+		if (!sift_down(0)) {
+			goto duplicate;
 		}
 	}
 
-	ut_ad(foffs1 == file->offset);
-
-	if (UNIV_UNLIKELY(of.n_rec != file->n_rec)) {
-		return(DB_CORRUPTION);
+	if (!row_merge_write_eof(out, b2, pass->out_fd, &of_offset,
+				 crypt_out, space)) {
+		return DB_CORRUPTION;
 	}
 
-	ut_ad(n_run <= *num_run);
+	ut_ad(of_offset <= end);
 
-	*num_run = n_run;
-
-	/* Each run can contain one or more offsets. As merge goes on,
-	the number of runs (to merge) will reduce until we have one
-	single run. So the number of runs will always be smaller than
-	the number of offsets in file */
-	ut_ad((*num_run) <= file->offset);
-
-	/* The number of offsets in output file is always equal or
-	smaller than input file */
-	ut_ad(of.offset <= file->offset);
+	pass->mutex.wr_lock();
+	pass->n_rec += n_rec;
+	if (first + n == pass->n_run) {
+		pass->end_offset = of_offset;
+	}
+	if (pass->stage) {
+		pass->stage->inc(n_rec);
+	}
+	pass->mutex.wr_unlock();
+
+	return DB_SUCCESS;
+
+duplicate:
+	pass->mutex.wr_lock();
+	if (pass->err == DB_SUCCESS) {
+		pass->err = DB_DUPLICATE_KEY;
+		if (pass->dup->table) {
+			/* Report the erroneous row. */
+			std::ignore = cmp_rec_rec_simple(
+				mrec[dup0], mrec[dup1],
+				offsets[dup0], offsets[dup1],
+				index, pass->dup->table);
+		}
+	}
+	pass->mutex.wr_unlock();
+	return DB_DUPLICATE_KEY;
+}
 
-	/* Swap file descriptors for the next pass. */
-	*tmpfd = file->fd;
-	*file = of;
+/** Merge groups of runs until none are left in a row_merge_sort() pass.
+@param arg	merge thread */
+static void row_merge_pass_thread(void *arg)
+{
+	row_merge_pass_thread_t*	thr
+		= static_cast<row_merge_pass_thread_t*>(arg);
+	row_merge_pass_t*		pass = thr->pass;
+	const ulint			n_group
+		= (pass->n_run + pass->fan_in - 1) / pass->fan_in;
 
-	MEM_UNDEFINED(&block[0], 3 * srv_sort_buf_size);
+	for (ulint g; (g = pass->next_group++) < n_group; ) {
+		dberr_t	err = trx_is_interrupted(pass->trx)
+			? DB_INTERRUPTED
+			: row_merge_group(thr, g);
 
-	return(DB_SUCCESS);
+		if (err != DB_SUCCESS) {
+			pass->mutex.wr_lock();
+			if (pass->err == DB_SUCCESS) {
+				pass->err = err;
+			}
+			pass->mutex.wr_unlock();
+			return;
+		}
+	}
 }
 
 /** Merge disk files.
@@ -3491,7 +4047,6 @@ row_merge_sort(
 	ulint			space,	   /*!< in: space id */
 	ut_stage_alter_t* 	stage)
 {
-	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
 	ulint*		run_offset;
 	dberr_t		error	= DB_SUCCESS;
@@ -3504,8 +4059,21 @@ row_merge_sort(
 	/* Record the number of merge runs we need to perform */
 	num_runs = file->offset;
 
+	/* Each thread needs fan_in + 1 buffers. Merge up to
+	ROW_MERGE_MAX_FAN_IN runs at a time, as long as the buffers of
+	one thread fit in ROW_MERGE_SORT_BUF_BUDGET, but at least 2 runs
+	in the 3 buffers that were provided by the caller. */
+	const ulint	budget_blocks = ROW_MERGE_SORT_BUF_BUDGET
+		/ srv_sort_buf_size;
+	ulint	fan_in = std::min(
+		std::min(ROW_MERGE_MAX_FAN_IN, std::max<ulint>(num_runs, 2)),
+		std::max<ulint>(budget_blocks, 3) - 1);
+
 	if (stage != NULL) {
-		stage->begin_phase_sort(log2(double(num_runs)));
+		stage->begin_phase_sort(num_runs > 1
+					? log2(double(num_runs))
+					/ log2(double(fan_in))
+					: 0);
 	}
 
 	/* If num_runs are less than 1, nothing to merge */
@@ -3513,14 +4081,16 @@ row_merge_sort(
 		DBUG_RETURN(error);
 	}
 
-	total_merge_sort_count = ulint(ceil(log2(double(num_runs))));
+	total_merge_sort_count = ulint(ceil(log2(double(num_runs))
+					    / log2(double(fan_in))));
 
-	/* "run_offset" records each run's first offset number */
+	/* "run_offset" records each run's first offset number.
+	Initially, each block is a run. */
 	run_offset = (ulint*) ut_malloc_nokey(file->offset * sizeof(ulint));
 
-	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+	for (ulint i = 0; i < num_runs; i++) {
+		run_offset[i] = i;
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -3532,11 +4102,107 @@ row_merge_sort(
 				      num_runs);
 	}
 
+	/* The buffers of all threads together must fit in
+	ROW_MERGE_SORT_BUF_BUDGET. A thread that merges 2 runs at a time
+	in the buffers of the caller does not count. */
+	row_merge_pass_t	pass;
+	const ulint		max_threads = std::max<ulint>(
+		std::min<ulint>(std::min<ulint>(
+					srv_ddl_threads,
+					(num_runs + fan_in - 1) / fan_in),
+				budget_blocks / (fan_in + 1)), 1);
+	std::vector<row_merge_pass_thread_t>	threads;
+	const size_t		block_size = (fan_in + 1) * srv_sort_buf_size;
+
+	pass.trx = trx;
+	pass.dup = dup;
+	pass.file = file;
+	pass.space = space;
+	pass.stage = stage;
+	pass.mutex.init();
+
+	/* Allocate the buffers of the threads. If the first thread
+	merges only 2 runs at a time, it uses the buffers of the caller. */
+	for (ulint t = 0; t < max_threads; t++) {
+		row_merge_pass_thread_t	thr = {&pass, nullptr, nullptr,
+					       nullptr, nullptr, {}};
+
+		if (!t && fan_in == 2) {
+			thr.block = block;
+			thr.crypt_block = crypt_block;
+		} else {
+			thr.block = static_cast<row_merge_block_t*>(
+				aligned_malloc(block_size, 1024));
+			if (thr.block && crypt_block) {
+				thr.crypt_block
+					= static_cast<row_merge_block_t*>(
+						aligned_malloc(block_size,
+							       1024));
+				if (!thr.crypt_block) {
+					aligned_free(thr.block);
+					thr.block = nullptr;
+				}
+			}
+
+			if (!thr.block) {
+				if (t) {
+					break;
+				}
+				/* Merge 2 runs at a time in one thread. */
+				fan_in = 2;
+				thr.block = block;
+				thr.crypt_block = crypt_block;
+			}
+		}
+
+		thr.heap = row_merge_heap_create(dup->index, fan_in,
+						 &thr.buf, thr.offsets);
+		threads.push_back(thr);
+	}
+
 	/* Merge the runs until we have one big run */
 	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage,
-				  crypt_block, space);
+		const ulint	n_group = (num_runs + fan_in - 1) / fan_in;
+		const ulint	n_threads = std::min(n_group, threads.size());
+		std::vector<std::unique_ptr<tpool::waitable_task>>	tasks;
+
+		pass.out_fd = *tmpfd;
+		pass.n_run = num_runs;
+		pass.run_offset = run_offset;
+		pass.fan_in = fan_in;
+		pass.next_group = 0;
+		pass.n_rec = 0;
+		pass.end_offset = 0;
+		pass.err = DB_SUCCESS;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+		/* The runs of the input file will be read sequentially.
+		In Linux, the POSIX_FADV_SEQUENTIAL affects the entire
+		file.  Each block will be read exactly once. */
+		posix_fadvise(file->fd, 0, 0,
+			      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
+#endif /* POSIX_FADV_SEQUENTIAL */
+
+		for (ulint t = 1; t < n_threads; t++) {
+			tasks.emplace_back(new tpool::waitable_task(
+						   row_merge_pass_thread,
+						   &threads[t]));
+			srv_thread_pool->submit_task(tasks.back().get());
+		}
+
+		row_merge_pass_thread(&threads[0]);
+
+		tpool::tpool_wait_begin();
+		for (auto& task : tasks) {
+			task->wait();
+		}
+		tpool::tpool_wait_end();
+
+		error = pass.err;
+
+		if (error == DB_SUCCESS && pass.n_rec != file->n_rec) {
+			error = DB_CORRUPTION;
+		}
 
 		if(update_progress) {
 			merge_count++;
@@ -3552,9 +4218,31 @@ row_merge_sort(
 			break;
 		}
 
+		/* Each group became one run. */
+		for (ulint g = 0; g < n_group; g++) {
+			run_offset[g] = run_offset[g * fan_in];
+		}
+
+		num_runs = n_group;
+
+		/* Swap file descriptors for the next pass. */
+		*tmpfd = file->fd;
+		file->fd = pass.out_fd;
+		ut_ad(pass.end_offset <= file->offset);
+		file->offset = pass.end_offset;
+
 		MEM_CHECK_DEFINED(run_offset, num_runs * sizeof *run_offset);
 	} while (num_runs > 1);
 
+	for (ulint t = 0; t < threads.size(); t++) {
+		mem_heap_free(threads[t].heap);
+		if (threads[t].block != block) {
+			aligned_free(threads[t].block);
+			aligned_free(threads[t].crypt_block);
+		}
+	}
+
+	pass.mutex.destroy();
 	ut_free(run_offset);
 
 	DBUG_RETURN(error);
@@ -6206,6 +6206,585 @@ static dberr_t row_check_index_match(row_prebuilt_t *prebuilt,
   return DB_SUCCESS;
 }
 
+/** State of row_parallel_read() */
+struct row_parallel_read_t
+{
+  /** transaction whose read view is used */
+  trx_t *trx;
+  /** clustered index */
+  dict_index_t *index;
+  /** whether the latest versions of the records are to be read */
+  bool dirty;
+  /** function to invoke on each record, or nullptr */
+  row_parallel_read_callback callback;
+  /** function to invoke on a corrupted record, or nullptr */
+  row_parallel_read_corrupted corrupted;
+  /** argument of callback and corrupted */
+  void *arg;
+  /** boundaries of the ranges; range r covers the keys
+  from bounds[r - 1] (inclusive) to bounds[r] (exclusive) */
+  std::vector<const dtuple_t*> bounds;
+  /** if corrupted is set, the first leaf page of each range;
+  range r ends before the page leaves[r + 1] */
+  std::vector<uint32_t> leaves;
+  /** the next range to read */
+  Atomic_counter<ulint> next_range;
+  /** the first error that was encountered */
+  Atomic_relaxed<dberr_t> err;
+  /** mutex protecting n_rows */
+  srw_mutex mutex;
+  /** number of records that were read */
+  ulint n_rows;
+};
+
+/** A thread of row_parallel_read() */
+struct row_parallel_read_thread_t
+{
+  /** the read */
+  row_parallel_read_t *read;
+  /** thread number */
+  ulint thread;
+};
+
+/** Read a range of the clustered index in row_parallel_read().
+@param read    parallel read
+@param thread  thread number
+@param r       range number
+@param heap    memory heap for record versions
+@param n_rows  number of records that were read
+@return error code */
+static dberr_t row_parallel_read_range(row_parallel_read_t *read,
+                                       ulint thread, ulint r,
+                                       mem_heap_t *heap, ulint *n_rows)
+{
+  dict_index_t *const index= read->index;
+  const bool by_page= !read->leaves.empty();
+  const dtuple_t *hi= !by_page && r < read->bounds.size()
+    ? read->bounds[r] : nullptr;
+  const uint32_t end_page= by_page && r + 1 < read->leaves.size()
+    ? read->leaves[r + 1] : FIL_NULL;
+  const bool comp= index->table->not_redundant();
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs_init(offsets_);
+  btr_pcur_t pcur;
+  mtr_t mtr;
+  dberr_t err;
+  bool first= true;
+  char msg[80];
+
+  mtr.start();
+
+  if (by_page)
+  {
+    /* Start at the first leaf page of the range. The caller prevents
+    changes to the structure of the tree. */
+    if (buf_block_t *block= btr_block_get(*index, read->leaves[r],
+                                          RW_S_LATCH, &mtr, &err))
+    {
+      pcur.btr_cur.page_cur.index= index;
+      pcur.latch_mode= BTR_SEARCH_LEAF;
+      pcur.search_mode= PAGE_CUR_G;
+      pcur.pos_state= BTR_PCUR_IS_POSITIONED;
+      pcur.old_rec= nullptr;
+      page_cur_set_before_first(block, btr_pcur_get_page_cur(&pcur));
+      if (!page_is_leaf(block->page.frame))
+        err= DB_CORRUPTION;
+    }
+  }
+  else if (r)
+  {
+    /* Position on the last record before the range. */
+    pcur.btr_cur.page_cur.index= index;
+    err= btr_pcur_open(read->bounds[r - 1], PAGE_CUR_L, BTR_SEARCH_LEAF,
+                       &pcur, &mtr);
+  }
+  else
+    err= pcur.open_leaf(true, index, BTR_SEARCH_LEAF, &mtr);
+
+  while (err == DB_SUCCESS)
+  {
+    if (!btr_pcur_move_to_next_on_page(&pcur))
+    {
+      err= DB_CORRUPTION;
+      break;
+    }
+
+    if (btr_pcur_is_after_last_on_page(&pcur))
+    {
+      if (btr_page_get_next(btr_pcur_get_page(&pcur)) == end_page)
+        /* The next page belongs to the next range, or this was
+        the last page. */
+        break;
+      if (btr_pcur_is_after_last_in_tree(&pcur))
+      {
+        /* The leaf pages of this range do not end where the next range
+        starts. The records of the next ranges were read twice. */
+        snprintf(msg, sizeof msg, "the leaf page list does not reach"
+                 " page %" PRIu32, end_page);
+        if (!read->corrupted)
+          err= DB_CORRUPTION;
+        else
+          read->corrupted(read->arg, thread, r, DB_CORRUPTION, msg);
+        break;
+      }
+      if (UNIV_UNLIKELY(trx_is_interrupted(read->trx)))
+        err= DB_INTERRUPTED;
+      else if (read->err != DB_SUCCESS)
+        /* Another thread failed; give up. */
+        break;
+      else
+        err= btr_pcur_move_to_next_page(&pcur, &mtr);
+      continue;
+    }
+
+    mem_heap_empty(heap);
+
+    const rec_t *rec= btr_pcur_get_rec(&pcur);
+    rec_offs *offsets= rec_get_offsets(rec, index, offsets_,
+                                       index->n_core_fields,
+                                       ULINT_UNDEFINED, &heap);
+
+    if (hi && cmp_dtuple_rec(hi, rec, index, offsets) <= 0)
+      /* The rest belongs to the next range. */
+      break;
+
+    if (UNIV_UNLIKELY(rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG))
+    {
+      /* Skip the metadata pseudo-record of instant ALTER TABLE. */
+      if (!r && first && index->is_instant())
+      {
+        first= false;
+        continue;
+      }
+      if (!read->corrupted)
+      {
+        err= DB_CORRUPTION;
+        break;
+      }
+      read->corrupted(read->arg, thread, r, DB_INDEX_CORRUPT,
+                      "invalid record encountered");
+      first= false;
+      continue;
+    }
+
+    first= false;
+
+    if (!read->dirty)
+    {
+      const trx_id_t rec_trx_id= row_get_rec_trx_id(rec, index, offsets);
+
+      if (!read->trx->read_view.changes_visible(rec_trx_id))
+      {
+        if (rec_trx_id >= read->trx->read_view.low_limit_id() &&
+            UNIV_UNLIKELY(rec_trx_id >= trx_sys.get_max_trx_id()))
+        {
+          snprintf(msg, sizeof msg, "DB_TRX_ID=" TRX_ID_FMT
+                   " exceeds the system-wide maximum", rec_trx_id);
+          if (!read->corrupted)
+          {
+            ib::error() << msg << " in index " << index->name
+                        << " of table " << index->table->name;
+            err= DB_CORRUPTION;
+            break;
+          }
+          read->corrupted(read->arg, thread, r, DB_CORRUPTION, msg);
+          continue;
+        }
+
+        rec_t *old_vers;
+        err= row_vers_build_for_consistent_read(rec, &mtr, index, &offsets,
+                                                &read->trx->read_view,
+                                                &heap, heap, &old_vers,
+                                                nullptr);
+        if (err != DB_SUCCESS)
+          break;
+        if (!old_vers)
+          /* The record did not exist in the read view. */
+          continue;
+        rec= old_vers;
+      }
+    }
+
+    if (rec_get_deleted_flag(rec, comp))
+      continue;
+
+    ++*n_rows;
+
+    if (read->callback)
+      err= read->callback(read->arg, thread, r, rec, offsets);
+  }
+
+  mtr.commit();
+  ut_free(pcur.old_rec_buf);
+  return err;
+}
+
+/** Read clustered index ranges in row_parallel_read()
+until none are left.
+@param arg  thread of the read */
+static void row_parallel_read_thread(void *arg)
+{
+  row_parallel_read_thread_t *thr=
+    static_cast<row_parallel_read_thread_t*>(arg);
+  row_parallel_read_t *read= thr->read;
+  mem_heap_t *heap= mem_heap_create(srv_page_size / 4);
+  ulint n_rows= 0;
+
+  for (ulint r; read->err == DB_SUCCESS &&
+         (r= read->next_range++) <= read->bounds.size(); )
+  {
+    if (dberr_t err=
+        row_parallel_read_range(read, thr->thread, r, heap, &n_rows))
+    {
+      read->mutex.wr_lock();
+      if (read->err == DB_SUCCESS)
+        read->err= err;
+      read->mutex.wr_unlock();
+    }
+  }
+
+  mem_heap_free(heap);
+
+  read->mutex.wr_lock();
+  read->n_rows+= n_rows;
+  read->mutex.wr_unlock();
+}
+
+dberr_t row_parallel_read(trx_t *trx, dict_index_t *index, ulint n_threads,
+                          row_parallel_read_callback callback,
+                          row_parallel_read_corrupted corrupted, void *arg,
+                          ulint *n_rows)
+{
+  ut_ad(index->is_primary());
+  ut_ad(!index->table->is_temporary());
+  ut_ad(n_threads);
+
+  *n_rows= 0;
+
+  const bool dirty= trx->isolation_level == TRX_ISO_READ_UNCOMMITTED;
+  ut_ad(dirty || trx->read_view.is_open());
+
+  if (const trx_id_t bulk_trx_id= index->table->bulk_trx_id)
+    if (!dirty && !trx->read_view.changes_visible(bulk_trx_id))
+      /* The table was empty in the read view. */
+      return DB_SUCCESS;
+
+  row_parallel_read_t read;
+  mem_heap_t *heap= mem_heap_create(1024);
+  mtr_t mtr;
+
+  if (corrupted)
+  {
+    /* Block page splits and merges until all ranges have been read,
+    like btr_validate_index() does, so that the ranges can be divided
+    at leaf pages. Readers that only latch pages can proceed. */
+    mtr.start();
+    mtr_sx_lock_index(index, &mtr);
+  }
+
+  /* Assume at least 8 times as many ranges as threads, so
+  that the work will be evenly distributed. */
+  read.err= btr_split_key_ranges(index, n_threads * 8, heap, read.bounds,
+                                 corrupted ? &read.leaves : nullptr);
+
+  if (read.err == DB_SUCCESS)
+  {
+    ut_ad(!corrupted || read.leaves.size() == read.bounds.size() + 1);
+    read.trx= trx;
+    read.index= index;
+    read.dirty= dirty;
+    read.callback= callback;
+    read.corrupted= corrupted;
+    read.arg= arg;
+    read.next_range= 0;
+    read.n_rows= 0;
+    read.mutex.init();
+
+    n_threads= std::min<ulint>(n_threads, read.bounds.size() + 1);
+    std::vector<row_parallel_read_thread_t> threads(n_threads);
+    std::vector<std::unique_ptr<tpool::waitable_task>> tasks;
+
+    for (ulint t= 0; t < n_threads; t++)
+    {
+      threads[t]= {&read, t};
+      if (t)
+      {
+        tasks.emplace_back(new tpool::waitable_task(row_parallel_read_thread,
+                                                    &threads[t]));
+        srv_thread_pool->submit_task(tasks.back().get());
+      }
+    }
+
+    row_parallel_read_thread(&threads[0]);
+
+    tpool::tpool_wait_begin();
+    for (auto &task : tasks)
+      task->wait();
+    tpool::tpool_wait_end();
+
+    read.mutex.destroy();
+    *n_rows= read.n_rows;
+  }
+
+  if (corrupted)
+    mtr.commit();
+
+  mem_heap_free(heap);
+  return read.err;
+}
+
+/** State of row_check_index_parallel() */
+struct row_check_parallel_t
+{
+  /** The first and last record of a range */
+  struct range_t
+  {
+    /** range number */
+    ulint range;
+    /** copy of the first record */
+    const rec_t *first;
+    /** rec_get_offsets(first) */
+    rec_offs *first_offsets;
+    /** the unique key of the last record */
+    dtuple_t *last;
+  };
+
+  /** A thread of the check */
+  struct thread_t
+  {
+    /** the range that is being read */
+    ulint range;
+    /** the unique key of the previous record of the range, or nullptr */
+    dtuple_t *prev_entry;
+    /** memory heaps for prev_entry */
+    mem_heap_t *heap[2];
+    /** memory heap for ranges */
+    mem_heap_t *ranges_heap;
+    /** the ranges that were read, in ascending order */
+    std::vector<range_t> ranges;
+    /** the first non-fatal error that was found */
+    dberr_t err;
+    /** the range where err was found */
+    ulint err_range;
+    /** the message for err */
+    std::string msg;
+  };
+
+  /** clustered index */
+  dict_index_t *index;
+  /** the threads */
+  std::vector<thread_t> threads;
+};
+
+/** Note a non-fatal error in row_check_index_parallel().
+@param check   parallel check
+@param thread  thread number
+@param range   range number
+@param err     error code
+@param msg     error message */
+static void row_check_index_error(row_check_parallel_t *check, ulint thread,
+                                  ulint range, dberr_t err, const char *msg)
+{
+  row_check_parallel_t::thread_t &thr= check->threads[thread];
+  if (thr.err == DB_SUCCESS || range < thr.err_range)
+  {
+    thr.err= err;
+    thr.err_range= range;
+    thr.msg= msg;
+  }
+}
+
+/** Report a corrupted clustered index record in
+row_check_index_parallel().
+@param arg     row_check_parallel_t
+@param thread  thread number
+@param range   range number
+@param err     error code
+@param msg     description of the corruption */
+static void row_check_index_corrupted(void *arg, ulint thread, ulint range,
+                                      dberr_t err, const char *msg)
+{
+  row_check_parallel_t *check= static_cast<row_check_parallel_t*>(arg);
+  ib::error() << msg << " in index " << check->index->name << " of table "
+              << check->index->table->name;
+  row_check_index_error(check, thread, range, err, msg);
+}
+
+/** Compare a record with the unique key of the preceding record
+in row_check_index_parallel().
+@param check     parallel check
+@param thread    thread number
+@param range     range number of rec
+@param prev      the unique key of the preceding record
+@param rec       clustered index record
+@param offsets   rec_get_offsets(rec) */
+static void row_check_index_pair(row_check_parallel_t *check, ulint thread,
+                                 ulint range, const dtuple_t *prev,
+                                 const rec_t *rec, const rec_offs *offsets)
+{
+  uint16_t matched= 0;
+  int cmp= cmp_dtuple_rec_with_match(prev, rec, check->index, offsets,
+                                     &matched);
+  if (UNIV_LIKELY(cmp < 0))
+    return;
+  const char *msg= cmp > 0
+    ? "index records in a wrong order" : "duplicate key";
+  ib::error() << msg << " in " << check->index->name << " of table "
+              << check->index->table->name << ": " << *prev << ", "
+              << rec_offsets_print(rec, offsets);
+  row_check_index_error(check, thread, range,
+                        cmp > 0 ? DB_INDEX_CORRUPT : DB_DUPLICATE_KEY, msg);
+}
+
+/** Copy the unique key of a record in row_check_index_parallel().
+@param index  clustered index
+@param rec    clustered index record
+@param heap   memory heap
+@return the unique key */
+static dtuple_t *row_check_index_key(dict_index_t *index, const rec_t *rec,
+                                     mem_heap_t *heap)
+{
+  const ulint n_uniq= dict_index_get_n_unique(index);
+  dtuple_t *entry= dtuple_create(heap, n_uniq);
+  dict_index_copy_types(entry, index, n_uniq);
+  rec_copy_prefix_to_dtuple(entry, rec, index, index->n_core_fields,
+                            n_uniq, heap);
+  return entry;
+}
+
+/** Finish the current range of a thread in row_check_index_parallel().
+@param thr  thread of the check */
+static void row_check_index_end_range(row_check_parallel_t::thread_t &thr)
+{
+  if (!thr.prev_entry)
+    return;
+  dtuple_t *last= dtuple_copy(thr.prev_entry, thr.ranges_heap);
+  for (ulint i= 0; i < dtuple_get_n_fields(last); i++)
+    dfield_dup(dtuple_get_nth_field(last, i), thr.ranges_heap);
+  thr.ranges.back().last= last;
+  thr.prev_entry= nullptr;
+}
+
+/** Check the order of the clustered index records in
+row_check_index_parallel(). Each record must be greater than
+the previous one in the same range. The first and last records
+of each range are remembered for comparing them with the
+adjacent ranges.
+@param arg      row_check_parallel_t
+@param thread   thread number
+@param range    range number
+@param rec      clustered index record
+@param offsets  rec_get_offsets(rec)
+@return DB_SUCCESS */
+static dberr_t row_check_index_order(void *arg, ulint thread, ulint range,
+                                     const rec_t *rec, const rec_offs *offsets)
+{
+  row_check_parallel_t *check= static_cast<row_check_parallel_t*>(arg);
+  row_check_parallel_t::thread_t &thr= check->threads[thread];
+  dict_index_t *const index= check->index;
+
+  if (thr.range != range)
+  {
+    row_check_index_end_range(thr);
+    thr.range= range;
+    rec_offs *first_offsets= static_cast<rec_offs*>(
+      mem_heap_dup(thr.ranges_heap, offsets,
+                   rec_offs_get_n_alloc(offsets) * sizeof *offsets));
+    const rec_t *first= rec_copy(mem_heap_alloc(thr.ranges_heap,
+                                                rec_offs_size(offsets)),
+                                 rec, offsets);
+    rec_offs_make_valid(first, index, true, first_offsets);
+    thr.ranges.push_back({range, first, first_offsets, nullptr});
+  }
+  else if (thr.prev_entry)
+    row_check_index_pair(check, thread, range, thr.prev_entry, rec, offsets);
+
+  std::swap(thr.heap[0], thr.heap[1]);
+  mem_heap_empty(thr.heap[0]);
+  thr.prev_entry= row_check_index_key(index, rec, thr.heap[0]);
+  return DB_SUCCESS;
+}
+
+/** Check the clustered index records in CHECK TABLE in
+innodb_parallel_read_threads threads.
+@param prebuilt    clustered index and transaction
+@param n_rows      number of records counted
+@return error code */
+static dberr_t row_check_index_parallel(row_prebuilt_t *prebuilt,
+                                        ulint *n_rows)
+{
+  const ulint n_threads= srv_parallel_read_threads;
+  row_check_parallel_t check;
+  check.index= prebuilt->index;
+  check.threads.resize(n_threads);
+  for (auto &thr : check.threads)
+  {
+    thr.range= ULINT_UNDEFINED;
+    thr.prev_entry= nullptr;
+    thr.heap[0]= mem_heap_create(256);
+    thr.heap[1]= mem_heap_create(256);
+    thr.ranges_heap= mem_heap_create(1024);
+    thr.err= DB_SUCCESS;
+    thr.err_range= ULINT_UNDEFINED;
+  }
+
+  dberr_t err= row_parallel_read(prebuilt->trx, prebuilt->index, n_threads,
+                                 row_check_index_order,
+                                 row_check_index_corrupted, &check, n_rows);
+
+  if (err == DB_SUCCESS)
+  {
+    /* Compare the last record of each range with the first record
+    of the next range that contains any records. */
+    std::vector<const row_check_parallel_t::range_t*> ranges;
+    for (auto &thr : check.threads)
+    {
+      row_check_index_end_range(thr);
+      for (const auto &range : thr.ranges)
+        ranges.push_back(&range);
+    }
+    std::sort(ranges.begin(), ranges.end(),
+              [](const row_check_parallel_t::range_t *a,
+                 const row_check_parallel_t::range_t *b)
+              { return a->range < b->range; });
+    for (size_t i= 1; i < ranges.size(); i++)
+    {
+      const dtuple_t *last= ranges[i - 1]->last;
+      DBUG_EXECUTE_IF("row_check_index_boundary_dup",
+                      last= row_check_index_key(check.index,
+                                                ranges[i]->first,
+                                                check.threads[0].heap[0]););
+      row_check_index_pair(&check, 0, ranges[i]->range, last,
+                           ranges[i]->first, ranges[i]->first_offsets);
+    }
+  }
+
+  /* Report the first error in the order of the index, like the
+  single-threaded check would. */
+  const row_check_parallel_t::thread_t *first= nullptr;
+  for (const auto &thr : check.threads)
+    if (thr.err != DB_SUCCESS && (!first || thr.err_range < first->err_range))
+      first= &thr;
+
+  if (first)
+  {
+    push_warning_printf(prebuilt->trx->mysql_thd,
+                        Sql_condition::WARN_LEVEL_WARN, ER_NOT_KEYFILE,
+                        "InnoDB: %s", first->msg.c_str());
+    if (prebuilt->autoinc_error == DB_SUCCESS)
+      prebuilt->autoinc_error= first->err;
+  }
+
+  for (auto &thr : check.threads)
+  {
+    mem_heap_free(thr.heap[0]);
+    mem_heap_free(thr.heap[1]);
+    mem_heap_free(thr.ranges_heap);
+  }
+
+  return err;
+}
+
 /**
 Check the index records in CHECK TABLE.
 The index must contain entries in an ascending order,
@@ -6229,6 +6808,11 @@ dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   if (!index->is_btree())
     return DB_CORRUPTION;
 
+  if (srv_parallel_read_threads > 1 && index->is_primary() &&
+      !prebuilt->need_to_access_clustered &&
+      !prebuilt->table->is_temporary())
+    return row_check_index_parallel(prebuilt, n_rows);
+
   mem_heap_t *heap= mem_heap_create(100);
 
   dtuple_t *prev_entry= nullptr;
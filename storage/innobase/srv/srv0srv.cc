@@ -127,6 +127,10 @@ bool high_level_read_only;
 
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** Number of threads that read the clustered index in index creation */
+ulong	srv_ddl_threads;
+/** Number of threads that read an index in COUNT(*) and CHECK TABLE */
+ulong	srv_parallel_read_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -136,6 +140,10 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
 my_bool	srv_numa_interleave;
+#ifdef HAVE_URING
+my_bool	srv_io_uring_sqpoll;
+my_bool	srv_io_uring_fixed_buffers;
+#endif
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
 /** innodb_compression_algorithm; used with page compression */
@@ -188,6 +196,8 @@ ulint	srv_buf_pool_base_size;
 ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** innodb_buffer_pool_dump_format; @see buf_dump_format_t */
+ulong	srv_buf_dump_format;
 /** Abort load after this amount of pages */
 #ifdef UNIV_DEBUG
 ulong srv_buf_pool_load_pages_abort = LONG_MAX;
@@ -1208,12 +1208,83 @@ dict_table_t *purge_sys_t::close_and_reopen(table_id_t id, THD *thd,
   return table;
 }
 
+/** A table and a subset of its undo log records in a purge batch */
+typedef std::pair<table_id_t, ulint> purge_shard_t;
+
+/** Hash function of purge_shard_t */
+struct purge_shard_hash
+{
+  size_t operator()(const purge_shard_t &shard) const noexcept
+  { return size_t(ut_fold_ull(shard.first)) * 31 + shard.second; }
+};
+
+/** Minimum number of undo log records of a table per purge task
+for splitting the records of the table among the purge tasks */
+static constexpr ulint TRX_PURGE_SHARD_MIN_RECS= 64;
+
+/** Determine the subset of the undo log records of a table that
+an undo log record belongs to, so that the records of a table that is
+being modified heavily can be processed by multiple purge tasks.
+All records that refer to the same clustered index record must be
+processed in order by the same task, which is why we distribute the
+records by a hash of the PRIMARY KEY (or DB_ROW_ID).
+@param undo_rec  undo log record
+@param n_uniq    number of unique fields in the clustered index
+@param n_shards  number of subsets
+@return the subset, between 0 and n_shards - 1 */
+static ulint trx_purge_rec_shard(const trx_undo_rec_t *undo_rec,
+                                 ulint n_uniq, ulint n_shards)
+{
+  ut_ad(n_shards > 1);
+  ut_ad(n_uniq);
+  byte type, cmpl_info, info_bits;
+  bool updated_extern;
+  undo_no_t undo_no;
+  table_id_t table_id;
+  trx_id_t trx_id;
+  roll_ptr_t roll_ptr;
+
+  const byte *ptr= trx_undo_rec_get_pars(undo_rec, &type, &cmpl_info,
+                                         &updated_extern, &undo_no,
+                                         &table_id);
+  switch (type) {
+  case TRX_UNDO_INSERT_REC:
+    break;
+  case TRX_UNDO_UPD_EXIST_REC:
+  case TRX_UNDO_UPD_DEL_REC:
+  case TRX_UNDO_DEL_MARK_REC:
+    ptr= trx_undo_update_rec_get_sys_cols(ptr, &trx_id, &roll_ptr,
+                                          &info_bits);
+    if (!(info_bits & REC_INFO_MIN_REC_FLAG))
+      break;
+    /* fall through */
+  default:
+    /* The metadata record or the table as a whole */
+    return 0;
+  }
+
+  uint32_t crc= 0;
+  for (ulint i= 0; i < n_uniq; i++)
+  {
+    const byte *field;
+    uint32_t len, orig_len;
+    ptr= trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+    if (len >= UNIV_EXTERN_STORAGE_FIELD)
+      return 0;
+    if (len != UNIV_SQL_NULL)
+      crc= my_crc32c(crc, field, len);
+  }
+  return crc % n_shards;
+}
+
 /** Run a purge batch.
-@param n_purge_threads	number of purge threads
 @param thd              purge coordinator thread handle
-@param n_work_items     number of work items (currently tables) to process
+@param n_tasks          number of purge tasks that will process the batch
+@param n_work_items     number of work items (tables, or subsets of
+                        the undo log records of tables) to process
 @return new purge_sys.head */
 static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
+                                                        ulint n_tasks,
                                                         ulint *n_work_items)
 {
   que_thr_t *thr;
@@ -1223,7 +1294,7 @@ static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
   to a per purge node vector. */
   thr= nullptr;
 
-  std::unordered_map<table_id_t, purge_node_t *>
+  std::unordered_map<purge_shard_t, purge_node_t *, purge_shard_hash>
     table_id_map(TRX_PURGE_TABLE_BUCKETS);
   purge_sys.m_active= true;
 
@@ -1234,6 +1305,20 @@ static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
   const size_t max_pages=
     std::min(buf_pool.curr_size * 3 / 4, size_t{srv_purge_batch_size});
 
+  /** The undo log records of a table in the batch */
+  struct purge_table_recs_t
+  {
+    /** number of undo log records */
+    ulint n_recs;
+    /** the subsets of the records that are not empty */
+    uint64_t shards;
+    /** the table, or nullptr if it was dropped */
+    dict_table_t *table;
+  };
+  std::unordered_map<table_id_t, purge_table_recs_t>
+    table_recs(TRX_PURGE_TABLE_BUCKETS);
+  std::vector<trx_purge_rec_t> recs;
+
   while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown)
   {
     /* Track the max {trx_id, undo_no} for truncating the
@@ -1253,40 +1338,83 @@ static purge_sys_t::iterator trx_purge_attach_undo_recs(THD *thd,
       continue;
     }
 
-    table_id_t table_id= trx_undo_rec_get_table_id(purge_rec.undo_rec);
+    recs.push_back(purge_rec);
+    table_recs[trx_undo_rec_get_table_id(purge_rec.undo_rec)].n_recs++;
 
-    purge_node_t *&table_node= table_id_map[table_id];
+    if (purge_sys.n_pages_handled() >= max_pages)
+      break;
+  }
+
+  /* Attach the records to purge nodes. Return the node for a subset
+  of the records of a table, and the table. */
+  auto attach= [&](table_id_t table_id, ulint shard, dict_table_t **table)
+  {
+    purge_node_t *&table_node= table_id_map[{table_id, shard}];
     if (table_node)
+    {
       ut_ad(!table_node->in_progress);
-    if (!table_node)
+      *table= table_node->tables[table_id].first;
+      return table_node;
+    }
+
+    if (!thr || !(thr= UT_LIST_GET_NEXT(thrs, thr)))
+      thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
+    ++*n_work_items;
+    table_node= static_cast<purge_node_t *>(thr->child);
+    ut_a(que_node_get_type(table_node) == QUE_NODE_PURGE);
+
+    /* If there are more work items than purge nodes, the node may
+    already have opened the table for another subset of the records. */
+    auto t= table_node->tables.find(table_id);
+    if (t != table_node->tables.end())
+      *table= t->second.first;
+    else
     {
       std::pair<dict_table_t *, MDL_ticket *> p;
       p.first= trx_purge_table_open(table_id, mdl_context, &p.second);
       if (p.first == reinterpret_cast<dict_table_t *>(-1))
         p.first= purge_sys.close_and_reopen(table_id, thd, &p.second);
+      table_node->tables.emplace(table_id, p);
+      *table= p.first;
+    }
+    return table_node;
+  };
 
-      if (!thr || !(thr= UT_LIST_GET_NEXT(thrs, thr)))
-        thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
-      ++*n_work_items;
-      table_node= static_cast<purge_node_t *>(thr->child);
-
-      ut_a(que_node_get_type(table_node) == QUE_NODE_PURGE);
-      ut_d(auto pair=) table_node->tables.emplace(table_id, p);
-      ut_ad(pair.second);
-      if (p.first)
-        goto enqueue;
+  for (const trx_purge_rec_t &purge_rec : recs)
+  {
+    const table_id_t table_id= trx_undo_rec_get_table_id(purge_rec.undo_rec);
+    purge_table_recs_t &tr= table_recs[table_id];
+    dict_table_t *table;
+    purge_node_t *table_node= attach(table_id, 0, &table);
+    ulint shard= 0;
+
+    /* Split the records of a table among the purge tasks only if
+    the table has more records than a task would get on average. */
+    if (table && n_tasks > 1 && tr.n_recs * n_tasks > recs.size() &&
+        tr.n_recs >= n_tasks * TRX_PURGE_SHARD_MIN_RECS)
+    {
+      shard= trx_purge_rec_shard(purge_rec.undo_rec,
+                                 dict_index_get_n_unique
+                                 (dict_table_get_first_index(table)),
+                                 n_tasks);
+      if (shard)
+        table_node= attach(table_id, shard, &table);
     }
-    else if (table_node->tables[table_id].first)
+
+    if (table)
     {
-    enqueue:
       table_node->undo_recs.push(purge_rec);
       ut_ad(!table_node->in_progress);
+      table->n_purged_recs+= 1;
+      tr.table= table;
+      tr.shards|= 1ULL << shard;
     }
-
-    if (purge_sys.n_pages_handled() >= max_pages)
-      break;
   }
 
+  for (const auto &t : table_recs)
+    if (t.second.shards & (t.second.shards - 1))
+      t.second.table->n_split_batches+= 1;
+
   purge_sys.m_active= false;
 
 #ifdef UNIV_DEBUG
@@ -1379,7 +1507,8 @@ TRANSACTIONAL_TARGET ulint trx_purge(ulint n_tasks, ulint history_size)
 
   /* Fetch the UNDO recs that need to be purged. */
   ulint n_work= 0;
-  const purge_sys_t::iterator head= trx_purge_attach_undo_recs(thd, &n_work);
+  const purge_sys_t::iterator head= trx_purge_attach_undo_recs(thd, n_tasks,
+                                                               &n_work);
   const size_t n_pages= purge_sys.n_pages_handled();
 
   {
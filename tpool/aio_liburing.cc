@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
 #include <pthread.h>
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <thread>
 #include <mutex>
@@ -34,9 +35,26 @@ namespace
 class aio_uring final : public tpool::aio
 {
 public:
-  aio_uring(tpool::thread_pool *tpool, int max_aio) : tpool_(tpool)
+  aio_uring(tpool::thread_pool *tpool, int max_aio, int flags) : tpool_(tpool)
   {
-    if (io_uring_queue_init(max_aio, &uring_, 0) != 0)
+    bool sqpoll= flags & tpool::AIO_SQPOLL;
+    if (sqpoll)
+    {
+      io_uring_params params{};
+      params.flags= IORING_SETUP_SQPOLL;
+      params.sq_thread_idle= 1000;
+      if (int ret= io_uring_queue_init_params(max_aio, &uring_, &params))
+      {
+        my_printf_error(ER_UNKNOWN_ERROR,
+                        "io_uring_queue_init_params() with"
+                        " IORING_SETUP_SQPOLL failed with errno %d"
+                        " (continuing without it)",
+                        ME_ERROR_LOG | ME_WARNING, -ret);
+        sqpoll= false;
+      }
+    }
+    sqpoll_= sqpoll;
+    if (!sqpoll && io_uring_queue_init(max_aio, &uring_, 0) != 0)
     {
       switch (const auto e= errno) {
       case ENOMEM:
@@ -73,6 +91,13 @@ class aio_uring final : public tpool::aio
                       ME_ERROR_LOG | ME_WARNING, errno);
     }
 
+    /* Reserve a sparse table of fixed files, indexed by the file
+    descriptor. bind() will fill it in. If the kernel does not support
+    sparse registration, we will simply use the file descriptors. */
+    files_.assign(N_FIXED_FILES, -1);
+    if (io_uring_register_files(&uring_, files_.data(), N_FIXED_FILES))
+      files_.clear();
+
     thread_= std::thread(thread_routine, this);
   }
 
@@ -84,7 +109,7 @@ class aio_uring final : public tpool::aio
       io_uring_prep_nop(sqe);
       io_uring_sqe_set_data(sqe, nullptr);
       auto ret= io_uring_submit(&uring_);
-      if (ret != 1)
+      if (ret < 1)
       {
         my_printf_error(ER_UNKNOWN_ERROR,
                         "io_uring_submit() returned %d during shutdown:"
@@ -99,46 +124,218 @@ class aio_uring final : public tpool::aio
 
   int submit_io(tpool::aiocb *cb) final
   {
-    cb->iov_base= cb->m_buffer;
-    cb->iov_len= cb->m_len;
-
     // The whole operation since io_uring_get_sqe() and till io_uring_submit()
     // must be atomical. This is because liburing provides thread-unsafe calls.
     std::lock_guard<std::mutex> _(mutex_);
+    if (!prepare(cb))
+      return -1;
+    submit();
+    return 0;
+  }
+
+  int queue_io(tpool::aiocb *cb) final
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!prepare(cb))
+      return -1;
+    if (io_uring_sq_ready(&uring_) >= MAX_QUEUED)
+      submit();
+    return 0;
+  }
+
+  int submit_queued() final
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    resubmit_= false;
+    if (io_uring_sq_ready(&uring_))
+      submit();
+    return 0;
+  }
+
+  int register_buffers(const tpool::aio_buffer *buf, size_t n) final
+  {
+    /* The kernel limits the size of each registered buffer. */
+    constexpr size_t max_size= size_t{1} << 30;
+    std::vector<iovec> buffers;
+    for (size_t i= 0; i < n; i++)
+      for (size_t offset= 0; offset < buf[i].m_size; offset+= max_size)
+        buffers.push_back({static_cast<char*>(buf[i].m_base) + offset,
+                           std::min(max_size, buf[i].m_size - offset)});
+    std::sort(buffers.begin(), buffers.end(),
+              [](const iovec &a, const iovec &b)
+              { return a.iov_base < b.iov_base; });
+
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!buffers_.empty())
+    {
+      io_uring_unregister_buffers(&uring_);
+      buffers_.clear();
+    }
+    if (buffers.empty())
+      return 0;
+    if (int ret= io_uring_register_buffers(&uring_, buffers.data(),
+                                           unsigned(buffers.size())))
+      return ret;
+    buffers_= std::move(buffers);
+    return 0;
+  }
+
+  void unregister_buffers() final
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!buffers_.empty())
+    {
+      io_uring_unregister_buffers(&uring_);
+      buffers_.clear();
+    }
+  }
+
+  int bind(native_file_handle &fd) final
+  {
+    if (size_t(fd) >= files_.size())
+      return 0;
+    /* Do not block submissions while the kernel updates the table */
+    std::lock_guard<std::mutex> f(files_mutex_);
+    int ret= io_uring_register_files_update(&uring_, unsigned(fd), &fd, 1);
+    if (ret != 1)
+      return ret;
+    std::lock_guard<std::mutex> _(mutex_);
+    files_[fd]= fd;
+    return 0;
+  }
+
+  int unbind(const native_file_handle &fd) final
+  {
+    if (size_t(fd) >= files_.size())
+      return 0;
+    std::lock_guard<std::mutex> f(files_mutex_);
+    {
+      std::lock_guard<std::mutex> _(mutex_);
+      if (files_[fd] != fd)
+        return 0;
+      files_[fd]= -1;
+    }
+    int none= -1;
+    int ret= io_uring_register_files_update(&uring_, unsigned(fd), &none, 1);
+    return ret == 1 ? 0 : ret;
+  }
+
+private:
+  /** Fill in a submission queue entry for a request.
+  Must be invoked while holding mutex_.
+  @return whether a submission queue entry was available */
+  bool prepare(tpool::aiocb *cb)
+  {
+    cb->iov_base= cb->m_buffer;
+    cb->iov_len= cb->m_len;
 
     io_uring_sqe *sqe= io_uring_get_sqe(&uring_);
-    if (cb->m_opcode == tpool::aio_opcode::AIO_PREAD)
-      io_uring_prep_readv(sqe, cb->m_fh, static_cast<struct iovec *>(cb), 1,
+    if (!sqe)
+    {
+      /* The queue is full of requests that were queued by queue_io() */
+      submit();
+      if (!(sqe= io_uring_get_sqe(&uring_)))
+        return false;
+    }
+
+    const int fd= cb->m_fh;
+    const bool read= cb->m_opcode == tpool::aio_opcode::AIO_PREAD;
+    if (const iovec *b= find_buffer(cb->m_buffer, cb->m_len))
+    {
+      const int index= int(b - buffers_.data());
+      if (read)
+        io_uring_prep_read_fixed(sqe, fd, cb->m_buffer, cb->m_len,
+                                 cb->m_offset, index);
+      else
+        io_uring_prep_write_fixed(sqe, fd, cb->m_buffer, cb->m_len,
+                                  cb->m_offset, index);
+    }
+    else if (read)
+      io_uring_prep_readv(sqe, fd, static_cast<struct iovec *>(cb), 1,
                           cb->m_offset);
     else
-      io_uring_prep_writev(sqe, cb->m_fh, static_cast<struct iovec *>(cb), 1,
+      io_uring_prep_writev(sqe, fd, static_cast<struct iovec *>(cb), 1,
                            cb->m_offset);
+
+    /* The index of a fixed file is the file descriptor */
+    if (size_t(fd) < files_.size() && files_[fd] == fd)
+      io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
     io_uring_sqe_set_data(sqe, cb);
+    return true;
+  }
 
-    return io_uring_submit(&uring_) == 1 ? 0 : -1;
+  /** Submit all prepared submission queue entries.
+  Must be invoked while holding mutex_.
+  If the kernel keeps refusing them for lack of resources, they stay
+  queued, and thread_routine() will submit them after reaping
+  completions. Any other error is fatal. */
+  void submit()
+  {
+    for (unsigned retries= 0;; retries++)
+    {
+      int ret= io_uring_submit(&uring_);
+      /* With SQPOLL, the kernel thread consumes the entries later. */
+      if (ret >= 0 && (!io_uring_sq_ready(&uring_) || sqpoll_))
+        return;
+      if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY)
+      {
+        my_printf_error(ER_UNKNOWN_ERROR,
+                        "io_uring_submit() returned %d\n",
+                        ME_ERROR_LOG | ME_FATAL, ret);
+        abort();
+      }
+      if (retries == MAX_SUBMIT_RETRIES)
+      {
+        resubmit_= true;
+        return;
+      }
+      /* Let thread_routine() reap completions */
+      std::this_thread::yield();
+    }
   }
 
-  int bind(native_file_handle &fd) final
+  /** Store the result of a request.
+  @param iocb  request
+  @param res   number of bytes transferred, or negative errno */
+  static void set_result(tpool::aiocb *iocb, int res)
   {
-    std::lock_guard<std::mutex> _(files_mutex_);
-    auto it= std::lower_bound(files_.begin(), files_.end(), fd);
-    assert(it == files_.end() || *it != fd);
-    files_.insert(it, fd);
-    return io_uring_register_files_update(&uring_, 0, files_.data(),
-                                          files_.size());
+    if (res < 0)
+    {
+      iocb->m_err= -res;
+      iocb->m_ret_len= 0;
+    }
+    else
+    {
+      iocb->m_err= 0;
+      iocb->m_ret_len= res;
+    }
   }
 
-  int unbind(const native_file_handle &fd) final
+  /** Execute the callback of a completed request */
+  void complete(tpool::aiocb *iocb)
   {
-    std::lock_guard<std::mutex> _(files_mutex_);
-    auto it= std::lower_bound(files_.begin(), files_.end(), fd);
-    assert(*it == fd);
-    files_.erase(it);
-    return io_uring_register_files_update(&uring_, 0, files_.data(),
-                                          files_.size());
+    iocb->m_internal_task.m_func= iocb->m_callback;
+    iocb->m_internal_task.m_arg= iocb;
+    iocb->m_internal_task.m_group= iocb->m_group;
+    tpool_->submit_task(&iocb->m_internal_task);
+  }
+
+  /** @return the registered buffer that contains [buf,buf+len)
+  @retval nullptr if none */
+  const iovec *find_buffer(const void *buf, size_t len) const
+  {
+    auto it= std::upper_bound(buffers_.begin(), buffers_.end(), buf,
+                              [](const void *b, const iovec &v)
+                              { return b < v.iov_base; });
+    if (it == buffers_.begin())
+      return nullptr;
+    --it;
+    const char *start= static_cast<const char*>(it->iov_base);
+    if (static_cast<const char*>(buf) + len > start + it->iov_len)
+      return nullptr;
+    return &*it;
   }
 
-private:
   static void thread_routine(aio_uring *aio)
   {
     my_thread_set_name("io_uring_wait");
@@ -160,39 +357,48 @@ class aio_uring final : public tpool::aio
         break; // ~aio_uring() told us to terminate
 
       int res= cqe->res;
-      if (res < 0)
-      {
-        iocb->m_err= -res;
-        iocb->m_ret_len= 0;
-      }
-      else
-      {
-        iocb->m_err= 0;
-        iocb->m_ret_len= res;
-      }
+      set_result(iocb, res);
 
       io_uring_cqe_seen(&aio->uring_, cqe);
       finish_synchronous(iocb);
 
+      // Submit the requests that the kernel refused earlier
+      if (aio->resubmit_)
+        aio->submit_queued();
+
       // If we need to resubmit the IO operation, but the ring is full,
       // we will follow the same path as for any other error codes.
       if (res == -EAGAIN && !aio->submit_io(iocb))
         continue;
 
-      iocb->m_internal_task.m_func= iocb->m_callback;
-      iocb->m_internal_task.m_arg= iocb;
-      iocb->m_internal_task.m_group= iocb->m_group;
-      aio->tpool_->submit_task(&iocb->m_internal_task);
+      aio->complete(iocb);
     }
   }
 
+  /** Number of queue_io() requests after which they will be submitted */
+  static constexpr unsigned MAX_QUEUED= 32;
+  /** Number of times to retry a refused io_uring_submit() */
+  static constexpr unsigned MAX_SUBMIT_RETRIES= 100;
+  /** Number of file descriptors that can be registered as fixed files */
+  static constexpr unsigned N_FIXED_FILES= 4096;
+
   io_uring uring_;
+  /** protects uring_ submission, buffers_ and files_ */
   std::mutex mutex_;
+  /** serializes bind() and unbind(); acquired before mutex_ */
+  std::mutex files_mutex_;
   tpool::thread_pool *tpool_;
   std::thread thread_;
+  /** whether the ring was created with IORING_SETUP_SQPOLL */
+  bool sqpoll_;
+  /** whether submit() left requests queued after the kernel refused
+  them; protected by mutex_, but read by thread_routine() without it */
+  std::atomic<bool> resubmit_{false};
 
+  /** registered buffers, ordered by iov_base */
+  std::vector<iovec> buffers_;
+  /** registered fixed files: files_[fd] == fd, or -1 */
   std::vector<native_file_handle> files_;
-  std::mutex files_mutex_;
 };
 
 } // namespace
@@ -200,10 +406,10 @@ class aio_uring final : public tpool::aio
 namespace tpool
 {
 
-aio *create_linux_aio(thread_pool *pool, int max_aio)
+aio *create_linux_aio(thread_pool *pool, int max_aio, int flags)
 {
   try {
-    return new aio_uring(pool, max_aio);
+    return new aio_uring(pool, max_aio, flags);
   } catch (std::runtime_error& error) {
     return nullptr;
   }
@@ -180,7 +180,7 @@ class aio_linux final : public aio
 
 std::atomic<bool> aio_linux::shutdown_in_progress;
 
-aio *create_linux_aio(thread_pool *pool, int max_io)
+aio *create_linux_aio(thread_pool *pool, int max_io, int)
 {
   io_context_t ctx;
   memset(&ctx, 0, sizeof ctx);
@@ -17,7 +17,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
 #include <memory> /* unique_ptr */
 #include <condition_variable>
 #include <mutex>
+#include <shared_mutex>
 #include <atomic>
+#include <vector>
+#include <cerrno>
 #include <tpool_structs.h>
 #ifdef LINUX_NATIVE_AIO
 #include <libaio.h>
@@ -173,6 +176,20 @@ struct aiocb
 };
 
 
+/** Flags for thread_pool::configure_aio() */
+enum aio_flags
+{
+  /** Let a kernel thread poll for submitted requests (io_uring only) */
+  AIO_SQPOLL= 1
+};
+
+/** A memory range for aio::register_buffers() */
+struct aio_buffer
+{
+  void *m_base;
+  size_t m_size;
+};
+
 /**
  AIO interface
 */
@@ -184,9 +201,26 @@ class aio
     On completion, cb->m_callback is executed.
   */
   virtual int submit_io(aiocb *cb)= 0;
-  /** "Bind" file to AIO handler (used on Windows only) */
+  /**
+    Queue asynchronous IO, possibly deferring the submission until
+    submit_queued() or a later submit_io() call.
+    On completion, cb->m_callback is executed.
+  */
+  virtual int queue_io(aiocb *cb) { return submit_io(cb); }
+  /** Submit all IO that was queued by queue_io() */
+  virtual int submit_queued() { return 0; }
+  /**
+    Register memory that IO buffers will be allocated from, so that it
+    does not have to be mapped for each request (io_uring only).
+    Replaces any previously registered buffers.
+    @return 0 on success, negative errno on failure
+  */
+  virtual int register_buffers(const aio_buffer *, size_t) { return -ENOSYS; }
+  /** Unregister the memory that was passed to register_buffers() */
+  virtual void unregister_buffers() {}
+  /** "Bind" file to AIO handler (used on Windows and with io_uring) */
   virtual int bind(native_file_handle &fd)= 0;
-  /** "Unind" file to AIO handler (used on Windows only) */
+  /** "Unbind" file from AIO handler (used on Windows and with io_uring) */
   virtual int unbind(const native_file_handle &fd)= 0;
   virtual ~aio(){};
 protected:
@@ -222,6 +256,14 @@ class thread_pool
 protected:
   /* AIO handler */
   std::unique_ptr<aio> m_aio;
+  /** aio_flags for create_native_aio() */
+  int m_aio_flags= 0;
+  /** buffers that were passed to register_io_buffers() */
+  std::vector<aio_buffer> m_aio_buffers;
+  /** protects the replacement of m_aio (exclusive) against concurrent
+  bind(), unbind() and submit_queued_io() (shared), which may be invoked
+  while no asynchronous IO is pending */
+  std::shared_mutex m_aio_mutex;
   virtual aio *create_native_aio(int max_io)= 0;
 
 public:
@@ -245,8 +287,9 @@ class thread_pool
     m_worker_init_callback= init;
     m_worker_destroy_callback= destroy;
   }
-  int configure_aio(bool use_native_aio, int max_io)
+  int configure_aio(bool use_native_aio, int max_io, int flags= 0)
   {
+    m_aio_flags= flags;
     if (use_native_aio)
       m_aio.reset(create_native_aio(max_io));
     else
@@ -262,6 +305,11 @@ class thread_pool
       auto new_aio = create_native_aio(max_io);
       if (!new_aio)
         return -1;
+      if (!m_aio_buffers.empty())
+        new_aio->register_buffers(m_aio_buffers.data(), m_aio_buffers.size());
+      /* With io_uring, files that were bound to the old m_aio will be
+      accessed by their plain descriptor until they are reopened. */
+      std::unique_lock<std::shared_mutex> _(m_aio_mutex);
       m_aio.reset(new_aio);
     }
     return 0;
@@ -269,6 +317,7 @@ class thread_pool
 
   void disable_aio()
   {
+    std::unique_lock<std::shared_mutex> _(m_aio_mutex);
     m_aio.reset();
   }
 
@@ -289,9 +338,36 @@ class thread_pool
   */
   virtual void set_concurrency(unsigned int threads=0){}
 
-  int bind(native_file_handle &fd) { return m_aio->bind(fd); }
-  void unbind(const native_file_handle &fd) { if (m_aio) m_aio->unbind(fd); }
+  int bind(native_file_handle &fd)
+  {
+    std::shared_lock<std::shared_mutex> _(m_aio_mutex);
+    return m_aio ? m_aio->bind(fd) : 0;
+  }
+  void unbind(const native_file_handle &fd)
+  {
+    std::shared_lock<std::shared_mutex> _(m_aio_mutex);
+    if (m_aio)
+      m_aio->unbind(fd);
+  }
   int submit_io(aiocb *cb) { return m_aio->submit_io(cb); }
+  int queue_io(aiocb *cb) { return m_aio->queue_io(cb); }
+  int submit_queued_io()
+  {
+    std::shared_lock<std::shared_mutex> _(m_aio_mutex);
+    return m_aio ? m_aio->submit_queued() : 0;
+  }
+  /** Register memory for IO buffers; see aio::register_buffers() */
+  int register_io_buffers(const aio_buffer *buf, size_t n)
+  {
+    m_aio_buffers.assign(buf, buf + n);
+    return m_aio ? m_aio->register_buffers(buf, n) : -ENOSYS;
+  }
+  void unregister_io_buffers()
+  {
+    m_aio_buffers.clear();
+    if (m_aio)
+      m_aio->unregister_buffers();
+  }
   virtual void wait_begin() {};
   virtual void wait_end() {};
   virtual ~thread_pool() {}
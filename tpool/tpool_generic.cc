@@ -40,9 +40,9 @@ namespace tpool
 
 #ifdef __linux__
 #if defined(HAVE_URING) || defined(LINUX_NATIVE_AIO)
-  extern aio* create_linux_aio(thread_pool* tp, int max_io);
+  extern aio* create_linux_aio(thread_pool* tp, int max_io, int flags);
 #else
-  aio *create_linux_aio(thread_pool *, int) { return nullptr; };
+  aio *create_linux_aio(thread_pool *, int, int) { return nullptr; };
 #endif
 #endif
 #ifdef _WIN32
@@ -305,7 +305,7 @@ class thread_pool_generic : public thread_pool
 #ifdef _WIN32
     return create_win_aio(this, max_io);
 #elif defined(__linux__)
-    return create_linux_aio(this,max_io);
+    return create_linux_aio(this, max_io, m_aio_flags);
 #else
     return nullptr;
 #endif
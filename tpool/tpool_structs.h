@@ -154,6 +154,20 @@ template<typename T, bool timed=false> class cache
     return t;
   }
 
+  /**
+   Retrieve an item from cache without waiting.
+   @return borrowed item
+   @retval nullptr if the cache is empty or its mutex is held
+  */
+  T *try_get()
+  {
+    std::unique_lock<std::mutex> lock(m_mtx, std::try_to_lock);
+    if (!lock.owns_lock() || is_empty())
+      return nullptr;
+    assert(m_pos < capacity());
+    return m_cache[m_pos++];
+  }
+
   std::mutex &mutex() { return m_mtx; }
 
   /**
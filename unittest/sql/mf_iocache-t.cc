@@ -447,10 +447,54 @@ void mdev10963()
   my_delete(file_name, MYF(MY_WME));
 }
 
+void copy_file_to_cache()
+{
+  int res;
+  IO_CACHE to;
+  static uchar src[CACHE_SIZE * 4 + 100], dst[sizeof(src) + 20];
+  uchar head[100];
+  const char *file_name="copy.log";
+
+  for (size_t i= 0; i < sizeof(src); i++)
+    src[i]= (uchar) (i % 251);
+  diag("copy a cache file to a cache");
+
+  res= open_cached_file(&info, 0, 0, CACHE_SIZE, 0);
+  ok(res == 0, "open_cached_file" INFO_TAIL);
+  res= my_b_write(&info, src, sizeof(src));
+  ok(res == 0 && info.pos_in_file > 0, "cache is written" INFO_TAIL);
+  res= reinit_io_cache(&info, READ_CACHE, 0, 0, 0) ||
+    my_b_read(&info, head, sizeof(head));
+  ok(res == 0, "cache turned to read" INFO_TAIL);
+
+  File file= my_open(file_name, O_RDWR | O_TRUNC | O_CREAT, MYF(MY_WME));
+  ok(file >= 0, "opened file fd = %d", file);
+  res= init_io_cache(&to, file, CACHE_SIZE, WRITE_CACHE, 0, 0, MYF(MY_WME));
+  ok(res == 0, "init_io_cache");
+
+  /* part of the source is in the read buffer, the rest in the file */
+  res= my_b_write(&to, (uchar*) "0123456789", 10) ||
+    my_b_write(&to, head, sizeof(head)) ||
+    my_b_copy_file_to_cache(&info, &to, sizeof(src) - sizeof(head));
+  ok(res == 0 && my_b_tell(&to) == 10 + sizeof(src),
+     "cache copied, size %llu", my_b_tell(&to));
+  res= my_b_write(&to, (uchar*) "abcdefghij", 10) || end_io_cache(&to);
+  ok(res == 0, "write after the copy");
+
+  res= (int) my_pread(file, dst, sizeof(dst), 0, MYF(MY_NABP));
+  ok(res == 0 && !memcmp(dst, "0123456789", 10) &&
+     !memcmp(dst + 10, src, sizeof(src)) &&
+     !memcmp(dst + 10 + sizeof(src), "abcdefghij", 10), "file content");
+
+  my_close(file, MYF(MY_WME));
+  my_delete(file_name, MYF(MY_WME));
+  close_cached_file(&info);
+}
+
 int main(int argc __attribute__((unused)),char *argv[])
 {
   MY_INIT(argv[0]);
-  plan(277);
+  plan(285);
 
   /* temp files with and without encryption */
   encrypt_tmp_files= 1;
@@ -469,6 +513,7 @@ int main(int argc __attribute__((unused)),char *argv[])
   mdev14014();
   mdev17133();
   mdev10963();
+  copy_file_to_cache();
 
   my_end(0);
   return exit_status();
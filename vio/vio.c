@@ -158,6 +158,9 @@ static void vio_init(Vio *vio, enum enum_vio_type type,
   vio->vioerrno         =vio_errno;
   vio->read=            (flags & VIO_BUFFERED_READ) ? vio_read_buff : vio_read;
   vio->write            =vio_write;
+#ifndef _WIN32
+  vio->writev           =vio_writev;
+#endif
   vio->fastsend         =vio_fastsend;
   vio->viokeepalive     =vio_keepalive;
   vio->should_retry     =vio_should_retry;
@@ -286,6 +286,51 @@ size_t vio_write(Vio *vio, const uchar* buf, size_t size)
   DBUG_RETURN(ret);
 }
 
+#ifndef _WIN32
+/*
+  Like vio_write(), for the buffers of an I/O vector.
+  Returns the number of bytes written, which may be less than the total
+  length of the buffers, or -1 in case of an error.
+*/
+size_t vio_writev(Vio *vio, const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+  int flags= 0;
+  struct msghdr msg;
+  DBUG_ENTER("vio_writev");
+  DBUG_PRINT("enter", ("sd: %d  iovcnt: %d",
+                       (int)mysql_socket_getfd(vio->mysql_socket), iovcnt));
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov= (struct iovec*) iov;
+  msg.msg_iovlen= iovcnt;
+
+  /* If timeout is enabled, do not block. */
+  if (vio->write_timeout >= 0)
+    flags= VIO_DONTWAIT;
+
+  while ((ret= mysql_socket_sendmsg(vio->mysql_socket, &msg, flags)) == -1)
+  {
+    int error= socket_errno;
+    /* The operation would block? */
+    if (error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK)
+      break;
+
+    /* Wait for the output buffer to become writable.*/
+    if ((ret= vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE)))
+      break;
+  }
+#ifndef DBUG_OFF
+  if (ret == -1)
+  {
+    DBUG_PRINT("vio_error", ("Got error on writev: %d",socket_errno));
+  }
+#endif /* DBUG_OFF */
+  DBUG_PRINT("exit", ("%d", (int) ret));
+  DBUG_RETURN(ret);
+}
+#endif /* !_WIN32 */
+
 int vio_socket_shutdown(Vio *vio, int how)
 {
   int ret;